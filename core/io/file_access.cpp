@@ -43,6 +43,7 @@ FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = {};
 FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = nullptr;
 
 bool FileAccess::backup_save = false;
+bool FileAccess::memory_mapping = true;
 thread_local Error FileAccess::last_file_open_error = OK;
 
 Ref<FileAccess> FileAccess::create(AccessType p_access) {
@@ -499,6 +500,15 @@ Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	return data;
 }
 
+const uint8_t *FileAccess::get_mapped_buffer(uint64_t p_length) {
+	const uint64_t position = get_position();
+	const uint8_t *span = get_mapped_span(position, p_length);
+	if (span) {
+		seek(position + p_length);
+	}
+	return span;
+}
+
 String FileAccess::get_as_utf8_string(bool p_skip_cr) const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
@@ -111,6 +111,7 @@ protected:
 
 private:
 	static bool backup_save;
+	static bool memory_mapping;
 	thread_local static Error last_file_open_error;
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
@@ -150,6 +151,15 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+
+	/**
+	 * Returns a read-only view of p_length bytes at p_offset, without copying,
+	 * or nullptr if this file can't be memory mapped (in which case the caller
+	 * should fall back to get_buffer()). The view stays valid until the file is
+	 * closed, and doesn't change the current position.
+	 */
+	virtual const uint8_t *get_mapped_span(uint64_t p_offset, uint64_t p_length) const { return nullptr; }
+	const uint8_t *get_mapped_buffer(uint64_t p_length); ///< get_mapped_span() at the current position, seeking past it on success
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -218,6 +228,9 @@ public:
 	static void set_backup_save(bool p_enable) { backup_save = p_enable; };
 	static bool is_backup_save_enabled() { return backup_save; };
 
+	static void set_memory_mapping_enabled(bool p_enable) { memory_mapping = p_enable; }
+	static bool is_memory_mapping_enabled() { return memory_mapping; }
+
 	static String get_md5(const String &p_file);
 	static String get_sha256(const String &p_file);
 	static String get_multiple_md5(const Vector<String> &p_file);
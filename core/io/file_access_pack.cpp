@@ -348,6 +348,16 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_mapped_span(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), nullptr, "File must be opened before use.");
+
+	if (p_offset > pf.size || p_length > pf.size - p_offset) {
+		return nullptr;
+	}
+	// Encrypted files are read through FileAccessEncrypted, which can't be mapped.
+	return f->get_mapped_span(off + p_offset, p_length);
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
@@ -157,14 +157,19 @@ StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
 		String s;
+		const uint8_t *mapped = f->get_mapped_buffer(len);
+		if (mapped) {
+			s.parse_utf8((const char *)mapped, len);
+			return s;
+		}
+		if ((int)len > str_buf.size()) {
+			str_buf.resize(len);
+		}
+		f->get_buffer((uint8_t *)&str_buf[0], len);
 		s.parse_utf8(&str_buf[0]);
 		return s;
 	}
@@ -811,6 +816,17 @@ Error ResourceLoaderBinary::load() {
 			internal_index_cache[path] = res;
 		}
 
+		if (!main && _should_defer(i, t)) {
+			// Referencing the resource works already, its properties are set later.
+			DeferredResource deferred;
+			deferred.resource = res;
+			deferred.missing_resource = missing_resource;
+			deferred.offset = f->get_position();
+			deferred_resources.push_back(deferred);
+			resource_cache.push_back(res);
+			continue;
+		}
+
 		int pc = f->get_32();
 
 		//set properties
@@ -832,64 +848,129 @@ Error ResourceLoaderBinary::load() {
 				return error;
 			}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+			_set_property(res, missing_resource, name, value, missing_resource_properties);
+		}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+		_finish_properties(res, missing_resource, missing_resource_properties);
+
+		if (progress) {
+			*progress = (i + 1) / float(internal_resources.size());
+		}
+
+		resource_cache.push_back(res);
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+		if (main) {
+			if (deferred_resources.is_empty()) {
+				f.unref();
+			} else {
+				// Deferred resources are decoded on another thread, so dependencies
+				// must be complete before this load is reported as done.
+				for (const ExtResource &E : external_resources) {
+					if (E.load_token.is_valid()) {
+						ResourceLoader::_load_complete(*E.load_token.ptr(), nullptr);
 					}
 				}
+				progress = nullptr;
 			}
-
-			if (set_valid) {
-				res->set(name, value);
-			}
+			resource = res;
+			resource->set_as_translation_remapped(translation_remapped);
+			error = OK;
+			return OK;
 		}
+	}
+
+	return ERR_FILE_EOF;
+}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+void ResourceLoaderBinary::_set_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties) {
+	if (p_value.get_type() == Variant::OBJECT && p_missing_resource != nullptr) {
+		// If the property being set is a missing resource (and the parent is not),
+		// then setting it will most likely not work.
+		// Instead, save it as metadata.
+
+		Ref<MissingResource> mr = p_value;
+		if (mr.is_valid()) {
+			r_missing_resource_properties[p_name] = mr;
+			return;
 		}
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array set_array = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+			Array get_array = get_value;
+			if (!set_array.is_same_typed(get_array)) {
+				p_value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+			}
 		}
+	}
+
+	p_res->set(p_name, p_value);
+}
+
+void ResourceLoaderBinary::_finish_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties) {
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
+
+	if (!p_missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, p_missing_resource_properties);
+	}
 
 #ifdef TOOLS_ENABLED
-		res->set_edited(false);
+	p_res->set_edited(false);
 #endif
+}
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+bool ResourceLoaderBinary::_should_defer(int p_index, const String &p_type) {
+	if (stream_threshold == 0) {
+		return false;
+	}
+	// Only types whose users follow the `changed` signal, since they are
+	// empty when the load returns.
+	if (!ClassDB::is_parent_class(p_type, "ArrayMesh") && !ClassDB::is_parent_class(p_type, "Animation")) {
+		return false;
+	}
+
+	if (sorted_offsets.is_empty()) {
+		sorted_offsets.resize(internal_resources.size());
+		for (int i = 0; i < internal_resources.size(); i++) {
+			sorted_offsets.write[i] = internal_resources[i].offset;
 		}
+		sorted_offsets.sort();
+	}
 
-		resource_cache.push_back(res);
+	// A resource ends where the next one in the file starts.
+	const uint64_t offset = internal_resources[p_index].offset;
+	int next = sorted_offsets.bsearch(offset, true);
+	while (next < sorted_offsets.size() && sorted_offsets[next] <= offset) {
+		next++;
+	}
+	const uint64_t end = next < sorted_offsets.size() ? sorted_offsets[next] : f->get_length();
+	return end - offset >= stream_threshold;
+}
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
-			return OK;
+Error ResourceLoaderBinary::_decode_deferred(DeferredResource &p_deferred) {
+	f->seek(p_deferred.offset);
+	int pc = f->get_32();
+	p_deferred.properties.resize(pc);
+	for (int j = 0; j < pc; j++) {
+		Pair<StringName, Variant> &property = p_deferred.properties.write[j];
+		property.first = _get_string();
+		if (property.first == StringName()) {
+			p_deferred.properties.clear();
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+		Error err = parse_variant(property.second);
+		if (err) {
+			p_deferred.properties.clear();
+			return err;
 		}
 	}
-
-	return ERR_FILE_EOF;
+	p_deferred.decoded = true;
+	return OK;
 }
 
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
@@ -904,6 +985,12 @@ static void save_ustring(Ref<FileAccess> f, const String &p_string) {
 
 static String get_ustring(Ref<FileAccess> f) {
 	int len = f->get_32();
+	const uint8_t *mapped = f->get_mapped_buffer(len);
+	if (mapped) {
+		String s;
+		s.parse_utf8((const char *)mapped, len);
+		return s;
+	}
 	Vector<char> str_buf;
 	str_buf.resize(len);
 	f->get_buffer((uint8_t *)&str_buf[0], len);
@@ -914,14 +1001,19 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
+	if (len <= 0) {
+		return String();
+	}
+	String s;
+	const uint8_t *mapped = f->get_mapped_buffer(len);
+	if (mapped) {
+		s.parse_utf8((const char *)mapped, len);
+		return s;
+	}
 	if (len > str_buf.size()) {
 		str_buf.resize(len);
 	}
-	if (len == 0) {
-		return String();
-	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
 	s.parse_utf8(&str_buf[0]);
 	return s;
 }
@@ -1213,7 +1305,14 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + p_path + "'.");
 
-	ResourceLoaderBinary loader;
+	// In streaming mode the loader outlives this call, until every deferred
+	// resource has its properties.
+	Ref<ResourceLoaderBinaryStream> stream;
+	ResourceLoaderBinary local_loader;
+	if (stream_threshold > 0) {
+		stream.instantiate();
+	}
+	ResourceLoaderBinary &loader = stream.is_valid() ? stream->loader : local_loader;
 	switch (p_cache_mode) {
 		case CACHE_MODE_IGNORE:
 		case CACHE_MODE_REUSE:
@@ -1232,6 +1331,7 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	}
 	loader.use_sub_threads = p_use_sub_threads;
 	loader.progress = r_progress;
+	loader.stream_threshold = stream_threshold;
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
 	loader.res_path = loader.local_path;
@@ -1246,9 +1346,170 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	if (err) {
 		return Ref<Resource>();
 	}
+
+	if (!stream.is_valid() || loader.deferred_resources.is_empty()) {
+		return loader.resource;
+	}
+
+	{
+		MutexLock lock(streamed_mutex);
+		for (uint32_t i = 0; i < loader.deferred_resources.size(); i++) {
+			StreamedResource &streamed = streamed_resources[loader.deferred_resources[i].resource->get_instance_id()];
+			streamed.stream = stream;
+			streamed.index = i;
+		}
+	}
+	stream->task_id = WorkerThreadPool::get_singleton()->add_template_task(stream.ptr(), &ResourceLoaderBinaryStream::_decode_task, nullptr, false, "Stream " + loader.local_path);
+
 	return loader.resource;
 }
 
+uint64_t ResourceFormatLoaderBinary::stream_threshold = 0;
+BinaryMutex ResourceFormatLoaderBinary::streamed_mutex;
+HashMap<ObjectID, ResourceFormatLoaderBinary::StreamedResource> ResourceFormatLoaderBinary::streamed_resources;
+
+void ResourceFormatLoaderBinary::set_stream_threshold(uint64_t p_bytes) {
+	stream_threshold = p_bytes;
+}
+
+uint64_t ResourceFormatLoaderBinary::get_stream_threshold() {
+	return stream_threshold;
+}
+
+bool ResourceFormatLoaderBinary::is_streaming(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND_V(p_resource.is_null(), false);
+	MutexLock lock(streamed_mutex);
+	return streamed_resources.has(p_resource->get_instance_id());
+}
+
+void ResourceFormatLoaderBinary::finish_streaming(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND(p_resource.is_null());
+	Ref<ResourceLoaderBinaryStream> stream;
+	uint32_t index = 0;
+	{
+		MutexLock lock(streamed_mutex);
+		const StreamedResource *streamed = streamed_resources.getptr(p_resource->get_instance_id());
+		if (!streamed) {
+			return;
+		}
+		stream = streamed->stream;
+		index = streamed->index;
+	}
+	stream->_materialize(index);
+}
+
+void ResourceFormatLoaderBinary::cancel_streaming() {
+	HashMap<ObjectID, StreamedResource> pending;
+	{
+		MutexLock lock(streamed_mutex);
+		pending = streamed_resources;
+		streamed_resources.clear();
+	}
+	for (const KeyValue<ObjectID, StreamedResource> &E : pending) {
+		MutexLock lock(E.value.stream->mutex);
+		E.value.stream->cancelled = true;
+	}
+	// Streams wait for their task when the last reference goes away.
+	pending.clear();
+}
+
+void ResourceLoaderBinaryStream::_decode_task(void *p_userdata) {
+	for (uint32_t i = 0; i < loader.deferred_resources.size(); i++) {
+		{
+			MutexLock lock(mutex);
+			if (cancelled) {
+				return;
+			}
+			ResourceLoaderBinary::DeferredResource &deferred = loader.deferred_resources[i];
+			if (deferred.decoded || deferred.failed || deferred.resource.is_null()) {
+				continue;
+			}
+			Error err = loader._decode_deferred(deferred);
+			if (err != OK) {
+				ERR_PRINT(vformat("Failed to decode streamed resource %d of '%s'.", i, loader.local_path));
+				deferred.failed = true;
+			}
+		}
+		// Signals aren't thread-safe, so properties are set (or failed resources dropped) on the main thread.
+		callable_mp(this, &ResourceLoaderBinaryStream::_apply_decoded).call_deferred();
+	}
+}
+
+void ResourceLoaderBinaryStream::_apply_decoded() {
+	Ref<ResourceLoaderBinaryStream> self = this; // _apply() may drop the last reference.
+	MutexLock lock(mutex);
+	for (uint32_t i = 0; i < loader.deferred_resources.size(); i++) {
+		const ResourceLoaderBinary::DeferredResource &deferred = loader.deferred_resources[i];
+		if (deferred.resource.is_null()) {
+			continue;
+		}
+		if (deferred.failed) {
+			_discard(i);
+		} else if (deferred.decoded) {
+			_apply(i);
+		}
+	}
+}
+
+void ResourceLoaderBinaryStream::_materialize(uint32_t p_index) {
+	Ref<ResourceLoaderBinaryStream> self = this;
+	MutexLock lock(mutex);
+	ResourceLoaderBinary::DeferredResource &deferred = loader.deferred_resources[p_index];
+	if (deferred.resource.is_null() || cancelled) {
+		return;
+	}
+	if (!deferred.decoded && !deferred.failed && loader._decode_deferred(deferred) != OK) {
+		ERR_PRINT(vformat("Failed to decode streamed resource %d of '%s'.", p_index, loader.local_path));
+		deferred.failed = true;
+	}
+	if (deferred.failed) {
+		_discard(p_index);
+		return;
+	}
+	_apply(p_index);
+}
+
+void ResourceLoaderBinaryStream::_apply(uint32_t p_index) {
+	ResourceLoaderBinary::DeferredResource &deferred = loader.deferred_resources[p_index];
+	const Ref<Resource> res = deferred.resource;
+	const ObjectID id = res->get_instance_id();
+
+	Dictionary missing_resource_properties;
+	for (int i = 0; i < deferred.properties.size(); i++) {
+		Pair<StringName, Variant> &property = deferred.properties.write[i];
+		loader._set_property(res, deferred.missing_resource, property.first, property.second, missing_resource_properties);
+	}
+	loader._finish_properties(res, deferred.missing_resource, missing_resource_properties);
+
+	deferred.resource.unref();
+	deferred.properties.clear();
+
+	MutexLock lock(ResourceFormatLoaderBinary::streamed_mutex);
+	ResourceFormatLoaderBinary::streamed_resources.erase(id);
+}
+
+void ResourceLoaderBinaryStream::_discard(uint32_t p_index) {
+	// The resource keeps the properties it was created with, but stops streaming.
+	// Dropping its entry releases the stream once no other resource needs it.
+	ResourceLoaderBinary::DeferredResource &deferred = loader.deferred_resources[p_index];
+	const ObjectID id = deferred.resource->get_instance_id();
+	deferred.resource.unref();
+	deferred.properties.clear();
+
+	MutexLock lock(ResourceFormatLoaderBinary::streamed_mutex);
+	ResourceFormatLoaderBinary::streamed_resources.erase(id);
+}
+
+ResourceLoaderBinaryStream::~ResourceLoaderBinaryStream() {
+	if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		{
+			MutexLock lock(mutex);
+			cancelled = true;
+		}
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+}
+
 void ResourceFormatLoaderBinary::get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const {
 	if (p_type.is_empty()) {
 		get_recognized_extensions(p_extensions);
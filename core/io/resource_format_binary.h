@@ -34,6 +34,10 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -88,11 +92,32 @@ class ResourceLoaderBinary {
 	ResourceFormatLoader::CacheMode cache_mode_for_external = ResourceFormatLoader::CACHE_MODE_REUSE;
 
 	friend class ResourceFormatLoaderBinary;
+	friend class ResourceLoaderBinaryStream;
 
 	Error parse_variant(Variant &r_v);
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
+	// Streaming mode: large subresources are created empty and their properties
+	// are decoded later, see ResourceLoaderBinaryStream.
+	struct DeferredResource {
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		uint64_t offset = 0; // Start of the property list.
+		bool decoded = false;
+		bool failed = false;
+		Vector<Pair<StringName, Variant>> properties;
+	};
+
+	uint64_t stream_threshold = 0;
+	Vector<uint64_t> sorted_offsets;
+	LocalVector<DeferredResource> deferred_resources;
+
+	bool _should_defer(int p_index, const String &p_type);
+	Error _decode_deferred(DeferredResource &p_deferred);
+	void _set_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties);
+	void _finish_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties);
+
 public:
 	Ref<Resource> get_resource();
 	Error load();
@@ -108,8 +133,51 @@ public:
 	ResourceLoaderBinary() {}
 };
 
+// Subresources of a file loaded in streaming mode that don't have their
+// properties yet. A worker thread decodes them in file order and the main
+// thread applies them, unless ResourceFormatLoaderBinary::finish_streaming()
+// needs one earlier.
+class ResourceLoaderBinaryStream : public RefCounted {
+	friend class ResourceFormatLoaderBinary;
+
+	ResourceLoaderBinary loader;
+	Mutex mutex;
+	WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	bool cancelled = false;
+
+	void _decode_task(void *p_userdata);
+	void _apply_decoded();
+	void _apply(uint32_t p_index);
+	void _discard(uint32_t p_index);
+	void _materialize(uint32_t p_index);
+
+public:
+	~ResourceLoaderBinaryStream();
+};
+
 class ResourceFormatLoaderBinary : public ResourceFormatLoader {
+	friend class ResourceLoaderBinaryStream;
+
+	struct StreamedResource {
+		Ref<ResourceLoaderBinaryStream> stream;
+		uint32_t index = 0;
+	};
+
+	static uint64_t stream_threshold;
+	static BinaryMutex streamed_mutex;
+	static HashMap<ObjectID, StreamedResource> streamed_resources;
+
 public:
+	// Subresources of streamable types (meshes and animations) larger than the
+	// threshold are returned empty and filled in later. 0 disables streaming.
+	static void set_stream_threshold(uint64_t p_bytes);
+	static uint64_t get_stream_threshold();
+	static bool is_streaming(const Ref<Resource> &p_resource);
+	// Decodes and applies the properties of a streamed resource right away.
+	static void finish_streaming(const Ref<Resource> &p_resource);
+	// Drops every pending resource, used on shutdown.
+	static void cancel_streaming();
+
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const override;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
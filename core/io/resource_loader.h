@@ -206,6 +206,20 @@ public:
 
 	static bool is_within_load() { return load_nesting > 0; };
 
+	struct BatchLoadInfo {
+		String path;
+		Vector<String> dependencies; // Dependencies that were part of the batch.
+		Error error = OK;
+		uint32_t depth = 0; // Wave the resource was loaded in, leaves are in wave 0.
+		uint64_t bytes = 0; // Size of the file that was read, after remapping.
+		uint64_t load_usec = 0; // Time spent loading this resource, its dependencies were already loaded.
+		uint64_t critical_path_usec = 0; // load_usec plus the slowest chain of dependencies below it.
+	};
+
+	// Loads several resources and their dependencies, leaves first, in parallel waves on the WorkerThreadPool.
+	// Resources shared between roots are loaded once. Must not be called from a WorkerThreadPool task.
+	static Error load_batch(const Vector<String> &p_paths, Vector<Ref<Resource>> &r_resources, Vector<BatchLoadInfo> *r_info = nullptr);
+
 	static Ref<Resource> load(const String &p_path, const String &p_type_hint = "", ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE, Error *r_error = nullptr);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
@@ -0,0 +1,936 @@
+/**************************************************************************/
+/*  simd_batch.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "simd_batch.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_BATCH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SIMD_BATCH_TARGET(m_target)
+#else
+#define SIMD_BATCH_TARGET(m_target) __attribute__((target(m_target)))
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SIMD_BATCH_NEON
+#include <arm_neon.h>
+#endif
+#endif // REAL_T_IS_DOUBLE
+
+// Every implementation must match the scalar operators bit for bit. In practice
+// this means evaluating `((a * x + b * y) + c * z) + d` per component in exactly
+// that order, without fused multiply-adds, and treating min/max as
+// `p < m ? p : m` / `p > m ? p : m` like the SSE instructions do.
+
+namespace {
+
+struct Kernels {
+	void (*xform_points)(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+	void (*xform_vectors)(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+	// p_a is advanced by p_a_step per transform, so a step of 0 multiplies every p_b by the same transform.
+	void (*multiply_transforms)(const Transform3D *p_a, uint32_t p_a_step, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count);
+	void (*lerp_rescale)(const float *p_from, const float *p_to, const float *p_weights, const float *p_scales, const float *p_offsets, float *r_dst, uint32_t p_count);
+	// Per-lane minimum and maximum of the first p_blocks * 4 points. Point i goes to lane i % 4.
+	void (*aabb_lanes)(const Vector3 *p_points, uint32_t p_blocks, real_t r_min[3][4], real_t r_max[3][4]);
+	void (*project_box)(const Transform3D &p_transform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count);
+	// Per-lane range of p_axis.dot(p_transform.xform(point)) over the first p_blocks * 4 points. Point i goes to lane i % 4.
+	void (*project_points_lanes)(const Transform3D &p_transform, const Vector3 &p_axis, const Vector3 *p_points, uint32_t p_blocks, real_t r_min[4], real_t r_max[4]);
+	// Per-lane largest p_direction.dot(point) over the first p_blocks * 4 points, and the first point reaching it.
+	void (*support_lanes)(const Vector3 &p_direction, const Vector3 *p_points, uint32_t p_blocks, real_t r_max[4], uint32_t r_index[4]);
+};
+
+_FORCE_INLINE_ real_t _lane_min(real_t p_value, real_t p_lane) {
+	return p_value < p_lane ? p_value : p_lane;
+}
+
+_FORCE_INLINE_ real_t _lane_max(real_t p_value, real_t p_lane) {
+	return p_value > p_lane ? p_value : p_lane;
+}
+
+/* Scalar */
+
+void _xform_points_scalar(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_transform.xform(p_src[i]);
+	}
+}
+
+void _xform_vectors_scalar(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_basis.xform(p_src[i]);
+	}
+}
+
+void _multiply_transforms_scalar(const Transform3D *p_a, uint32_t p_a_step, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i * p_a_step] * p_b[i];
+	}
+}
+
+void _lerp_rescale_scalar(const float *p_from, const float *p_to, const float *p_weights, const float *p_scales, const float *p_offsets, float *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_offsets[i] + Math::lerp(p_from[i], p_to[i], p_weights[i]) * p_scales[i];
+	}
+}
+
+void _aabb_lanes_scalar(const Vector3 *p_points, uint32_t p_blocks, real_t r_min[3][4], real_t r_max[3][4]) {
+	for (uint32_t i = 0; i < p_blocks * 4; i++) {
+		const uint32_t lane = i & 3;
+		for (int axis = 0; axis < 3; axis++) {
+			r_min[axis][lane] = _lane_min(p_points[i][axis], r_min[axis][lane]);
+			r_max[axis][lane] = _lane_max(p_points[i][axis], r_max[axis][lane]);
+		}
+	}
+}
+
+void _project_box_scalar(const Transform3D &p_transform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		const real_t length = p_transform.basis.xform_inv(p_axes[i]).abs().dot(p_half_extents);
+		const real_t distance = p_axes[i].dot(p_transform.origin);
+		r_min[i] = distance - length;
+		r_max[i] = distance + length;
+	}
+}
+
+void _project_points_lanes_scalar(const Transform3D &p_transform, const Vector3 &p_axis, const Vector3 *p_points, uint32_t p_blocks, real_t r_min[4], real_t r_max[4]) {
+	for (uint32_t i = 0; i < p_blocks * 4; i++) {
+		const real_t d = p_axis.dot(p_transform.xform(p_points[i]));
+		r_min[i & 3] = _lane_min(d, r_min[i & 3]);
+		r_max[i & 3] = _lane_max(d, r_max[i & 3]);
+	}
+}
+
+void _support_lanes_scalar(const Vector3 &p_direction, const Vector3 *p_points, uint32_t p_blocks, real_t r_max[4], uint32_t r_index[4]) {
+	for (uint32_t i = 0; i < p_blocks * 4; i++) {
+		const real_t d = p_direction.dot(p_points[i]);
+		if (d > r_max[i & 3]) {
+			r_max[i & 3] = d;
+			r_index[i & 3] = i;
+		}
+	}
+}
+
+const Kernels kernels_scalar = {
+	_xform_points_scalar,
+	_xform_vectors_scalar,
+	_multiply_transforms_scalar,
+	_lerp_rescale_scalar,
+	_aabb_lanes_scalar,
+	_project_box_scalar,
+	_project_points_lanes_scalar,
+	_support_lanes_scalar,
+};
+
+#ifdef SIMD_BATCH_X86
+
+/* SSE4.1 */
+
+// Four packed Vector3 (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) to and from one register per axis.
+SIMD_BATCH_TARGET("sse4.1")
+_FORCE_INLINE_ void _load_soa_sse4(const float *p_src, __m128 &r_x, __m128 &r_y, __m128 &r_z) {
+	const __m128 a = _mm_loadu_ps(p_src);
+	const __m128 b = _mm_loadu_ps(p_src + 4);
+	const __m128 c = _mm_loadu_ps(p_src + 8);
+	const __m128 x = _mm_blend_ps(_mm_blend_ps(a, b, 0b0100), c, 0b0010); // x0 x3 x2 x1
+	const __m128 y = _mm_blend_ps(_mm_blend_ps(a, b, 0b1001), c, 0b0100); // y1 y0 y3 y2
+	const __m128 z = _mm_blend_ps(_mm_blend_ps(a, b, 0b0010), c, 0b1001); // z2 z1 z0 z3
+	r_x = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 2, 3, 0));
+	r_y = _mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 3, 0, 1));
+	r_z = _mm_shuffle_ps(z, z, _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+_FORCE_INLINE_ void _store_soa_sse4(float *r_dst, __m128 p_x, __m128 p_y, __m128 p_z) {
+	const __m128 x = _mm_shuffle_ps(p_x, p_x, _MM_SHUFFLE(1, 2, 3, 0));
+	const __m128 y = _mm_shuffle_ps(p_y, p_y, _MM_SHUFFLE(2, 3, 0, 1));
+	const __m128 z = _mm_shuffle_ps(p_z, p_z, _MM_SHUFFLE(3, 0, 1, 2));
+	_mm_storeu_ps(r_dst, _mm_blend_ps(_mm_blend_ps(x, y, 0b0010), z, 0b0100));
+	_mm_storeu_ps(r_dst + 4, _mm_blend_ps(_mm_blend_ps(y, z, 0b0010), x, 0b0100));
+	_mm_storeu_ps(r_dst + 8, _mm_blend_ps(_mm_blend_ps(z, x, 0b0010), y, 0b0100));
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+_FORCE_INLINE_ __m128 _dot_sse4(__m128 p_a, __m128 p_x, __m128 p_b, __m128 p_y, __m128 p_c, __m128 p_z) {
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p_a, p_x), _mm_mul_ps(p_b, p_y)), _mm_mul_ps(p_c, p_z));
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+void _xform_points_sse4(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_transform.basis;
+	const __m128 m00 = _mm_set1_ps(b.rows[0][0]), m01 = _mm_set1_ps(b.rows[0][1]), m02 = _mm_set1_ps(b.rows[0][2]);
+	const __m128 m10 = _mm_set1_ps(b.rows[1][0]), m11 = _mm_set1_ps(b.rows[1][1]), m12 = _mm_set1_ps(b.rows[1][2]);
+	const __m128 m20 = _mm_set1_ps(b.rows[2][0]), m21 = _mm_set1_ps(b.rows[2][1]), m22 = _mm_set1_ps(b.rows[2][2]);
+	const __m128 ox = _mm_set1_ps(p_transform.origin.x), oy = _mm_set1_ps(p_transform.origin.y), oz = _mm_set1_ps(p_transform.origin.z);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 x, y, z;
+		_load_soa_sse4(&p_src[i].x, x, y, z);
+		const __m128 rx = _mm_add_ps(_dot_sse4(m00, x, m01, y, m02, z), ox);
+		const __m128 ry = _mm_add_ps(_dot_sse4(m10, x, m11, y, m12, z), oy);
+		const __m128 rz = _mm_add_ps(_dot_sse4(m20, x, m21, y, m22, z), oz);
+		_store_soa_sse4(&r_dst[i].x, rx, ry, rz);
+	}
+	_xform_points_scalar(p_transform, p_src + i, r_dst + i, p_count - i);
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+void _xform_vectors_sse4(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_basis;
+	const __m128 m00 = _mm_set1_ps(b.rows[0][0]), m01 = _mm_set1_ps(b.rows[0][1]), m02 = _mm_set1_ps(b.rows[0][2]);
+	const __m128 m10 = _mm_set1_ps(b.rows[1][0]), m11 = _mm_set1_ps(b.rows[1][1]), m12 = _mm_set1_ps(b.rows[1][2]);
+	const __m128 m20 = _mm_set1_ps(b.rows[2][0]), m21 = _mm_set1_ps(b.rows[2][1]), m22 = _mm_set1_ps(b.rows[2][2]);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 x, y, z;
+		_load_soa_sse4(&p_src[i].x, x, y, z);
+		const __m128 rx = _dot_sse4(m00, x, m01, y, m02, z);
+		const __m128 ry = _dot_sse4(m10, x, m11, y, m12, z);
+		const __m128 rz = _dot_sse4(m20, x, m21, y, m22, z);
+		_store_soa_sse4(&r_dst[i].x, rx, ry, rz);
+	}
+	_xform_vectors_scalar(p_basis, p_src + i, r_dst + i, p_count - i);
+}
+
+// Row k of the basis with the matching origin component in the last lane.
+SIMD_BATCH_TARGET("sse4.1")
+_FORCE_INLINE_ __m128 _load_row_sse4(const Transform3D &p_transform, int p_row) {
+	// Reading four floats stays inside the transform, the origin follows the basis.
+	const __m128 row = _mm_loadu_ps(&p_transform.basis.rows[p_row].x);
+	return _mm_insert_ps(row, _mm_load_ss(&p_transform.origin[p_row]), 0x30);
+}
+
+// Stores rows laid out as (basis row, origin component) back as a Transform3D.
+SIMD_BATCH_TARGET("sse4.1")
+_FORCE_INLINE_ void _store_rows_sse4(Transform3D &r_transform, __m128 p_r0, __m128 p_r1, __m128 p_r2) {
+	float *dst = &r_transform.basis.rows[0].x;
+	const __m128 origin = _mm_shuffle_ps(_mm_unpackhi_ps(p_r0, p_r1), p_r2, _MM_SHUFFLE(3, 2, 3, 2)); // o0 o1 r22 o2
+	_mm_storeu_ps(dst, _mm_blend_ps(p_r0, _mm_shuffle_ps(p_r1, p_r1, 0), 0b1000));
+	_mm_storeu_ps(dst + 4, _mm_shuffle_ps(p_r1, p_r2, _MM_SHUFFLE(1, 0, 2, 1)));
+	_mm_storeu_ps(dst + 8, _mm_shuffle_ps(origin, origin, _MM_SHUFFLE(3, 1, 0, 2)));
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+_FORCE_INLINE_ __m128 _multiply_row_sse4(__m128 p_a_row, __m128 p_b0, __m128 p_b1, __m128 p_b2, __m128 p_neg_zero) {
+	const __m128 a0 = _mm_shuffle_ps(p_a_row, p_a_row, _MM_SHUFFLE(0, 0, 0, 0));
+	const __m128 a1 = _mm_shuffle_ps(p_a_row, p_a_row, _MM_SHUFFLE(1, 1, 1, 1));
+	const __m128 a2 = _mm_shuffle_ps(p_a_row, p_a_row, _MM_SHUFFLE(2, 2, 2, 2));
+	// Adding -0 leaves the basis lanes untouched, including the sign of zero.
+	return _mm_add_ps(_dot_sse4(a0, p_b0, a1, p_b1, a2, p_b2), _mm_blend_ps(p_neg_zero, p_a_row, 0b1000));
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+void _multiply_transforms_sse4(const Transform3D *p_a, uint32_t p_a_step, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	const __m128 neg_zero = _mm_set1_ps(-0.0f);
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Transform3D &a = p_a[i * p_a_step];
+		const __m128 b0 = _load_row_sse4(p_b[i], 0);
+		const __m128 b1 = _load_row_sse4(p_b[i], 1);
+		const __m128 b2 = _load_row_sse4(p_b[i], 2);
+		const __m128 r0 = _multiply_row_sse4(_load_row_sse4(a, 0), b0, b1, b2, neg_zero);
+		const __m128 r1 = _multiply_row_sse4(_load_row_sse4(a, 1), b0, b1, b2, neg_zero);
+		const __m128 r2 = _multiply_row_sse4(_load_row_sse4(a, 2), b0, b1, b2, neg_zero);
+		_store_rows_sse4(r_dst[i], r0, r1, r2);
+	}
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+void _lerp_rescale_sse4(const float *p_from, const float *p_to, const float *p_weights, const float *p_scales, const float *p_offsets, float *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 from = _mm_loadu_ps(p_from + i);
+		const __m128 lerp = _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_to + i), from), _mm_loadu_ps(p_weights + i)));
+		_mm_storeu_ps(r_dst + i, _mm_add_ps(_mm_loadu_ps(p_offsets + i), _mm_mul_ps(lerp, _mm_loadu_ps(p_scales + i))));
+	}
+	_lerp_rescale_scalar(p_from + i, p_to + i, p_weights + i, p_scales + i, p_offsets + i, r_dst + i, p_count - i);
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+void _aabb_lanes_sse4(const Vector3 *p_points, uint32_t p_blocks, real_t r_min[3][4], real_t r_max[3][4]) {
+	__m128 min_x = _mm_loadu_ps(r_min[0]), min_y = _mm_loadu_ps(r_min[1]), min_z = _mm_loadu_ps(r_min[2]);
+	__m128 max_x = _mm_loadu_ps(r_max[0]), max_y = _mm_loadu_ps(r_max[1]), max_z = _mm_loadu_ps(r_max[2]);
+	for (uint32_t i = 0; i < p_blocks; i++) {
+		__m128 x, y, z;
+		_load_soa_sse4(&p_points[i * 4].x, x, y, z);
+		min_x = _mm_min_ps(x, min_x);
+		min_y = _mm_min_ps(y, min_y);
+		min_z = _mm_min_ps(z, min_z);
+		max_x = _mm_max_ps(x, max_x);
+		max_y = _mm_max_ps(y, max_y);
+		max_z = _mm_max_ps(z, max_z);
+	}
+	_mm_storeu_ps(r_min[0], min_x);
+	_mm_storeu_ps(r_min[1], min_y);
+	_mm_storeu_ps(r_min[2], min_z);
+	_mm_storeu_ps(r_max[0], max_x);
+	_mm_storeu_ps(r_max[1], max_y);
+	_mm_storeu_ps(r_max[2], max_z);
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+void _project_box_sse4(const Transform3D &p_transform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	const Basis &b = p_transform.basis;
+	const __m128 m00 = _mm_set1_ps(b.rows[0][0]), m01 = _mm_set1_ps(b.rows[0][1]), m02 = _mm_set1_ps(b.rows[0][2]);
+	const __m128 m10 = _mm_set1_ps(b.rows[1][0]), m11 = _mm_set1_ps(b.rows[1][1]), m12 = _mm_set1_ps(b.rows[1][2]);
+	const __m128 m20 = _mm_set1_ps(b.rows[2][0]), m21 = _mm_set1_ps(b.rows[2][1]), m22 = _mm_set1_ps(b.rows[2][2]);
+	const __m128 ox = _mm_set1_ps(p_transform.origin.x), oy = _mm_set1_ps(p_transform.origin.y), oz = _mm_set1_ps(p_transform.origin.z);
+	const __m128 hx = _mm_set1_ps(p_half_extents.x), hy = _mm_set1_ps(p_half_extents.y), hz = _mm_set1_ps(p_half_extents.z);
+	const __m128 sign = _mm_set1_ps(-0.0f);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 x, y, z;
+		_load_soa_sse4(&p_axes[i].x, x, y, z);
+		// Axes in the box space, as Basis::xform_inv() does.
+		const __m128 lx = _mm_andnot_ps(sign, _dot_sse4(m00, x, m10, y, m20, z));
+		const __m128 ly = _mm_andnot_ps(sign, _dot_sse4(m01, x, m11, y, m21, z));
+		const __m128 lz = _mm_andnot_ps(sign, _dot_sse4(m02, x, m12, y, m22, z));
+		const __m128 length = _dot_sse4(lx, hx, ly, hy, lz, hz);
+		const __m128 distance = _dot_sse4(x, ox, y, oy, z, oz);
+		_mm_storeu_ps(r_min + i, _mm_sub_ps(distance, length));
+		_mm_storeu_ps(r_max + i, _mm_add_ps(distance, length));
+	}
+	_project_box_scalar(p_transform, p_half_extents, p_axes + i, r_min + i, r_max + i, p_count - i);
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+void _project_points_lanes_sse4(const Transform3D &p_transform, const Vector3 &p_axis, const Vector3 *p_points, uint32_t p_blocks, real_t r_min[4], real_t r_max[4]) {
+	const Basis &b = p_transform.basis;
+	const __m128 m00 = _mm_set1_ps(b.rows[0][0]), m01 = _mm_set1_ps(b.rows[0][1]), m02 = _mm_set1_ps(b.rows[0][2]);
+	const __m128 m10 = _mm_set1_ps(b.rows[1][0]), m11 = _mm_set1_ps(b.rows[1][1]), m12 = _mm_set1_ps(b.rows[1][2]);
+	const __m128 m20 = _mm_set1_ps(b.rows[2][0]), m21 = _mm_set1_ps(b.rows[2][1]), m22 = _mm_set1_ps(b.rows[2][2]);
+	const __m128 ox = _mm_set1_ps(p_transform.origin.x), oy = _mm_set1_ps(p_transform.origin.y), oz = _mm_set1_ps(p_transform.origin.z);
+	const __m128 nx = _mm_set1_ps(p_axis.x), ny = _mm_set1_ps(p_axis.y), nz = _mm_set1_ps(p_axis.z);
+
+	__m128 min = _mm_loadu_ps(r_min);
+	__m128 max = _mm_loadu_ps(r_max);
+	for (uint32_t i = 0; i < p_blocks; i++) {
+		__m128 x, y, z;
+		_load_soa_sse4(&p_points[i * 4].x, x, y, z);
+		const __m128 px = _mm_add_ps(_dot_sse4(m00, x, m01, y, m02, z), ox);
+		const __m128 py = _mm_add_ps(_dot_sse4(m10, x, m11, y, m12, z), oy);
+		const __m128 pz = _mm_add_ps(_dot_sse4(m20, x, m21, y, m22, z), oz);
+		const __m128 d = _dot_sse4(nx, px, ny, py, nz, pz);
+		min = _mm_min_ps(d, min);
+		max = _mm_max_ps(d, max);
+	}
+	_mm_storeu_ps(r_min, min);
+	_mm_storeu_ps(r_max, max);
+}
+
+SIMD_BATCH_TARGET("sse4.1")
+void _support_lanes_sse4(const Vector3 &p_direction, const Vector3 *p_points, uint32_t p_blocks, real_t r_max[4], uint32_t r_index[4]) {
+	const __m128 dx = _mm_set1_ps(p_direction.x), dy = _mm_set1_ps(p_direction.y), dz = _mm_set1_ps(p_direction.z);
+	const __m128i step = _mm_set1_epi32(4);
+
+	__m128 max = _mm_loadu_ps(r_max);
+	__m128i index = _mm_loadu_si128((const __m128i *)r_index);
+	__m128i current = _mm_setr_epi32(0, 1, 2, 3);
+	for (uint32_t i = 0; i < p_blocks; i++) {
+		__m128 x, y, z;
+		_load_soa_sse4(&p_points[i * 4].x, x, y, z);
+		const __m128 d = _dot_sse4(dx, x, dy, y, dz, z);
+		const __m128 greater = _mm_cmpgt_ps(d, max);
+		max = _mm_blendv_ps(max, d, greater);
+		index = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(index), _mm_castsi128_ps(current), greater));
+		current = _mm_add_epi32(current, step);
+	}
+	_mm_storeu_ps(r_max, max);
+	_mm_storeu_si128((__m128i *)r_index, index);
+}
+
+const Kernels kernels_sse4 = {
+	_xform_points_sse4,
+	_xform_vectors_sse4,
+	_multiply_transforms_sse4,
+	_lerp_rescale_sse4,
+	_aabb_lanes_sse4,
+	_project_box_sse4,
+	_project_points_lanes_sse4,
+	_support_lanes_sse4,
+};
+
+/* AVX2 */
+
+// Same layout as the SSE4.1 version, with points 0-3 in the low lane and 4-7 in the high lane.
+SIMD_BATCH_TARGET("avx2")
+_FORCE_INLINE_ void _load_soa_avx2(const float *p_src, __m256 &r_x, __m256 &r_y, __m256 &r_z) {
+	const __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p_src)), _mm_loadu_ps(p_src + 12), 1);
+	const __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p_src + 4)), _mm_loadu_ps(p_src + 16), 1);
+	const __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p_src + 8)), _mm_loadu_ps(p_src + 20), 1);
+	const __m256 x = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x44), c, 0x22);
+	const __m256 y = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x99), c, 0x44);
+	const __m256 z = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x22), c, 0x99);
+	r_x = _mm256_permute_ps(x, _MM_SHUFFLE(1, 2, 3, 0));
+	r_y = _mm256_permute_ps(y, _MM_SHUFFLE(2, 3, 0, 1));
+	r_z = _mm256_permute_ps(z, _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+SIMD_BATCH_TARGET("avx2")
+_FORCE_INLINE_ void _store_soa_avx2(float *r_dst, __m256 p_x, __m256 p_y, __m256 p_z) {
+	const __m256 x = _mm256_permute_ps(p_x, _MM_SHUFFLE(1, 2, 3, 0));
+	const __m256 y = _mm256_permute_ps(p_y, _MM_SHUFFLE(2, 3, 0, 1));
+	const __m256 z = _mm256_permute_ps(p_z, _MM_SHUFFLE(3, 0, 1, 2));
+	const __m256 a = _mm256_blend_ps(_mm256_blend_ps(x, y, 0x22), z, 0x44);
+	const __m256 b = _mm256_blend_ps(_mm256_blend_ps(y, z, 0x22), x, 0x44);
+	const __m256 c = _mm256_blend_ps(_mm256_blend_ps(z, x, 0x22), y, 0x44);
+	_mm_storeu_ps(r_dst, _mm256_castps256_ps128(a));
+	_mm_storeu_ps(r_dst + 4, _mm256_castps256_ps128(b));
+	_mm_storeu_ps(r_dst + 8, _mm256_castps256_ps128(c));
+	_mm_storeu_ps(r_dst + 12, _mm256_extractf128_ps(a, 1));
+	_mm_storeu_ps(r_dst + 16, _mm256_extractf128_ps(b, 1));
+	_mm_storeu_ps(r_dst + 20, _mm256_extractf128_ps(c, 1));
+}
+
+SIMD_BATCH_TARGET("avx2")
+_FORCE_INLINE_ __m256 _dot_avx2(__m256 p_a, __m256 p_x, __m256 p_b, __m256 p_y, __m256 p_c, __m256 p_z) {
+	return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p_a, p_x), _mm256_mul_ps(p_b, p_y)), _mm256_mul_ps(p_c, p_z));
+}
+
+SIMD_BATCH_TARGET("avx2")
+void _xform_points_avx2(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_transform.basis;
+	const __m256 m00 = _mm256_set1_ps(b.rows[0][0]), m01 = _mm256_set1_ps(b.rows[0][1]), m02 = _mm256_set1_ps(b.rows[0][2]);
+	const __m256 m10 = _mm256_set1_ps(b.rows[1][0]), m11 = _mm256_set1_ps(b.rows[1][1]), m12 = _mm256_set1_ps(b.rows[1][2]);
+	const __m256 m20 = _mm256_set1_ps(b.rows[2][0]), m21 = _mm256_set1_ps(b.rows[2][1]), m22 = _mm256_set1_ps(b.rows[2][2]);
+	const __m256 ox = _mm256_set1_ps(p_transform.origin.x), oy = _mm256_set1_ps(p_transform.origin.y), oz = _mm256_set1_ps(p_transform.origin.z);
+
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		__m256 x, y, z;
+		_load_soa_avx2(&p_src[i].x, x, y, z);
+		const __m256 rx = _mm256_add_ps(_dot_avx2(m00, x, m01, y, m02, z), ox);
+		const __m256 ry = _mm256_add_ps(_dot_avx2(m10, x, m11, y, m12, z), oy);
+		const __m256 rz = _mm256_add_ps(_dot_avx2(m20, x, m21, y, m22, z), oz);
+		_store_soa_avx2(&r_dst[i].x, rx, ry, rz);
+	}
+	_xform_points_sse4(p_transform, p_src + i, r_dst + i, p_count - i);
+}
+
+SIMD_BATCH_TARGET("avx2")
+void _xform_vectors_avx2(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_basis;
+	const __m256 m00 = _mm256_set1_ps(b.rows[0][0]), m01 = _mm256_set1_ps(b.rows[0][1]), m02 = _mm256_set1_ps(b.rows[0][2]);
+	const __m256 m10 = _mm256_set1_ps(b.rows[1][0]), m11 = _mm256_set1_ps(b.rows[1][1]), m12 = _mm256_set1_ps(b.rows[1][2]);
+	const __m256 m20 = _mm256_set1_ps(b.rows[2][0]), m21 = _mm256_set1_ps(b.rows[2][1]), m22 = _mm256_set1_ps(b.rows[2][2]);
+
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		__m256 x, y, z;
+		_load_soa_avx2(&p_src[i].x, x, y, z);
+		const __m256 rx = _dot_avx2(m00, x, m01, y, m02, z);
+		const __m256 ry = _dot_avx2(m10, x, m11, y, m12, z);
+		const __m256 rz = _dot_avx2(m20, x, m21, y, m22, z);
+		_store_soa_avx2(&r_dst[i].x, rx, ry, rz);
+	}
+	_xform_vectors_sse4(p_basis, p_src + i, r_dst + i, p_count - i);
+}
+
+// Two transforms at a time, one per 128-bit lane.
+SIMD_BATCH_TARGET("avx2")
+void _multiply_transforms_avx2(const Transform3D *p_a, uint32_t p_a_step, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	const __m256 neg_zero = _mm256_set1_ps(-0.0f);
+	uint32_t i = 0;
+	for (; i + 2 <= p_count; i += 2) {
+		const Transform3D &a_lo = p_a[i * p_a_step];
+		const Transform3D &a_hi = p_a[(i + 1) * p_a_step];
+		__m256 b_rows[3];
+		__m256 r_rows[3];
+		for (int k = 0; k < 3; k++) {
+			b_rows[k] = _mm256_set_m128(_load_row_sse4(p_b[i + 1], k), _load_row_sse4(p_b[i], k));
+		}
+		for (int k = 0; k < 3; k++) {
+			const __m256 a_row = _mm256_set_m128(_load_row_sse4(a_hi, k), _load_row_sse4(a_lo, k));
+			const __m256 a0 = _mm256_permute_ps(a_row, _MM_SHUFFLE(0, 0, 0, 0));
+			const __m256 a1 = _mm256_permute_ps(a_row, _MM_SHUFFLE(1, 1, 1, 1));
+			const __m256 a2 = _mm256_permute_ps(a_row, _MM_SHUFFLE(2, 2, 2, 2));
+			r_rows[k] = _mm256_add_ps(_dot_avx2(a0, b_rows[0], a1, b_rows[1], a2, b_rows[2]), _mm256_blend_ps(neg_zero, a_row, 0x88));
+		}
+		_store_rows_sse4(r_dst[i], _mm256_castps256_ps128(r_rows[0]), _mm256_castps256_ps128(r_rows[1]), _mm256_castps256_ps128(r_rows[2]));
+		_store_rows_sse4(r_dst[i + 1], _mm256_extractf128_ps(r_rows[0], 1), _mm256_extractf128_ps(r_rows[1], 1), _mm256_extractf128_ps(r_rows[2], 1));
+	}
+	_multiply_transforms_sse4(p_a + i * p_a_step, p_a_step, p_b + i, r_dst + i, p_count - i);
+}
+
+SIMD_BATCH_TARGET("avx2")
+void _lerp_rescale_avx2(const float *p_from, const float *p_to, const float *p_weights, const float *p_scales, const float *p_offsets, float *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		const __m256 from = _mm256_loadu_ps(p_from + i);
+		const __m256 lerp = _mm256_add_ps(from, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(p_to + i), from), _mm256_loadu_ps(p_weights + i)));
+		_mm256_storeu_ps(r_dst + i, _mm256_add_ps(_mm256_loadu_ps(p_offsets + i), _mm256_mul_ps(lerp, _mm256_loadu_ps(p_scales + i))));
+	}
+	_lerp_rescale_sse4(p_from + i, p_to + i, p_weights + i, p_scales + i, p_offsets + i, r_dst + i, p_count - i);
+}
+
+// Eight axes at a time.
+SIMD_BATCH_TARGET("avx2")
+void _project_box_avx2(const Transform3D &p_transform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	const Basis &b = p_transform.basis;
+	const __m256 m00 = _mm256_set1_ps(b.rows[0][0]), m01 = _mm256_set1_ps(b.rows[0][1]), m02 = _mm256_set1_ps(b.rows[0][2]);
+	const __m256 m10 = _mm256_set1_ps(b.rows[1][0]), m11 = _mm256_set1_ps(b.rows[1][1]), m12 = _mm256_set1_ps(b.rows[1][2]);
+	const __m256 m20 = _mm256_set1_ps(b.rows[2][0]), m21 = _mm256_set1_ps(b.rows[2][1]), m22 = _mm256_set1_ps(b.rows[2][2]);
+	const __m256 ox = _mm256_set1_ps(p_transform.origin.x), oy = _mm256_set1_ps(p_transform.origin.y), oz = _mm256_set1_ps(p_transform.origin.z);
+	const __m256 hx = _mm256_set1_ps(p_half_extents.x), hy = _mm256_set1_ps(p_half_extents.y), hz = _mm256_set1_ps(p_half_extents.z);
+	const __m256 sign = _mm256_set1_ps(-0.0f);
+
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		__m256 x, y, z;
+		_load_soa_avx2(&p_axes[i].x, x, y, z);
+		const __m256 lx = _mm256_andnot_ps(sign, _dot_avx2(m00, x, m10, y, m20, z));
+		const __m256 ly = _mm256_andnot_ps(sign, _dot_avx2(m01, x, m11, y, m21, z));
+		const __m256 lz = _mm256_andnot_ps(sign, _dot_avx2(m02, x, m12, y, m22, z));
+		const __m256 length = _dot_avx2(lx, hx, ly, hy, lz, hz);
+		const __m256 distance = _dot_avx2(x, ox, y, oy, z, oz);
+		_mm256_storeu_ps(r_min + i, _mm256_sub_ps(distance, length));
+		_mm256_storeu_ps(r_max + i, _mm256_add_ps(distance, length));
+	}
+	_project_box_sse4(p_transform, p_half_extents, p_axes + i, r_min + i, r_max + i, p_count - i);
+}
+
+// Two blocks at a time, the high lanes are folded into the low ones at the end.
+SIMD_BATCH_TARGET("avx2")
+void _project_points_lanes_avx2(const Transform3D &p_transform, const Vector3 &p_axis, const Vector3 *p_points, uint32_t p_blocks, real_t r_min[4], real_t r_max[4]) {
+	const Basis &b = p_transform.basis;
+	const __m256 m00 = _mm256_set1_ps(b.rows[0][0]), m01 = _mm256_set1_ps(b.rows[0][1]), m02 = _mm256_set1_ps(b.rows[0][2]);
+	const __m256 m10 = _mm256_set1_ps(b.rows[1][0]), m11 = _mm256_set1_ps(b.rows[1][1]), m12 = _mm256_set1_ps(b.rows[1][2]);
+	const __m256 m20 = _mm256_set1_ps(b.rows[2][0]), m21 = _mm256_set1_ps(b.rows[2][1]), m22 = _mm256_set1_ps(b.rows[2][2]);
+	const __m256 ox = _mm256_set1_ps(p_transform.origin.x), oy = _mm256_set1_ps(p_transform.origin.y), oz = _mm256_set1_ps(p_transform.origin.z);
+	const __m256 nx = _mm256_set1_ps(p_axis.x), ny = _mm256_set1_ps(p_axis.y), nz = _mm256_set1_ps(p_axis.z);
+
+	__m256 min = _mm256_set_m128(_mm_loadu_ps(r_min), _mm_loadu_ps(r_min));
+	__m256 max = _mm256_set_m128(_mm_loadu_ps(r_max), _mm_loadu_ps(r_max));
+	uint32_t i = 0;
+	for (; i + 2 <= p_blocks; i += 2) {
+		__m256 x, y, z;
+		_load_soa_avx2(&p_points[i * 4].x, x, y, z);
+		const __m256 px = _mm256_add_ps(_dot_avx2(m00, x, m01, y, m02, z), ox);
+		const __m256 py = _mm256_add_ps(_dot_avx2(m10, x, m11, y, m12, z), oy);
+		const __m256 pz = _mm256_add_ps(_dot_avx2(m20, x, m21, y, m22, z), oz);
+		const __m256 d = _dot_avx2(nx, px, ny, py, nz, pz);
+		min = _mm256_min_ps(d, min);
+		max = _mm256_max_ps(d, max);
+	}
+	_mm_storeu_ps(r_min, _mm_min_ps(_mm256_extractf128_ps(min, 1), _mm256_castps256_ps128(min)));
+	_mm_storeu_ps(r_max, _mm_max_ps(_mm256_extractf128_ps(max, 1), _mm256_castps256_ps128(max)));
+	_project_points_lanes_sse4(p_transform, p_axis, p_points + i * 4, p_blocks - i, r_min, r_max);
+}
+
+// Finding the bounds is limited by memory bandwidth, the SSE4.1 version is as fast.
+// Supports are mostly searched in small hulls, where wider blocks don't pay off.
+const Kernels kernels_avx2 = {
+	_xform_points_avx2,
+	_xform_vectors_avx2,
+	_multiply_transforms_avx2,
+	_lerp_rescale_avx2,
+	_aabb_lanes_sse4,
+	_project_box_avx2,
+	_project_points_lanes_avx2,
+	_support_lanes_sse4,
+};
+
+#endif // SIMD_BATCH_X86
+
+#ifdef SIMD_BATCH_NEON
+
+/* NEON */
+
+_FORCE_INLINE_ float32x4_t _dot_neon(float32x4_t p_a, float32x4_t p_x, float32x4_t p_b, float32x4_t p_y, float32x4_t p_c, float32x4_t p_z) {
+	// Separate multiplies and adds, vmlaq_f32 may be fused.
+	return vaddq_f32(vaddq_f32(vmulq_f32(p_a, p_x), vmulq_f32(p_b, p_y)), vmulq_f32(p_c, p_z));
+}
+
+void _xform_points_neon(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_transform.basis;
+	const float32x4_t m00 = vdupq_n_f32(b.rows[0][0]), m01 = vdupq_n_f32(b.rows[0][1]), m02 = vdupq_n_f32(b.rows[0][2]);
+	const float32x4_t m10 = vdupq_n_f32(b.rows[1][0]), m11 = vdupq_n_f32(b.rows[1][1]), m12 = vdupq_n_f32(b.rows[1][2]);
+	const float32x4_t m20 = vdupq_n_f32(b.rows[2][0]), m21 = vdupq_n_f32(b.rows[2][1]), m22 = vdupq_n_f32(b.rows[2][2]);
+	const float32x4_t ox = vdupq_n_f32(p_transform.origin.x), oy = vdupq_n_f32(p_transform.origin.y), oz = vdupq_n_f32(p_transform.origin.z);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x3_t v = vld3q_f32(&p_src[i].x);
+		float32x4x3_t r;
+		r.val[0] = vaddq_f32(_dot_neon(m00, v.val[0], m01, v.val[1], m02, v.val[2]), ox);
+		r.val[1] = vaddq_f32(_dot_neon(m10, v.val[0], m11, v.val[1], m12, v.val[2]), oy);
+		r.val[2] = vaddq_f32(_dot_neon(m20, v.val[0], m21, v.val[1], m22, v.val[2]), oz);
+		vst3q_f32(&r_dst[i].x, r);
+	}
+	_xform_points_scalar(p_transform, p_src + i, r_dst + i, p_count - i);
+}
+
+void _xform_vectors_neon(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_basis;
+	const float32x4_t m00 = vdupq_n_f32(b.rows[0][0]), m01 = vdupq_n_f32(b.rows[0][1]), m02 = vdupq_n_f32(b.rows[0][2]);
+	const float32x4_t m10 = vdupq_n_f32(b.rows[1][0]), m11 = vdupq_n_f32(b.rows[1][1]), m12 = vdupq_n_f32(b.rows[1][2]);
+	const float32x4_t m20 = vdupq_n_f32(b.rows[2][0]), m21 = vdupq_n_f32(b.rows[2][1]), m22 = vdupq_n_f32(b.rows[2][2]);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x3_t v = vld3q_f32(&p_src[i].x);
+		float32x4x3_t r;
+		r.val[0] = _dot_neon(m00, v.val[0], m01, v.val[1], m02, v.val[2]);
+		r.val[1] = _dot_neon(m10, v.val[0], m11, v.val[1], m12, v.val[2]);
+		r.val[2] = _dot_neon(m20, v.val[0], m21, v.val[1], m22, v.val[2]);
+		vst3q_f32(&r_dst[i].x, r);
+	}
+	_xform_vectors_scalar(p_basis, p_src + i, r_dst + i, p_count - i);
+}
+
+_FORCE_INLINE_ float32x4_t _load_row_neon(const Transform3D &p_transform, int p_row) {
+	return vsetq_lane_f32(p_transform.origin[p_row], vld1q_f32(&p_transform.basis.rows[p_row].x), 3);
+}
+
+void _multiply_transforms_neon(const Transform3D *p_a, uint32_t p_a_step, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	const float32x4_t neg_zero = vdupq_n_f32(-0.0f);
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Transform3D &a = p_a[i * p_a_step];
+		const float32x4_t b0 = _load_row_neon(p_b[i], 0);
+		const float32x4_t b1 = _load_row_neon(p_b[i], 1);
+		const float32x4_t b2 = _load_row_neon(p_b[i], 2);
+		float rows[3][4];
+		for (int k = 0; k < 3; k++) {
+			const float32x4_t a_row = _load_row_neon(a, k);
+			const float32x4_t a0 = vdupq_n_f32(vgetq_lane_f32(a_row, 0));
+			const float32x4_t a1 = vdupq_n_f32(vgetq_lane_f32(a_row, 1));
+			const float32x4_t a2 = vdupq_n_f32(vgetq_lane_f32(a_row, 2));
+			const float32x4_t offset = vsetq_lane_f32(vgetq_lane_f32(a_row, 3), neg_zero, 3);
+			vst1q_f32(rows[k], vaddq_f32(_dot_neon(a0, b0, a1, b1, a2, b2), offset));
+		}
+		Transform3D &dst = r_dst[i];
+		for (int k = 0; k < 3; k++) {
+			dst.basis.rows[k] = Vector3(rows[k][0], rows[k][1], rows[k][2]);
+			dst.origin[k] = rows[k][3];
+		}
+	}
+}
+
+void _lerp_rescale_neon(const float *p_from, const float *p_to, const float *p_weights, const float *p_scales, const float *p_offsets, float *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4_t from = vld1q_f32(p_from + i);
+		const float32x4_t lerp = vaddq_f32(from, vmulq_f32(vsubq_f32(vld1q_f32(p_to + i), from), vld1q_f32(p_weights + i)));
+		vst1q_f32(r_dst + i, vaddq_f32(vld1q_f32(p_offsets + i), vmulq_f32(lerp, vld1q_f32(p_scales + i))));
+	}
+	_lerp_rescale_scalar(p_from + i, p_to + i, p_weights + i, p_scales + i, p_offsets + i, r_dst + i, p_count - i);
+}
+
+void _aabb_lanes_neon(const Vector3 *p_points, uint32_t p_blocks, real_t r_min[3][4], real_t r_max[3][4]) {
+	float32x4_t mins[3] = { vld1q_f32(r_min[0]), vld1q_f32(r_min[1]), vld1q_f32(r_min[2]) };
+	float32x4_t maxs[3] = { vld1q_f32(r_max[0]), vld1q_f32(r_max[1]), vld1q_f32(r_max[2]) };
+	for (uint32_t i = 0; i < p_blocks; i++) {
+		const float32x4x3_t v = vld3q_f32(&p_points[i * 4].x);
+		for (int axis = 0; axis < 3; axis++) {
+			// vminq_f32 and vmaxq_f32 order -0 and +0 and propagate NaN differently from the scalar code.
+			mins[axis] = vbslq_f32(vcltq_f32(v.val[axis], mins[axis]), v.val[axis], mins[axis]);
+			maxs[axis] = vbslq_f32(vcgtq_f32(v.val[axis], maxs[axis]), v.val[axis], maxs[axis]);
+		}
+	}
+	for (int axis = 0; axis < 3; axis++) {
+		vst1q_f32(r_min[axis], mins[axis]);
+		vst1q_f32(r_max[axis], maxs[axis]);
+	}
+}
+
+void _project_box_neon(const Transform3D &p_transform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	const Basis &b = p_transform.basis;
+	const float32x4_t m00 = vdupq_n_f32(b.rows[0][0]), m01 = vdupq_n_f32(b.rows[0][1]), m02 = vdupq_n_f32(b.rows[0][2]);
+	const float32x4_t m10 = vdupq_n_f32(b.rows[1][0]), m11 = vdupq_n_f32(b.rows[1][1]), m12 = vdupq_n_f32(b.rows[1][2]);
+	const float32x4_t m20 = vdupq_n_f32(b.rows[2][0]), m21 = vdupq_n_f32(b.rows[2][1]), m22 = vdupq_n_f32(b.rows[2][2]);
+	const float32x4_t ox = vdupq_n_f32(p_transform.origin.x), oy = vdupq_n_f32(p_transform.origin.y), oz = vdupq_n_f32(p_transform.origin.z);
+	const float32x4_t hx = vdupq_n_f32(p_half_extents.x), hy = vdupq_n_f32(p_half_extents.y), hz = vdupq_n_f32(p_half_extents.z);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x3_t v = vld3q_f32(&p_axes[i].x);
+		const float32x4_t lx = vabsq_f32(_dot_neon(m00, v.val[0], m10, v.val[1], m20, v.val[2]));
+		const float32x4_t ly = vabsq_f32(_dot_neon(m01, v.val[0], m11, v.val[1], m21, v.val[2]));
+		const float32x4_t lz = vabsq_f32(_dot_neon(m02, v.val[0], m12, v.val[1], m22, v.val[2]));
+		const float32x4_t length = _dot_neon(lx, hx, ly, hy, lz, hz);
+		const float32x4_t distance = _dot_neon(v.val[0], ox, v.val[1], oy, v.val[2], oz);
+		vst1q_f32(r_min + i, vsubq_f32(distance, length));
+		vst1q_f32(r_max + i, vaddq_f32(distance, length));
+	}
+	_project_box_scalar(p_transform, p_half_extents, p_axes + i, r_min + i, r_max + i, p_count - i);
+}
+
+void _project_points_lanes_neon(const Transform3D &p_transform, const Vector3 &p_axis, const Vector3 *p_points, uint32_t p_blocks, real_t r_min[4], real_t r_max[4]) {
+	const Basis &b = p_transform.basis;
+	const float32x4_t m00 = vdupq_n_f32(b.rows[0][0]), m01 = vdupq_n_f32(b.rows[0][1]), m02 = vdupq_n_f32(b.rows[0][2]);
+	const float32x4_t m10 = vdupq_n_f32(b.rows[1][0]), m11 = vdupq_n_f32(b.rows[1][1]), m12 = vdupq_n_f32(b.rows[1][2]);
+	const float32x4_t m20 = vdupq_n_f32(b.rows[2][0]), m21 = vdupq_n_f32(b.rows[2][1]), m22 = vdupq_n_f32(b.rows[2][2]);
+	const float32x4_t ox = vdupq_n_f32(p_transform.origin.x), oy = vdupq_n_f32(p_transform.origin.y), oz = vdupq_n_f32(p_transform.origin.z);
+	const float32x4_t nx = vdupq_n_f32(p_axis.x), ny = vdupq_n_f32(p_axis.y), nz = vdupq_n_f32(p_axis.z);
+
+	float32x4_t min = vld1q_f32(r_min);
+	float32x4_t max = vld1q_f32(r_max);
+	for (uint32_t i = 0; i < p_blocks; i++) {
+		const float32x4x3_t v = vld3q_f32(&p_points[i * 4].x);
+		const float32x4_t px = vaddq_f32(_dot_neon(m00, v.val[0], m01, v.val[1], m02, v.val[2]), ox);
+		const float32x4_t py = vaddq_f32(_dot_neon(m10, v.val[0], m11, v.val[1], m12, v.val[2]), oy);
+		const float32x4_t pz = vaddq_f32(_dot_neon(m20, v.val[0], m21, v.val[1], m22, v.val[2]), oz);
+		const float32x4_t d = _dot_neon(nx, px, ny, py, nz, pz);
+		min = vbslq_f32(vcltq_f32(d, min), d, min);
+		max = vbslq_f32(vcgtq_f32(d, max), d, max);
+	}
+	vst1q_f32(r_min, min);
+	vst1q_f32(r_max, max);
+}
+
+void _support_lanes_neon(const Vector3 &p_direction, const Vector3 *p_points, uint32_t p_blocks, real_t r_max[4], uint32_t r_index[4]) {
+	const float32x4_t dx = vdupq_n_f32(p_direction.x), dy = vdupq_n_f32(p_direction.y), dz = vdupq_n_f32(p_direction.z);
+	const uint32_t lanes[4] = { 0, 1, 2, 3 };
+	const uint32x4_t step = vdupq_n_u32(4);
+
+	float32x4_t max = vld1q_f32(r_max);
+	uint32x4_t index = vld1q_u32(r_index);
+	uint32x4_t current = vld1q_u32(lanes);
+	for (uint32_t i = 0; i < p_blocks; i++) {
+		const float32x4x3_t v = vld3q_f32(&p_points[i * 4].x);
+		const float32x4_t d = _dot_neon(dx, v.val[0], dy, v.val[1], dz, v.val[2]);
+		const uint32x4_t greater = vcgtq_f32(d, max);
+		max = vbslq_f32(greater, d, max);
+		index = vbslq_u32(greater, current, index);
+		current = vaddq_u32(current, step);
+	}
+	vst1q_f32(r_max, max);
+	vst1q_u32(r_index, index);
+}
+
+const Kernels kernels_neon = {
+	_xform_points_neon,
+	_xform_vectors_neon,
+	_multiply_transforms_neon,
+	_lerp_rescale_neon,
+	_aabb_lanes_neon,
+	_project_box_neon,
+	_project_points_lanes_neon,
+	_support_lanes_neon,
+};
+
+#endif // SIMD_BATCH_NEON
+
+SIMDBatch::Level _detect_level() {
+#if defined(SIMD_BATCH_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	const int max_leaf = info[0];
+	if (max_leaf < 1) {
+		return SIMDBatch::LEVEL_SCALAR;
+	}
+	__cpuid(info, 1);
+	const bool sse41 = info[2] & (1 << 19);
+	const bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+	bool avx2 = false;
+	if (max_leaf >= 7 && os_avx) {
+		__cpuidex(info, 7, 0);
+		avx2 = info[1] & (1 << 5);
+	}
+#else
+	__builtin_cpu_init();
+	const bool sse41 = __builtin_cpu_supports("sse4.1");
+	const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+	if (avx2) {
+		return SIMDBatch::LEVEL_AVX2;
+	}
+	if (sse41) {
+		return SIMDBatch::LEVEL_SSE4;
+	}
+	return SIMDBatch::LEVEL_SCALAR;
+#elif defined(SIMD_BATCH_NEON)
+	return SIMDBatch::LEVEL_NEON;
+#else
+	return SIMDBatch::LEVEL_SCALAR;
+#endif
+}
+
+const Kernels *_get_kernels(SIMDBatch::Level p_level) {
+	switch (p_level) {
+#ifdef SIMD_BATCH_X86
+		case SIMDBatch::LEVEL_AVX2:
+			return &kernels_avx2;
+		case SIMDBatch::LEVEL_SSE4:
+			return &kernels_sse4;
+#endif
+#ifdef SIMD_BATCH_NEON
+		case SIMDBatch::LEVEL_NEON:
+			return &kernels_neon;
+#endif
+		default:
+			return &kernels_scalar;
+	}
+}
+
+struct Dispatch {
+	SIMDBatch::Level level;
+	const Kernels *kernels;
+};
+
+Dispatch &_get_dispatch() {
+	static Dispatch dispatch = { _detect_level(), _get_kernels(_detect_level()) };
+	return dispatch;
+}
+
+} // namespace
+
+SIMDBatch::Level SIMDBatch::get_supported_level() {
+	static const Level supported = _detect_level();
+	return supported;
+}
+
+SIMDBatch::Level SIMDBatch::get_level() {
+	return _get_dispatch().level;
+}
+
+void SIMDBatch::set_level(Level p_level) {
+	const Level supported = get_supported_level();
+	bool valid = p_level == LEVEL_SCALAR || p_level == supported;
+	if (supported == LEVEL_AVX2 && p_level == LEVEL_SSE4) {
+		valid = true;
+	}
+	Dispatch &dispatch = _get_dispatch();
+	dispatch.level = valid ? p_level : LEVEL_SCALAR;
+	dispatch.kernels = _get_kernels(dispatch.level);
+}
+
+void SIMDBatch::xform_points(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	_get_dispatch().kernels->xform_points(p_transform, p_src, r_dst, p_count);
+}
+
+void SIMDBatch::xform_vectors(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	_get_dispatch().kernels->xform_vectors(p_basis, p_src, r_dst, p_count);
+}
+
+void SIMDBatch::multiply_transforms(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	_get_dispatch().kernels->multiply_transforms(p_a, 1, p_b, r_dst, p_count);
+}
+
+void SIMDBatch::multiply_transforms(const Transform3D &p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	// Copy in case p_a lives in r_dst.
+	const Transform3D a = p_a;
+	_get_dispatch().kernels->multiply_transforms(&a, 0, p_b, r_dst, p_count);
+}
+
+void SIMDBatch::lerp_rescale(const float *p_from, const float *p_to, const float *p_weights, const float *p_scales, const float *p_offsets, float *r_dst, uint32_t p_count) {
+	_get_dispatch().kernels->lerp_rescale(p_from, p_to, p_weights, p_scales, p_offsets, r_dst, p_count);
+}
+
+AABB SIMDBatch::compute_aabb(const Vector3 *p_points, uint32_t p_count) {
+	if (p_count == 0) {
+		return AABB();
+	}
+
+	real_t lane_min[3][4];
+	real_t lane_max[3][4];
+	for (int axis = 0; axis < 3; axis++) {
+		for (int lane = 0; lane < 4; lane++) {
+			lane_min[axis][lane] = p_points[0][axis];
+			lane_max[axis][lane] = p_points[0][axis];
+		}
+	}
+
+	const uint32_t blocks = p_count / 4;
+	_get_dispatch().kernels->aabb_lanes(p_points, blocks, lane_min, lane_max);
+	for (uint32_t i = blocks * 4; i < p_count; i++) {
+		for (int axis = 0; axis < 3; axis++) {
+			lane_min[axis][i & 3] = _lane_min(p_points[i][axis], lane_min[axis][i & 3]);
+			lane_max[axis][i & 3] = _lane_max(p_points[i][axis], lane_max[axis][i & 3]);
+		}
+	}
+
+	Vector3 begin;
+	Vector3 end;
+	for (int axis = 0; axis < 3; axis++) {
+		begin[axis] = _lane_min(_lane_min(lane_min[axis][0], lane_min[axis][1]), _lane_min(lane_min[axis][2], lane_min[axis][3]));
+		end[axis] = _lane_max(_lane_max(lane_max[axis][0], lane_max[axis][1]), _lane_max(lane_max[axis][2], lane_max[axis][3]));
+	}
+	return AABB(begin, end - begin);
+}
+
+void SIMDBatch::project_box(const Transform3D &p_transform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	_get_dispatch().kernels->project_box(p_transform, p_half_extents, p_axes, r_min, r_max, p_count);
+}
+
+void SIMDBatch::project_points(const Transform3D &p_transform, const Vector3 &p_axis, const Vector3 *p_points, uint32_t p_count, real_t &r_min, real_t &r_max) {
+	if (p_count == 0) {
+		return;
+	}
+
+	const real_t first = p_axis.dot(p_transform.xform(p_points[0]));
+	real_t lane_min[4] = { first, first, first, first };
+	real_t lane_max[4] = { first, first, first, first };
+
+	const uint32_t blocks = p_count / 4;
+	_get_dispatch().kernels->project_points_lanes(p_transform, p_axis, p_points, blocks, lane_min, lane_max);
+	for (uint32_t i = blocks * 4; i < p_count; i++) {
+		const real_t d = p_axis.dot(p_transform.xform(p_points[i]));
+		lane_min[i & 3] = _lane_min(d, lane_min[i & 3]);
+		lane_max[i & 3] = _lane_max(d, lane_max[i & 3]);
+	}
+
+	r_min = _lane_min(_lane_min(lane_min[0], lane_min[1]), _lane_min(lane_min[2], lane_min[3]));
+	r_max = _lane_max(_lane_max(lane_max[0], lane_max[1]), _lane_max(lane_max[2], lane_max[3]));
+}
+
+uint32_t SIMDBatch::get_support_index(const Vector3 &p_direction, const Vector3 *p_points, uint32_t p_count) {
+	if (p_count == 0) {
+		return 0;
+	}
+
+	const real_t first = p_direction.dot(p_points[0]);
+	real_t lane_max[4] = { first, first, first, first };
+	uint32_t lane_index[4] = { 0, 0, 0, 0 };
+
+	const uint32_t blocks = p_count / 4;
+	_get_dispatch().kernels->support_lanes(p_direction, p_points, blocks, lane_max, lane_index);
+	for (uint32_t i = blocks * 4; i < p_count; i++) {
+		const real_t d = p_direction.dot(p_points[i]);
+		if (d > lane_max[i & 3]) {
+			lane_max[i & 3] = d;
+			lane_index[i & 3] = i;
+		}
+	}
+
+	// Lanes hold the first point reaching their maximum, so on ties the
+	// lowest index is the first point overall.
+	uint32_t best = 0;
+	for (uint32_t lane = 1; lane < 4; lane++) {
+		if (lane_max[lane] > lane_max[best] || (lane_max[lane] == lane_max[best] && lane_index[lane] < lane_index[best])) {
+			best = lane;
+		}
+	}
+	return lane_index[best];
+}
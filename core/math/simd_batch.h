@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  simd_batch.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SIMD_BATCH_H
+#define SIMD_BATCH_H
+
+#include "core/math/aabb.h"
+#include "core/math/transform_3d.h"
+
+// Batch kernels for arrays of vectors and transforms.
+//
+// The best implementation for the running CPU (AVX2, SSE4.1 or NEON) is picked
+// on first use. All of them, and the scalar fallback, produce exactly the same
+// bits as the equivalent loop over the scalar Transform3D and Basis operators,
+// so results don't depend on the machine. Builds with REAL_T_IS_DOUBLE always
+// use the scalar path.
+//
+// Source and destination arrays may be the same, but must not partially overlap.
+class SIMDBatch {
+public:
+	enum Level {
+		LEVEL_SCALAR,
+		LEVEL_SSE4,
+		LEVEL_AVX2,
+		LEVEL_NEON,
+	};
+
+	static Level get_supported_level();
+	static Level get_level();
+	// Forces a specific implementation, for testing and benchmarking. Falls back
+	// to the scalar one if the requested level isn't supported.
+	static void set_level(Level p_level);
+
+	// r_dst[i] = p_transform.xform(p_src[i])
+	static void xform_points(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+	// r_dst[i] = p_basis.xform(p_src[i]). Pass the inverse transpose of the basis to transform normals.
+	static void xform_vectors(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+	// r_dst[i] = p_a[i] * p_b[i]
+	static void multiply_transforms(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count);
+	// r_dst[i] = p_a * p_b[i]
+	static void multiply_transforms(const Transform3D &p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count);
+	// r_dst[i] = p_offsets[i] + Math::lerp(p_from[i], p_to[i], p_weights[i]) * p_scales[i], in single precision.
+	static void lerp_rescale(const float *p_from, const float *p_to, const float *p_weights, const float *p_scales, const float *p_offsets, float *r_dst, uint32_t p_count);
+	// Smallest AABB containing all points. Returns an empty AABB if there are none.
+	static AABB compute_aabb(const Vector3 *p_points, uint32_t p_count);
+
+	// Projections used by the separating axis tests of the physics engine.
+
+	// Range of a box with p_half_extents, placed by p_transform, along each axis:
+	// r_min[i] = p_axes[i].dot(p_transform.origin) - p_transform.basis.xform_inv(p_axes[i]).abs().dot(p_half_extents)
+	// and r_max[i] the same with the lengths added.
+	static void project_box(const Transform3D &p_transform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count);
+	// Smallest and largest p_axis.dot(p_transform.xform(p_points[i])). Leaves r_min and r_max untouched if there are no points.
+	static void project_points(const Transform3D &p_transform, const Vector3 &p_axis, const Vector3 *p_points, uint32_t p_count, real_t &r_min, real_t &r_max);
+	// Index of the first point with the largest p_direction.dot(p_points[i]), or 0 if there are no points.
+	static uint32_t get_support_index(const Vector3 &p_direction, const Vector3 *p_points, uint32_t p_count);
+};
+
+#endif // SIMD_BATCH_H
@@ -31,6 +31,7 @@
 #include "transform_3d.h"
 
 #include "core/math/math_funcs.h"
+#include "core/math/simd_batch.h"
 #include "core/string/ustring.h"
 
 void Transform3D::affine_invert() {
@@ -208,6 +209,13 @@ Transform3D Transform3D::operator*(real_t p_val) const {
 	return ret;
 }
 
+Vector<Vector3> Transform3D::xform(const Vector<Vector3> &p_array) const {
+	Vector<Vector3> array;
+	array.resize(p_array.size());
+	SIMDBatch::xform_points(*this, p_array.ptr(), array.ptrw(), p_array.size());
+	return array;
+}
+
 void Transform3D::operator/=(real_t p_val) {
 	basis /= p_val;
 	origin /= p_val;
@@ -181,11 +181,40 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #endif
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_local_or_steal_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->local_queue.pop(task)) {
+		return task;
+	}
+
+	uint32_t thread_count = threads.size();
+	if (thread_count < 2) {
+		return nullptr;
+	}
+
+	// Start at a random victim so thieves don't all hammer the same deque,
+	// but visit all of them so an empty result means there was nothing to steal.
+	p_thread_data->steal_seed ^= p_thread_data->steal_seed << 13;
+	p_thread_data->steal_seed ^= p_thread_data->steal_seed >> 17;
+	p_thread_data->steal_seed ^= p_thread_data->steal_seed << 5;
+	uint32_t victim = p_thread_data->steal_seed % thread_count;
+	for (uint32_t i = 0; i < thread_count; i++, victim = (victim + 1) % thread_count) {
+		if (victim == p_thread_data->index) {
+			continue;
+		}
+		if (threads[victim].local_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: own deque or stealing, without touching the mutex.
+		Task *task_to_process = singleton->_pop_local_or_steal_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
@@ -196,8 +225,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
-				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				// Local deques are only pushed to with the mutex held, so checking them again
+				// before waiting guarantees no posted task is missed.
+				task_to_process = singleton->_pop_local_or_steal_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+					DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				}
 			}
 		}
 
@@ -228,7 +262,10 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			// Tasks posted from a pool thread go to its own deque, where other threads can steal them.
+			if (!caller_pool_thread || !caller_pool_thread->local_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -472,7 +509,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !p_caller_pool_thread->local_queue.is_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -491,7 +528,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					}
 				}
 
-				if (singleton->task_queue.first()) {
+				task_to_process = _pop_local_or_steal_task(p_caller_pool_thread);
+				if (!task_to_process && task_queue.first()) {
 					task_to_process = task_queue.first()->self();
 					task_queue.remove(task_queue.first());
 				}
@@ -712,6 +750,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
+		threads[i].steal_seed = hash_murmur3_one_32(i + 1);
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
 		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -98,6 +99,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -118,6 +120,10 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		// Tasks posted from this thread. Pushed only by this thread and with task_mutex held,
+		// popped by this thread and stolen by the others without locking.
+		WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE> local_queue;
+		uint32_t steal_seed = 0;
 
 		ThreadData() :
 				ready_for_scripting(false),
@@ -153,6 +159,7 @@ private:
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	Task *_pop_local_or_steal_task(ThreadData *p_thread_data);
 
 	void _post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
@@ -309,6 +309,8 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "filesystem/resources/binary_stream_threshold_kb", PROPERTY_HINT_RANGE, "0,65536,1,or_greater,suffix:KiB"), 0);
 }
 
 void register_core_singletons() {
@@ -381,6 +383,7 @@ void unregister_core_types() {
 
 	// Destroy singletons in reverse order to ensure dependencies are not broken.
 
+	ResourceFormatLoaderBinary::cancel_streaming();
 	memdelete(worker_thread_pool);
 
 	memdelete(_engine_debugger);
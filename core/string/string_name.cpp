@@ -33,13 +33,16 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
+#include <thread>
+
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
 	scs.ptr = p_ptr;
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+std::atomic<StringName::_Data *> StringName::_table[STRING_TABLE_LEN];
+StringName::Shard StringName::_shards[STRING_TABLE_SHARD_COUNT];
 
 StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
@@ -55,7 +58,7 @@ bool StringName::debug_stringname = false;
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
+		_table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	configured = true;
 }
@@ -67,10 +70,10 @@ void StringName::cleanup() {
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
+			_Data *d = _table[i].load(std::memory_order_relaxed);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_relaxed);
 			}
 		}
 
@@ -80,10 +83,10 @@ void StringName::cleanup() {
 		int unreferenced_stringnames = 0;
 		int rarely_referenced_stringnames = 0;
 		for (int i = 0; i < data.size(); i++) {
-			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references.get()));
+			if (data[i]->debug_references.get() == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (data[i]->debug_references.get() < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -94,8 +97,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
+		while (_table[i].load(std::memory_order_relaxed)) {
+			_Data *d = _table[i].load(std::memory_order_relaxed);
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -106,21 +109,61 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			_table[i].store(d->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
 			memdelete(d);
 		}
 	}
+	for (int i = 0; i < STRING_TABLE_SHARD_COUNT; i++) {
+		_free_deferred(_shards[i]);
+	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
 }
 
+void StringName::_free_deferred(Shard &p_shard) {
+	while (p_shard.deferred_free) {
+		_Data *d = p_shard.deferred_free;
+		p_shard.deferred_free = d->deferred_next;
+		memdelete(d);
+	}
+	p_shard.deferred_count = 0;
+}
+
+void StringName::_free_unlinked(Shard &p_shard, _Data *p_data) {
+	// Called with the shard locked. A lock-free lookup may still be walking through the entry.
+	p_data->deferred_next = p_shard.deferred_free;
+	p_shard.deferred_free = p_data;
+	p_shard.deferred_count++;
+
+	// Pairs with the fence in _lookup(): either the lookup is counted here, or it doesn't see the unlinked entries.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (p_shard.readers[0].load(std::memory_order_relaxed) == 0 && p_shard.readers[1].load(std::memory_order_relaxed) == 0) {
+		_free_deferred(p_shard);
+		return;
+	}
+	if (p_shard.deferred_count < STRING_TABLE_DEFERRED_FREE_LIMIT) {
+		return;
+	}
+
+	// Too many entries are waiting on constant lookups. New lookups are counted in the other counter,
+	// so waiting for the lookups that started before the flip is bounded.
+	const uint32_t epoch = p_shard.epoch.load(std::memory_order_relaxed);
+	p_shard.epoch.store(epoch ^ 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (p_shard.readers[epoch].load(std::memory_order_acquire) != 0) {
+		std::this_thread::yield();
+	}
+	_free_deferred(p_shard);
+}
+
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+		Shard &shard = _shards[_data->idx & STRING_TABLE_SHARD_MASK];
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
@@ -129,19 +172,21 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+		// Unlinking leaves our own next pointer intact, so lookups currently here can carry on.
+		_Data *next = _data->next.load(std::memory_order_relaxed);
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next, std::memory_order_release);
 		} else {
-			if (_table[_data->idx] != _data) {
+			if (_table[_data->idx].load(std::memory_order_relaxed) != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			_table[_data->idx].store(next, std::memory_order_release);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
 		}
-		memdelete(_data);
+		_free_unlinked(shard, _data);
 	}
 
 	_data = nullptr;
@@ -207,182 +252,146 @@ void StringName::assign_static_unique_class_name(StringName *ptr, const char *p_
 	mutex.unlock();
 }
 
-StringName::StringName(const char *p_name, bool p_static) {
-	_data = nullptr;
-
-	ERR_FAIL_COND(!configured);
-
-	if (!p_name || p_name[0] == 0) {
-		return; //empty, ignore
+template <typename T>
+StringName::_Data *StringName::_lookup(uint32_t p_hash, const T &p_name) {
+	uint32_t idx = p_hash & STRING_TABLE_MASK;
+	Shard &shard = _shards[idx & STRING_TABLE_SHARD_MASK];
+
+	uint32_t epoch = shard.epoch.load(std::memory_order_relaxed);
+	while (true) {
+		shard.readers[epoch].fetch_add(1, std::memory_order_relaxed);
+		// Pairs with the fences in _free_unlinked(), see there.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const uint32_t current_epoch = shard.epoch.load(std::memory_order_relaxed);
+		if (current_epoch == epoch) {
+			break;
+		}
+		// Flipped meanwhile, the counter may already be drained by a free.
+		shard.readers[epoch].fetch_sub(1, std::memory_order_release);
+		epoch = current_epoch;
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
+	_Data *data = _table[idx].load(std::memory_order_acquire);
+	while (data) {
 		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
+		if (data->hash == p_hash && data->get_name() == p_name) {
 			break;
 		}
-		_data = _data->next;
+		data = data->next.load(std::memory_order_acquire);
 	}
+	// Fails if the entry is being removed; callers then go through the locked path.
+	bool found = data && data->refcount.ref();
+	shard.readers[epoch].fetch_sub(1, std::memory_order_release);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
+	if (!found) {
+		return nullptr;
 	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
+		data->debug_references.increment();
 	}
 #endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	return data;
 }
 
-StringName::StringName(const StaticCString &p_static_string, bool p_static) {
-	_data = nullptr;
-
-	ERR_FAIL_COND(!configured);
-
-	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
-
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
+template <typename T>
+StringName::_Data *StringName::_intern(uint32_t p_hash, const T &p_name, const char *p_static_cname, bool p_static) {
+	_Data *data = _lookup(p_hash, p_name);
+	if (data) {
+		// exists
+		if (p_static) {
+			data->static_count.increment();
+		}
+		return data;
+	}
 
-	_data = _table[idx];
+	uint32_t idx = p_hash & STRING_TABLE_MASK;
+	Shard &shard = _shards[idx & STRING_TABLE_SHARD_MASK];
+	MutexLock lock(shard.mutex);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr) {
+	// Someone may have added it since the lookup.
+	data = _table[idx].load(std::memory_order_relaxed);
+	while (data) {
+		if (data->hash == p_hash && data->get_name() == p_name) {
 			break;
 		}
-		_data = _data->next;
+		data = data->next.load(std::memory_order_relaxed);
 	}
 
-	if (_data && _data->refcount.ref()) {
-		// exists
+	if (data && data->refcount.ref()) {
 		if (p_static) {
-			_data->static_count.increment();
+			data->static_count.increment();
 		}
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			data->debug_references.increment();
 		}
 #endif
-		return;
+		return data;
 	}
 
-	_data = memnew(_Data);
+	data = memnew(_Data);
+	if (p_static_cname) {
+		data->cname = p_static_cname;
+	} else {
+		data->name = p_name;
+	}
+	data->refcount.init();
+	data->static_count.set(p_static ? 1 : 0);
+	data->hash = p_hash;
+	data->idx = idx;
+	data->prev = nullptr;
 
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
+		data->refcount.ref();
+		data->static_count.increment();
 	}
 #endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
+
+	_Data *head = _table[idx].load(std::memory_order_relaxed);
+	data->next.store(head, std::memory_order_relaxed);
+	if (head) {
+		head->prev = data;
 	}
-	_table[idx] = _data;
+	// Publish only once fully initialized.
+	_table[idx].store(data, std::memory_order_release);
+	return data;
 }
 
-StringName::StringName(const String &p_name, bool p_static) {
+StringName::StringName(const char *p_name, bool p_static) {
 	_data = nullptr;
 
 	ERR_FAIL_COND(!configured);
 
-	if (p_name.is_empty()) {
-		return;
+	if (!p_name || p_name[0] == 0) {
+		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
+	_data = _intern(String::hash(p_name), p_name, nullptr, p_static);
+}
+
+StringName::StringName(const StaticCString &p_static_string, bool p_static) {
+	_data = nullptr;
 
-	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	ERR_FAIL_COND(!configured);
 
-	_data = _table[idx];
+	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	while (_data) {
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_data = _intern(String::hash(p_static_string.ptr), p_static_string.ptr, p_static_string.ptr, p_static);
+}
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
+StringName::StringName(const String &p_name, bool p_static) {
+	_data = nullptr;
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
+	ERR_FAIL_COND(!configured);
 
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
+	if (p_name.is_empty()) {
+		return;
 	}
-	_table[idx] = _data;
+
+	_data = _intern(p_name.hash(), p_name, nullptr, p_static);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -393,32 +402,8 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	_Data *data = _lookup(String::hash(p_name), p_name);
+	return data ? StringName(data) : StringName(); //does not exist
 }
 
 StringName StringName::search(const char32_t *p_name) {
@@ -429,58 +414,15 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	_Data *data = _lookup(String::hash(p_name), p_name);
+	return data ? StringName(data) : StringName(); //does not exist
 }
 
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name()) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	_Data *data = _lookup(p_name.hash(), p_name);
+	return data ? StringName(data) : StringName(); //does not exist
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -35,6 +35,8 @@
 #include "core/string/ustring.h"
 #include "core/templates/safe_refcount.h"
 
+#include <atomic>
+
 #define UNIQUE_NODE_PREFIX "%"
 
 class Main;
@@ -48,7 +50,11 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARD_COUNT = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_SHARD_MASK = STRING_TABLE_SHARD_COUNT - 1,
+		STRING_TABLE_DEFERRED_FREE_LIMIT = 32,
 	};
 
 	struct _Data {
@@ -57,17 +63,38 @@ class StringName {
 		const char *cname = nullptr;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
 		int idx = 0;
 		uint32_t hash = 0;
 		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		std::atomic<_Data *> next = nullptr; // Also followed by lock-free lookups.
+		_Data *deferred_next = nullptr;
 		_Data() {}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	// Buckets are grouped in shards, each one with its own lock for inserting and removing entries.
+	// Lookups of existing names walk the buckets without locking, so unlinked entries are only
+	// freed once no lookup is walking the shard. Lookups are counted in one of two counters picked
+	// by the epoch; flipping it lets the other counter drain even while lookups keep coming.
+	struct alignas(64) Shard {
+		Mutex mutex;
+		std::atomic<uint32_t> epoch = 0;
+		std::atomic<uint32_t> readers[2] = {};
+		_Data *deferred_free = nullptr;
+		uint32_t deferred_count = 0;
+	};
+
+	static std::atomic<_Data *> _table[STRING_TABLE_LEN];
+	static Shard _shards[STRING_TABLE_SHARD_COUNT];
+
+	template <typename T>
+	static _Data *_lookup(uint32_t p_hash, const T &p_name);
+	template <typename T>
+	static _Data *_intern(uint32_t p_hash, const T &p_name, const char *p_static_cname, bool p_static);
+	static void _free_unlinked(Shard &p_shard, _Data *p_data);
+	static void _free_deferred(Shard &p_shard);
 
 	_Data *_data = nullptr;
 
@@ -82,7 +109,7 @@ class StringName {
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
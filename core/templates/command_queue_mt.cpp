@@ -33,6 +33,10 @@
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
 
+SafeNumeric<uint64_t> CommandQueueMT::total_commands;
+SafeNumeric<uint64_t> CommandQueueMT::total_bytes;
+SafeNumeric<uint64_t> CommandQueueMT::total_producer_stalls;
+
 void CommandQueueMT::lock() {
 	mutex.lock();
 }
@@ -41,9 +45,153 @@ void CommandQueueMT::unlock() {
 	mutex.unlock();
 }
 
+CommandQueueMT::Stats CommandQueueMT::get_total_stats() {
+	Stats stats;
+	stats.commands = total_commands.get();
+	stats.bytes = total_bytes.get();
+	stats.producer_stalls = total_producer_stalls.get();
+	return stats;
+}
+
+CommandQueueMT::Chunk *CommandQueueMT::_alloc_chunk(uint32_t p_min_size) {
+	// Called with grow_mutex held, or before the queue is shared.
+	Chunk **prev = &free_chunks;
+	for (Chunk *chunk = free_chunks; chunk; chunk = chunk->free_next) {
+		if (chunk->capacity >= p_min_size) {
+			*prev = chunk->free_next;
+			chunk->free_next = nullptr;
+			return chunk;
+		}
+		prev = &chunk->free_next;
+	}
+
+	uint32_t capacity = MAX(DEFAULT_COMMAND_MEM_SIZE_KB * 1024, p_min_size);
+	ERR_FAIL_COND_V(capacity > CHUNK_OFFSET_MASK, nullptr);
+	uint8_t *mem = (uint8_t *)memalloc(DATA_OFFSET + capacity);
+	CRASH_COND_MSG(!mem, "Out of memory");
+	Chunk *chunk = memnew_placement(mem, Chunk);
+	chunk->state.store(0, std::memory_order_relaxed);
+	chunk->next.store(nullptr, std::memory_order_relaxed);
+	chunk->capacity = capacity;
+	// Headers must read as unpublished until written.
+	memset(chunk->get_data(), 0, capacity);
+	return chunk;
+}
+
+void CommandQueueMT::_grow(Chunk *p_full_chunk, uint32_t p_min_size) {
+	MutexLock lock(grow_mutex);
+	if (write_chunk.load(std::memory_order_acquire) != p_full_chunk) {
+		// Another producer got here first.
+		return;
+	}
+
+	Chunk *chunk = _alloc_chunk(p_min_size);
+	CRASH_COND(!chunk);
+	// Link before closing, so once the consumer sees the chunk closed it can always move on.
+	p_full_chunk->next.store(chunk, std::memory_order_release);
+	p_full_chunk->state.fetch_or(CHUNK_CLOSED_BIT, std::memory_order_acq_rel);
+	write_chunk.store(chunk, std::memory_order_release);
+
+	total_producer_stalls.increment();
+}
+
+void CommandQueueMT::_flush() {
+	if (unlikely(flushing)) {
+		// Re-entrant call.
+		return;
+	}
+
+	lock();
+	flushing = true;
+	// Producers from now on must wake the pump up again.
+	pump_notified.store(false);
+	// Pairs with the fence in commit(), so the commands published before it was reset are seen below.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	uint64_t commands = 0;
+	uint64_t bytes = 0;
+
+	uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(&mutex);
+	while (true) {
+		uint64_t state = read_chunk->state.load(std::memory_order_acquire);
+
+		if (read_offset < (state & CHUNK_OFFSET_MASK)) {
+			CommandHeader *header = reinterpret_cast<CommandHeader *>(read_chunk->get_data() + read_offset);
+			uint32_t size = header->size.load(std::memory_order_acquire);
+			while (unlikely(size == 0)) {
+				// Reserved, but the producer is still writing it.
+				OS::get_singleton()->yield();
+				size = header->size.load(std::memory_order_acquire);
+			}
+
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(reinterpret_cast<uint8_t *>(header) + sizeof(CommandHeader));
+			cmd->call();
+
+			if (unlikely(cmd->sync)) {
+				{
+					MutexLock sync_lock(sync_mutex);
+					*static_cast<SyncCommand *>(cmd)->done = true;
+				}
+				sync_cond_var.notify_all();
+			}
+
+			cmd->~CommandBase();
+
+			read_offset += size;
+			commands++;
+			bytes += size;
+			continue;
+		}
+
+		if (!(state & CHUNK_CLOSED_BIT)) {
+			break;
+		}
+
+		// Fully drained and closed, so no producer can write here anymore.
+		Chunk *drained = read_chunk;
+		read_chunk = drained->next.load(std::memory_order_acquire);
+		read_offset = 0;
+
+		// Headers of the next generation may land anywhere in the used area, so it must read as unpublished.
+		memset(drained->get_data(), 0, state & CHUNK_OFFSET_MASK);
+
+		MutexLock grow_lock(grow_mutex);
+		// Bumping the generation invalidates any state a stale producer may still hold.
+		drained->state.store(((state & ~(CHUNK_OFFSET_MASK | CHUNK_CLOSED_BIT)) + CHUNK_GENERATION_ONE), std::memory_order_release);
+		drained->next.store(nullptr, std::memory_order_relaxed);
+		drained->free_next = free_chunks;
+		free_chunks = drained;
+	}
+	WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+
+	if (commands) {
+		total_commands.add(commands);
+		total_bytes.add(bytes);
+	}
+
+	flushing = false;
+	unlock();
+}
+
 CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	Chunk *chunk = _alloc_chunk(0);
+	read_chunk = chunk;
+	write_chunk.store(chunk, std::memory_order_release);
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	Chunk *chunk = read_chunk;
+	while (chunk) {
+		Chunk *next = chunk->next.load(std::memory_order_relaxed);
+		chunk->~Chunk();
+		memfree(chunk);
+		chunk = next;
+	}
+	chunk = free_chunks;
+	while (chunk) {
+		Chunk *next = chunk->free_next;
+		chunk->~Chunk();
+		memfree(chunk);
+		chunk = next;
+	}
 }
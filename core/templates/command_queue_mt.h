@@ -36,10 +36,12 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/string/print_string.h"
-#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -248,17 +250,14 @@
 #define CMD_TYPE(N) Command##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
 #define CMD_ASSIGN_PARAM(N) cmd->p##N = p##N
 
-#define DECL_PUSH(N)                                                            \
-	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>    \
-	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) {    \
-		MutexLock mlock(mutex);                                                 \
-		CMD_TYPE(N) *cmd = allocate<CMD_TYPE(N)>();                             \
-		cmd->instance = p_instance;                                             \
-		cmd->method = p_method;                                                 \
-		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                    \
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {                \
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id); \
-		}                                                                       \
+#define DECL_PUSH(N)                                                         \
+	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)> \
+	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		CMD_TYPE(N) *cmd = allocate<CMD_TYPE(N)>();                          \
+		cmd->instance = p_instance;                                          \
+		cmd->method = p_method;                                              \
+		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
+		commit(cmd);                                                         \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -266,17 +265,15 @@
 #define DECL_PUSH_AND_RET(N)                                                                   \
 	template <typename T, typename M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) typename R>       \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
-		MutexLock mlock(mutex);                                                                \
+		bool done = false;                                                                     \
 		CMD_RET_TYPE(N) *cmd = allocate<CMD_RET_TYPE(N)>();                                    \
 		cmd->instance = p_instance;                                                            \
 		cmd->method = p_method;                                                                \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {                               \
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);                \
-		}                                                                                      \
-		sync_tail++;                                                                           \
-		_wait_for_sync(mlock);                                                                 \
+		cmd->done = &done;                                                                     \
+		commit(cmd);                                                                           \
+		_wait_for_sync(done);                                                                  \
 	}
 
 #define CMD_SYNC_TYPE(N) CommandSync##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
@@ -284,20 +281,24 @@
 #define DECL_PUSH_AND_SYNC(N)                                                         \
 	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>          \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
-		MutexLock mlock(mutex);                                                       \
+		bool done = false;                                                            \
 		CMD_SYNC_TYPE(N) *cmd = allocate<CMD_SYNC_TYPE(N)>();                         \
 		cmd->instance = p_instance;                                                   \
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {                      \
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);       \
-		}                                                                             \
-		sync_tail++;                                                                  \
-		_wait_for_sync(mlock);                                                        \
+		cmd->done = &done;                                                            \
+		commit(cmd);                                                                  \
+		_wait_for_sync(done);                                                         \
 	}
 
 #define MAX_CMD_PARAMS 15
 
+// Multiple-producer, single-consumer command queue.
+// Producers reserve space in the current chunk with a CAS on its state and never lock,
+// except to link a new chunk when the current one is full (counted as a producer stall).
+// A command becomes visible to the consumer once its header is published by commit().
+// The consumer recycles fully drained chunks, so stale producers are fenced off by
+// a generation counter stored next to the reserved offset.
 class CommandQueueMT {
 	struct CommandBase {
 		bool sync = false;
@@ -306,6 +307,7 @@ class CommandQueueMT {
 	};
 
 	struct SyncCommand : public CommandBase {
+		bool *done = nullptr;
 		virtual void call() override {}
 		SyncCommand() {
 			sync = true;
@@ -327,89 +329,117 @@ class CommandQueueMT {
 
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
 
+	struct CommandHeader {
+		std::atomic<uint32_t> size; // Zero until the command is fully written.
+		uint32_t padding;
+	};
+	static_assert(sizeof(CommandHeader) == 8);
+
+	static const uint64_t CHUNK_OFFSET_MASK = 0x7FFFFFFF;
+	static const uint64_t CHUNK_CLOSED_BIT = 0x80000000;
+	static const uint64_t CHUNK_GENERATION_ONE = uint64_t(1) << 32;
+
+	struct Chunk {
+		// Generation in the high 32 bits, closed flag and reserved bytes in the low 32.
+		std::atomic<uint64_t> state;
+		// Set before the chunk is closed, so the consumer can always follow it.
+		std::atomic<Chunk *> next;
+		Chunk *free_next = nullptr;
+		uint32_t capacity = 0;
+
+		_FORCE_INLINE_ uint8_t *get_data() { return reinterpret_cast<uint8_t *>(this) + DATA_OFFSET; }
+	};
+	static const uint32_t DATA_OFFSET = (sizeof(Chunk) + 15) & ~15;
+
+	// Producer side.
+	std::atomic<Chunk *> write_chunk;
+	BinaryMutex grow_mutex; // Protects linking new chunks and the free list.
+	Chunk *free_chunks = nullptr;
+
+	// Consumer side, protected by mutex.
 	BinaryMutex mutex;
-	LocalVector<uint8_t> command_mem;
+	Chunk *read_chunk = nullptr;
+	uint32_t read_offset = 0;
+	bool flushing = false;
+
+	BinaryMutex sync_mutex;
 	ConditionVariable sync_cond_var;
-	uint32_t sync_head = 0;
-	uint32_t sync_tail = 0;
-	uint32_t sync_awaiters = 0;
+
 	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
-	uint64_t flush_read_ptr = 0;
+	std::atomic<bool> pump_notified = false;
+
+	static SafeNumeric<uint64_t> total_commands;
+	static SafeNumeric<uint64_t> total_bytes;
+	static SafeNumeric<uint64_t> total_producer_stalls;
 
 	template <typename T>
-	T *allocate() {
-		// alloc size is size+T+safeguard
-		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
-		return cmd;
+	static constexpr uint32_t _get_alloc_size() {
+		return sizeof(CommandHeader) + ((sizeof(T) + 8 - 1) & ~(8 - 1));
 	}
 
-	_FORCE_INLINE_ void _prevent_sync_wraparound() {
-		bool safe_to_reset = !sync_awaiters;
-		bool already_sync_to_latest = sync_head == sync_tail;
-		if (safe_to_reset && already_sync_to_latest) {
-			sync_head = 0;
-			sync_tail = 0;
+	template <typename T>
+	T *allocate() {
+		constexpr uint32_t alloc_size = _get_alloc_size<T>();
+		while (true) {
+			Chunk *chunk = write_chunk.load(std::memory_order_acquire);
+			uint64_t state = chunk->state.load(std::memory_order_acquire);
+			if (unlikely(write_chunk.load(std::memory_order_acquire) != chunk)) {
+				// The chunk may have been recycled since we read it.
+				continue;
+			}
+			if (likely(!(state & CHUNK_CLOSED_BIT) && (state & CHUNK_OFFSET_MASK) + alloc_size <= chunk->capacity)) {
+				if (chunk->state.compare_exchange_weak(state, state + alloc_size, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					T *cmd = memnew_placement(chunk->get_data() + (state & CHUNK_OFFSET_MASK) + sizeof(CommandHeader), T);
+					return cmd;
+				}
+			} else {
+				_grow(chunk, alloc_size);
+			}
 		}
 	}
 
-	void _flush() {
-		if (unlikely(flush_read_ptr)) {
-			// Re-entrant call.
-			return;
-		}
-
-		lock();
-
-		uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(&mutex);
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			cmd->call();
-
-			// Handle potential realloc due to the command and unlock allowance.
-			cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-
-			if (unlikely(cmd->sync)) {
-				sync_head++;
-				unlock(); // Give an opportunity to awaiters right away.
-				sync_cond_var.notify_all();
-				lock();
-				// Handle potential realloc happened during unlock.
-				cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
+	template <typename T>
+	_FORCE_INLINE_ void commit(T *p_cmd) {
+		CommandHeader *header = reinterpret_cast<CommandHeader *>(reinterpret_cast<uint8_t *>(p_cmd) - sizeof(CommandHeader));
+		header->size.store(_get_alloc_size<T>(), std::memory_order_release);
+		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			// Pairs with the fence in _flush(): either the pump sees this command, or we see it must be woken up.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			// Only the first producer since the pump last started flushing needs to wake it up.
+			if (!pump_notified.load() && !pump_notified.exchange(true)) {
+				WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);
 			}
-
-			cmd->~CommandBase();
-
-			flush_read_ptr += size;
 		}
-		WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
-
-		command_mem.clear();
-		flush_read_ptr = 0;
+	}
 
-		_prevent_sync_wraparound();
+	void _grow(Chunk *p_full_chunk, uint32_t p_min_size);
+	Chunk *_alloc_chunk(uint32_t p_min_size);
+	void _flush();
 
-		unlock();
+	_FORCE_INLINE_ bool _has_pending() const {
+		Chunk *chunk = write_chunk.load(std::memory_order_acquire);
+		return chunk != read_chunk || (chunk->state.load(std::memory_order_acquire) & CHUNK_OFFSET_MASK) != read_offset;
 	}
 
-	_FORCE_INLINE_ void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
-		sync_awaiters++;
-		uint32_t sync_head_goal = sync_tail;
-		do {
-			sync_cond_var.wait(p_lock);
-		} while (sync_head < sync_head_goal);
-		sync_awaiters--;
-		_prevent_sync_wraparound();
+	_FORCE_INLINE_ void _wait_for_sync(bool &p_done) {
+		MutexLock lock(sync_mutex);
+		while (!p_done) {
+			sync_cond_var.wait(lock);
+		}
 	}
 
 	void _no_op() {}
 
 public:
+	struct Stats {
+		uint64_t commands = 0;
+		uint64_t bytes = 0;
+		uint64_t producer_stalls = 0;
+	};
+
+	// Accumulated over all queues since startup.
+	static Stats get_total_stats();
+
 	void lock();
 	void unlock();
 
@@ -426,7 +456,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(_has_pending())) {
 			_flush();
 		}
 	}
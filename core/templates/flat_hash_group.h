@@ -0,0 +1,219 @@
+/**************************************************************************/
+/*  flat_hash_group.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_GROUP_H
+#define FLAT_HASH_GROUP_H
+
+#include "core/typedefs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_GROUP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define FLAT_HASH_GROUP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * Control byte group shared by FlatHashMap and FlatHashSet.
+ *
+ * Every slot of a flat hash table has one control byte. A slot is either
+ * empty, deleted (a tombstone) or full, in which case the control byte holds
+ * the 7 lowest bits of the key hash (H2). Control bytes are scanned 16 at a
+ * time, so a single SSE2 or NEON compare finds every candidate slot of a group
+ * before any key is touched. A portable scalar path is used on other CPUs.
+ *
+ * Match results are returned as a bit mask where each slot owns `1 << SHIFT`
+ * bits; use `lowest()` and `next()` to walk the matching slots.
+ */
+struct FlatHashGroup {
+	static constexpr uint32_t WIDTH = 16;
+
+	static constexpr int8_t CTRL_EMPTY = -128; // 0b10000000
+	static constexpr int8_t CTRL_DELETED = -2; // 0b11111110
+
+#ifdef FLAT_HASH_GROUP_NEON
+	// NEON has no movemask, so narrow the compare result to 4 bits per slot.
+	typedef uint64_t Mask;
+	static constexpr uint32_t SHIFT = 2;
+#else
+	typedef uint32_t Mask;
+	static constexpr uint32_t SHIFT = 0;
+#endif
+
+	static _FORCE_INLINE_ uint32_t lowest(Mask p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		if constexpr (sizeof(Mask) == 8) {
+			return uint32_t(__builtin_ctzll(p_mask)) >> SHIFT;
+		} else {
+			return uint32_t(__builtin_ctz(p_mask)) >> SHIFT;
+		}
+#elif defined(_MSC_VER)
+		unsigned long index;
+		if constexpr (sizeof(Mask) == 8) {
+			_BitScanForward64(&index, p_mask);
+		} else {
+			_BitScanForward(&index, p_mask);
+		}
+		return uint32_t(index) >> SHIFT;
+#else
+		uint32_t index = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			index++;
+		}
+		return index >> SHIFT;
+#endif
+	}
+
+	static _FORCE_INLINE_ Mask next(Mask p_mask) {
+		return p_mask & (p_mask - 1);
+	}
+
+	static _FORCE_INLINE_ bool is_full(int8_t p_ctrl) {
+		return p_ctrl >= 0;
+	}
+
+#if defined(FLAT_HASH_GROUP_SSE2)
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit FlatHashGroup(const int8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(p_h2))));
+	}
+
+	_FORCE_INLINE_ Mask match_empty() const {
+		return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(CTRL_EMPTY))));
+	}
+
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		// Both special values have the sign bit set, full slots don't.
+		return uint32_t(_mm_movemask_epi8(ctrl));
+	}
+
+	_FORCE_INLINE_ Mask match_full() const {
+		return match_empty_or_deleted() ^ 0xFFFF;
+	}
+
+#elif defined(FLAT_HASH_GROUP_NEON)
+	int8x16_t ctrl;
+
+	static _FORCE_INLINE_ Mask _to_mask(uint8x16_t p_cmp) {
+		const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4);
+		return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL;
+	}
+
+	_FORCE_INLINE_ explicit FlatHashGroup(const int8_t *p_ctrl) {
+		ctrl = vld1q_s8(p_ctrl);
+	}
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		return _to_mask(vceqq_s8(ctrl, vdupq_n_s8(p_h2)));
+	}
+
+	_FORCE_INLINE_ Mask match_empty() const {
+		return _to_mask(vceqq_s8(ctrl, vdupq_n_s8(CTRL_EMPTY)));
+	}
+
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		return _to_mask(vcltq_s8(ctrl, vdupq_n_s8(0)));
+	}
+
+	_FORCE_INLINE_ Mask match_full() const {
+		return _to_mask(vcgeq_s8(ctrl, vdupq_n_s8(0)));
+	}
+
+#else
+	const int8_t *ctrl;
+
+	_FORCE_INLINE_ explicit FlatHashGroup(const int8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		Mask mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= Mask(ctrl[i] == p_h2) << i;
+		}
+		return mask;
+	}
+
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		Mask mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= Mask(ctrl[i] < 0) << i;
+		}
+		return mask;
+	}
+
+	_FORCE_INLINE_ Mask match_full() const {
+		return match_empty_or_deleted() ^ 0xFFFF;
+	}
+#endif
+
+	// Splits a hash into the probe start (H1) and the control byte (H2). The
+	// hash is mixed first, since some hashers have weak low bits.
+	static _FORCE_INLINE_ uint32_t mix(uint32_t p_hash) {
+		p_hash ^= p_hash >> 16;
+		p_hash *= 0x85ebca6b;
+		p_hash ^= p_hash >> 13;
+		return p_hash;
+	}
+	static _FORCE_INLINE_ uint32_t h1(uint32_t p_hash) { return p_hash >> 7; }
+	static _FORCE_INLINE_ int8_t h2(uint32_t p_hash) { return int8_t(p_hash & 0x7F); }
+
+	// Capacity is always a power of two and a multiple of WIDTH. Up to 7/8 of
+	// the slots may be used (full or deleted), so every probe sequence ends on
+	// a group with an empty slot.
+	static _FORCE_INLINE_ uint32_t max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	static _FORCE_INLINE_ uint32_t capacity_for(uint32_t p_elements) {
+		uint32_t capacity = WIDTH;
+		while (max_load(capacity) < p_elements) {
+			capacity <<= 1;
+		}
+		return capacity;
+	}
+};
+
+#endif // FLAT_HASH_GROUP_H
@@ -0,0 +1,513 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/flat_hash_group.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+/**
+ * A HashMap variant that stores keys and values inline in a single open
+ * addressed array, in the style of a Swiss table. A separate array of control
+ * bytes (see FlatHashGroup) is probed 16 slots at a time with SIMD compares,
+ * and only slots whose 7-bit hash tag matches have their keys compared.
+ *
+ * Compared to HashMap:
+ * - Lookups touch far fewer cache lines, since there is no per-element
+ *   allocation and no linked list.
+ * - Iteration order is unspecified and changes when the table grows. There is
+ *   no insertion order, no sort(), and insert() has no front insert option.
+ * - Growing the table moves elements, so pointers and iterators are
+ *   invalidated by any insertion. Erasing never moves other elements.
+ * - Erased slots become tombstones that are reclaimed on the next rehash.
+ *
+ * Only used slots are constructed, free slots are kept uninitialized.
+ *
+ * The assignment operator copy the pairs from one map to the other.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class FlatHashMap {
+public:
+	static constexpr uint32_t MIN_CAPACITY = FlatHashGroup::WIDTH;
+
+private:
+	typedef KeyValue<TKey, TValue> Slot;
+
+	int8_t *ctrl = nullptr;
+	Slot *slots = nullptr;
+
+	uint32_t capacity = 0;
+	uint32_t num_elements = 0;
+	uint32_t num_deleted = 0;
+
+	static _FORCE_INLINE_ uint32_t _hash(const TKey &p_key) {
+		return FlatHashGroup::mix(Hasher::hash(p_key));
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false; // Failed lookups, no elements.
+		}
+
+		const uint32_t hash = _hash(p_key);
+		const int8_t h2 = FlatHashGroup::h2(hash);
+		const uint32_t group_mask = (capacity / FlatHashGroup::WIDTH) - 1;
+		uint32_t group_index = FlatHashGroup::h1(hash) & group_mask;
+
+		// Triangular probing visits every group once for power of two sizes.
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group_index * FlatHashGroup::WIDTH;
+			const FlatHashGroup group(ctrl + base);
+
+			for (FlatHashGroup::Mask match = group.match(h2); match; match = FlatHashGroup::next(match)) {
+				const uint32_t pos = base + FlatHashGroup::lowest(match);
+				if (likely(Comparator::compare(slots[pos].key, p_key))) {
+					r_pos = pos;
+					return true;
+				}
+			}
+
+			if (likely(group.match_empty())) {
+				return false;
+			}
+
+			group_index = (group_index + step) & group_mask;
+		}
+	}
+
+	// Returns the first empty or deleted slot in the probe sequence of p_hash.
+	uint32_t _find_free_pos(uint32_t p_hash) const {
+		const uint32_t group_mask = (capacity / FlatHashGroup::WIDTH) - 1;
+		uint32_t group_index = FlatHashGroup::h1(p_hash) & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group_index * FlatHashGroup::WIDTH;
+			const FlatHashGroup::Mask free = FlatHashGroup(ctrl + base).match_empty_or_deleted();
+			if (likely(free)) {
+				return base + FlatHashGroup::lowest(free);
+			}
+			group_index = (group_index + step) & group_mask;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		int8_t *old_ctrl = ctrl;
+		Slot *old_slots = slots;
+		const uint32_t old_capacity = capacity;
+
+		capacity = p_new_capacity;
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * capacity));
+		slots = reinterpret_cast<Slot *>(Memory::alloc_static(sizeof(Slot) * capacity));
+		memset(ctrl, FlatHashGroup::CTRL_EMPTY, sizeof(int8_t) * capacity);
+		num_deleted = 0;
+
+		if (old_ctrl == nullptr) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (!FlatHashGroup::is_full(old_ctrl[i])) {
+				continue;
+			}
+			const uint32_t hash = _hash(old_slots[i].key);
+			const uint32_t pos = _find_free_pos(hash);
+			ctrl[pos] = FlatHashGroup::h2(hash);
+			memnew_placement(&slots[pos], Slot(old_slots[i]));
+			old_slots[i].~Slot();
+		}
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_slots);
+	}
+
+	uint32_t _insert(const TKey &p_key, const TValue &p_value, bool &r_existed) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			r_existed = true;
+			return pos;
+		}
+		r_existed = false;
+
+		if (unlikely(ctrl == nullptr)) {
+			_resize_and_rehash(MIN_CAPACITY);
+		} else if (num_elements + num_deleted >= FlatHashGroup::max_load(capacity)) {
+			// Grow, unless enough tombstones can be reclaimed at the current size.
+			_resize_and_rehash(num_deleted >= capacity / 4 ? capacity : capacity * 2);
+		}
+
+		const uint32_t hash = _hash(p_key);
+		pos = _find_free_pos(hash);
+		if (ctrl[pos] == FlatHashGroup::CTRL_DELETED) {
+			num_deleted--;
+		}
+		ctrl[pos] = FlatHashGroup::h2(hash);
+		memnew_placement(&slots[pos], Slot(p_key, p_value));
+		num_elements++;
+		return pos;
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		// A group that still has an empty slot never stopped a probe sequence
+		// from ending there, so the slot can go straight back to empty.
+		const uint32_t base = p_pos & ~(FlatHashGroup::WIDTH - 1);
+		if (FlatHashGroup(ctrl + base).match_empty()) {
+			ctrl[p_pos] = FlatHashGroup::CTRL_EMPTY;
+		} else {
+			ctrl[p_pos] = FlatHashGroup::CTRL_DELETED;
+			num_deleted++;
+		}
+		slots[p_pos].~Slot();
+		num_elements--;
+	}
+
+	_FORCE_INLINE_ uint32_t _next_full(uint32_t p_pos) const {
+		while (p_pos < capacity && !FlatHashGroup::is_full(ctrl[p_pos])) {
+			p_pos++;
+		}
+		return p_pos;
+	}
+
+	_FORCE_INLINE_ uint32_t _prev_full(uint32_t p_pos) const {
+		while (p_pos > 0) {
+			p_pos--;
+			if (FlatHashGroup::is_full(ctrl[p_pos])) {
+				return p_pos;
+			}
+		}
+		return capacity;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr || num_elements + num_deleted == 0) {
+			return;
+		}
+		if constexpr (!std::is_trivially_destructible_v<Slot>) {
+			for (uint32_t i = 0; i < capacity; i++) {
+				if (FlatHashGroup::is_full(ctrl[i])) {
+					slots[i].~Slot();
+				}
+			}
+		}
+		memset(ctrl, FlatHashGroup::CTRL_EMPTY, sizeof(int8_t) * capacity);
+		num_elements = 0;
+		num_deleted = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		const uint32_t new_capacity = FlatHashGroup::capacity_for(p_new_capacity);
+		if (new_capacity <= capacity) {
+			return;
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return map->slots[pos];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &map->slots[pos]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (map && pos < map->capacity) {
+				pos = map->_next_full(pos + 1);
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			if (map && pos < map->capacity) {
+				pos = map->_prev_full(pos);
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return _is_end() ? b._is_end() : (map == b.map && pos == b.pos); }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return !(*this == b); }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return !_is_end();
+		}
+
+		_FORCE_INLINE_ ConstIterator(const FlatHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			map = p_it.map;
+			pos = p_it.pos;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			map = p_it.map;
+			pos = p_it.pos;
+		}
+
+	private:
+		_FORCE_INLINE_ bool _is_end() const { return map == nullptr || pos >= map->capacity; }
+
+		const FlatHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return map->slots[pos];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &map->slots[pos]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (map && pos < map->capacity) {
+				pos = map->_next_full(pos + 1);
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			if (map && pos < map->capacity) {
+				pos = map->_prev_full(pos);
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return _is_end() ? b._is_end() : (map == b.map && pos == b.pos); }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return !(*this == b); }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return !_is_end();
+		}
+
+		_FORCE_INLINE_ Iterator(FlatHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			map = p_it.map;
+			pos = p_it.pos;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			map = p_it.map;
+			pos = p_it.pos;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, pos);
+		}
+
+	private:
+		friend class FlatHashMap;
+
+		_FORCE_INLINE_ bool _is_end() const { return map == nullptr || pos >= map->capacity; }
+
+		FlatHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, _next_full(0));
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, capacity);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		return Iterator(this, _prev_full(capacity));
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(this, pos);
+	}
+
+	// Erasing doesn't move other elements, so iteration can continue from p_iter.
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter && p_iter.map == this) {
+			_erase_pos(p_iter.pos);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, _next_full(0));
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, capacity);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		return ConstIterator(this, _prev_full(capacity));
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(this, pos);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return slots[pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		bool existed = false;
+		return slots[_insert(p_key, TValue(), existed)].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		bool existed = false;
+		const uint32_t pos = _insert(p_key, p_value, existed);
+		if (existed) {
+			slots[pos].value = p_value;
+		}
+		return Iterator(this, pos);
+	}
+
+	/* Constructors */
+
+	FlatHashMap(const FlatHashMap &p_other) {
+		if (p_other.num_elements == 0) {
+			return;
+		}
+
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		if (num_elements != 0) {
+			clear();
+		}
+
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	FlatHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashMap() {}
+
+	~FlatHashMap() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+		}
+	}
+};
+
+#endif // FLAT_HASH_MAP_H
@@ -0,0 +1,388 @@
+/**************************************************************************/
+/*  flat_hash_set.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_SET_H
+#define FLAT_HASH_SET_H
+
+#include "core/os/memory.h"
+#include "core/templates/flat_hash_group.h"
+#include "core/templates/hashfuncs.h"
+
+/**
+ * A HashSet variant using the same SIMD probed, open addressed layout as
+ * FlatHashMap. Keys are stored inline next to a control byte array.
+ *
+ * Iteration order is unspecified, and insertions may move keys and invalidate
+ * iterators. Erasing never moves other keys.
+ *
+ * The assignment operator copy the keys from one set to the other.
+ */
+
+template <typename TKey,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class FlatHashSet {
+public:
+	static constexpr uint32_t MIN_CAPACITY = FlatHashGroup::WIDTH;
+
+private:
+	int8_t *ctrl = nullptr;
+	TKey *keys = nullptr;
+
+	uint32_t capacity = 0;
+	uint32_t num_elements = 0;
+	uint32_t num_deleted = 0;
+
+	static _FORCE_INLINE_ uint32_t _hash(const TKey &p_key) {
+		return FlatHashGroup::mix(Hasher::hash(p_key));
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false; // Failed lookups, no elements.
+		}
+
+		const uint32_t hash = _hash(p_key);
+		const int8_t h2 = FlatHashGroup::h2(hash);
+		const uint32_t group_mask = (capacity / FlatHashGroup::WIDTH) - 1;
+		uint32_t group_index = FlatHashGroup::h1(hash) & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group_index * FlatHashGroup::WIDTH;
+			const FlatHashGroup group(ctrl + base);
+
+			for (FlatHashGroup::Mask match = group.match(h2); match; match = FlatHashGroup::next(match)) {
+				const uint32_t pos = base + FlatHashGroup::lowest(match);
+				if (likely(Comparator::compare(keys[pos], p_key))) {
+					r_pos = pos;
+					return true;
+				}
+			}
+
+			if (likely(group.match_empty())) {
+				return false;
+			}
+
+			group_index = (group_index + step) & group_mask;
+		}
+	}
+
+	uint32_t _find_free_pos(uint32_t p_hash) const {
+		const uint32_t group_mask = (capacity / FlatHashGroup::WIDTH) - 1;
+		uint32_t group_index = FlatHashGroup::h1(p_hash) & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group_index * FlatHashGroup::WIDTH;
+			const FlatHashGroup::Mask free = FlatHashGroup(ctrl + base).match_empty_or_deleted();
+			if (likely(free)) {
+				return base + FlatHashGroup::lowest(free);
+			}
+			group_index = (group_index + step) & group_mask;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		int8_t *old_ctrl = ctrl;
+		TKey *old_keys = keys;
+		const uint32_t old_capacity = capacity;
+
+		capacity = p_new_capacity;
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * capacity));
+		keys = reinterpret_cast<TKey *>(Memory::alloc_static(sizeof(TKey) * capacity));
+		memset(ctrl, FlatHashGroup::CTRL_EMPTY, sizeof(int8_t) * capacity);
+		num_deleted = 0;
+
+		if (old_ctrl == nullptr) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (!FlatHashGroup::is_full(old_ctrl[i])) {
+				continue;
+			}
+			const uint32_t hash = _hash(old_keys[i]);
+			const uint32_t pos = _find_free_pos(hash);
+			ctrl[pos] = FlatHashGroup::h2(hash);
+			memnew_placement(&keys[pos], TKey(old_keys[i]));
+			old_keys[i].~TKey();
+		}
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_keys);
+	}
+
+	uint32_t _insert(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return pos;
+		}
+
+		if (unlikely(ctrl == nullptr)) {
+			_resize_and_rehash(MIN_CAPACITY);
+		} else if (num_elements + num_deleted >= FlatHashGroup::max_load(capacity)) {
+			// Grow, unless enough tombstones can be reclaimed at the current size.
+			_resize_and_rehash(num_deleted >= capacity / 4 ? capacity : capacity * 2);
+		}
+
+		const uint32_t hash = _hash(p_key);
+		pos = _find_free_pos(hash);
+		if (ctrl[pos] == FlatHashGroup::CTRL_DELETED) {
+			num_deleted--;
+		}
+		ctrl[pos] = FlatHashGroup::h2(hash);
+		memnew_placement(&keys[pos], TKey(p_key));
+		num_elements++;
+		return pos;
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		// See FlatHashMap::_erase_pos().
+		const uint32_t base = p_pos & ~(FlatHashGroup::WIDTH - 1);
+		if (FlatHashGroup(ctrl + base).match_empty()) {
+			ctrl[p_pos] = FlatHashGroup::CTRL_EMPTY;
+		} else {
+			ctrl[p_pos] = FlatHashGroup::CTRL_DELETED;
+			num_deleted++;
+		}
+		keys[p_pos].~TKey();
+		num_elements--;
+	}
+
+	_FORCE_INLINE_ uint32_t _next_full(uint32_t p_pos) const {
+		while (p_pos < capacity && !FlatHashGroup::is_full(ctrl[p_pos])) {
+			p_pos++;
+		}
+		return p_pos;
+	}
+
+	_FORCE_INLINE_ uint32_t _prev_full(uint32_t p_pos) const {
+		while (p_pos > 0) {
+			p_pos--;
+			if (FlatHashGroup::is_full(ctrl[p_pos])) {
+				return p_pos;
+			}
+		}
+		return capacity;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr || num_elements + num_deleted == 0) {
+			return;
+		}
+		if constexpr (!std::is_trivially_destructible_v<TKey>) {
+			for (uint32_t i = 0; i < capacity; i++) {
+				if (FlatHashGroup::is_full(ctrl[i])) {
+					keys[i].~TKey();
+				}
+			}
+		}
+		memset(ctrl, FlatHashGroup::CTRL_EMPTY, sizeof(int8_t) * capacity);
+		num_elements = 0;
+		num_deleted = 0;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		const uint32_t new_capacity = FlatHashGroup::capacity_for(p_new_capacity);
+		if (new_capacity <= capacity) {
+			return;
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct Iterator {
+		_FORCE_INLINE_ const TKey &operator*() const {
+			return set->keys[pos];
+		}
+		_FORCE_INLINE_ const TKey *operator->() const {
+			return &set->keys[pos];
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (set && pos < set->capacity) {
+				pos = set->_next_full(pos + 1);
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			if (set && pos < set->capacity) {
+				pos = set->_prev_full(pos);
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return _is_end() ? b._is_end() : (set == b.set && pos == b.pos); }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return !(*this == b); }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return !_is_end();
+		}
+
+		_FORCE_INLINE_ Iterator(const FlatHashSet *p_set, uint32_t p_pos) {
+			set = p_set;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			set = p_it.set;
+			pos = p_it.pos;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			set = p_it.set;
+			pos = p_it.pos;
+		}
+
+	private:
+		friend class FlatHashSet;
+
+		_FORCE_INLINE_ bool _is_end() const { return set == nullptr || pos >= set->capacity; }
+
+		const FlatHashSet *set = nullptr;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() const {
+		return Iterator(this, _next_full(0));
+	}
+	_FORCE_INLINE_ Iterator end() const {
+		return Iterator(this, capacity);
+	}
+	_FORCE_INLINE_ Iterator last() const {
+		return Iterator(this, _prev_full(capacity));
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(this, pos);
+	}
+
+	// Erasing doesn't move other keys, so iteration can continue from p_iter.
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter && p_iter.set == this) {
+			_erase_pos(p_iter.pos);
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key) {
+		uint32_t pos = _insert(p_key);
+		return Iterator(this, pos);
+	}
+
+	/* Constructors */
+
+	FlatHashSet(const FlatHashSet &p_other) {
+		if (p_other.num_elements == 0) {
+			return;
+		}
+
+		reserve(p_other.num_elements);
+
+		for (const TKey &E : p_other) {
+			insert(E);
+		}
+	}
+
+	void operator=(const FlatHashSet &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		if (num_elements != 0) {
+			clear();
+		}
+
+		reserve(p_other.num_elements);
+
+		for (const TKey &E : p_other) {
+			insert(E);
+		}
+	}
+
+	FlatHashSet(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashSet() {}
+
+	void reset() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(keys);
+			ctrl = nullptr;
+			keys = nullptr;
+		}
+		capacity = 0;
+	}
+
+	~FlatHashSet() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(keys);
+		}
+	}
+};
+
+#endif // FLAT_HASH_SET_H
@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -44,6 +45,10 @@
 void FileAccessUnix::check_errors() const {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped_data) {
+		// Reads from the mapping set the EOF error themselves, the stdio state is stale.
+		return;
+	}
 	if (feof(f)) {
 		last_error = ERR_FILE_EOF;
 	}
@@ -142,6 +147,14 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped_data) {
+		munmap(mapped_data, mapped_length);
+		mapped_data = nullptr;
+		mapped_length = 0;
+		mapped_pos = 0;
+	}
+	map_failed = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -177,6 +190,10 @@ void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
 	last_error = OK;
+	if (mapped_data) {
+		mapped_pos = p_position;
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -185,6 +202,10 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped_data) {
+		mapped_pos = mapped_length + p_position;
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -193,6 +214,9 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped_data) {
+		return mapped_pos;
+	}
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -204,6 +228,9 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped_data) {
+		return mapped_length;
+	}
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -221,7 +248,7 @@ bool FileAccessUnix::eof_reached() const {
 uint8_t FileAccessUnix::get_8() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 	uint8_t b;
-	if (fread(&b, 1, 1, f) == 0) {
+	if (_read(&b, 1) == 0) {
 		check_errors();
 		b = '\0';
 	}
@@ -232,7 +259,7 @@ uint16_t FileAccessUnix::get_16() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
 	uint16_t b = 0;
-	if (fread(&b, 1, 2, f) != 2) {
+	if (_read(&b, 2) != 2) {
 		check_errors();
 	}
 
@@ -247,7 +274,7 @@ uint32_t FileAccessUnix::get_32() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
 	uint32_t b = 0;
-	if (fread(&b, 1, 4, f) != 4) {
+	if (_read(&b, 4) != 4) {
 		check_errors();
 	}
 
@@ -262,7 +289,7 @@ uint64_t FileAccessUnix::get_64() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
 	uint64_t b = 0;
-	if (fread(&b, 1, 8, f) != 8) {
+	if (_read(&b, 8) != 8) {
 		check_errors();
 	}
 
@@ -277,11 +304,71 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
 
-	uint64_t read = fread(p_dst, 1, p_length, f);
+	uint64_t read = _read(p_dst, p_length);
 	check_errors();
 	return read;
 }
 
+bool FileAccessUnix::_map() const {
+	// Only files opened for reading are mapped, so the view can't go stale.
+	if (map_failed || flags != READ || !is_memory_mapping_enabled()) {
+		return false;
+	}
+	map_failed = true;
+
+	int fd = fileno(f);
+	struct stat st = {};
+	if (fd == -1 || fstat(fd, &st) != 0 || st.st_size <= 0 || (uint64_t)st.st_size > (uint64_t)SIZE_MAX) {
+		return false;
+	}
+
+	void *data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+
+	int64_t pos = ftello(f);
+	if (pos < 0) {
+		munmap(data, (size_t)st.st_size);
+		return false;
+	}
+
+	// From now on reads are served from the mapping instead of stdio.
+	clearerr(f);
+	mapped_data = (uint8_t *)data;
+	mapped_length = st.st_size;
+	mapped_pos = pos;
+	map_failed = false;
+	return true;
+}
+
+uint64_t FileAccessUnix::_read(void *p_dst, uint64_t p_length) const {
+	if (!mapped_data) {
+		return fread(p_dst, 1, p_length, f);
+	}
+
+	const uint64_t available = mapped_pos < mapped_length ? mapped_length - mapped_pos : 0;
+	const uint64_t read = MIN(p_length, available);
+	memcpy(p_dst, mapped_data + mapped_pos, read);
+	mapped_pos += read;
+	if (read < p_length) {
+		last_error = ERR_FILE_EOF;
+	}
+	return read;
+}
+
+const uint8_t *FileAccessUnix::get_mapped_span(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	if (!mapped_data && !_map()) {
+		return nullptr;
+	}
+	if (p_offset > mapped_length || p_length > mapped_length - p_offset) {
+		return nullptr;
+	}
+	return mapped_data + p_offset;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
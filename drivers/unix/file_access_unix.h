@@ -49,6 +49,15 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Read-only mapping of the whole file, created on the first get_mapped_span()
+	// call. Once mapped, all reads are served from it instead of stdio.
+	mutable uint8_t *mapped_data = nullptr;
+	mutable uint64_t mapped_length = 0;
+	mutable uint64_t mapped_pos = 0;
+	mutable bool map_failed = false;
+
+	bool _map() const;
+	uint64_t _read(void *p_dst, uint64_t p_length) const;
 	void _close();
 
 public:
@@ -72,6 +81,7 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_span(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -218,6 +218,14 @@ void FileAccessWindows::_close() {
 		return;
 	}
 
+	if (mapped_data) {
+		UnmapViewOfFile(mapped_data);
+		mapped_data = nullptr;
+		mapped_length = 0;
+		mapped_pos = 0;
+	}
+	map_failed = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -273,6 +281,10 @@ void FileAccessWindows::seek(uint64_t p_position) {
 	ERR_FAIL_NULL(f);
 
 	last_error = OK;
+	if (mapped_data) {
+		mapped_pos = p_position;
+		return;
+	}
 	if (_fseeki64(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -282,6 +294,10 @@ void FileAccessWindows::seek(uint64_t p_position) {
 void FileAccessWindows::seek_end(int64_t p_position) {
 	ERR_FAIL_NULL(f);
 
+	if (mapped_data) {
+		mapped_pos = mapped_length + p_position;
+		return;
+	}
 	if (_fseeki64(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -289,6 +305,9 @@ void FileAccessWindows::seek_end(int64_t p_position) {
 }
 
 uint64_t FileAccessWindows::get_position() const {
+	if (mapped_data) {
+		return mapped_pos;
+	}
 	int64_t aux_position = _ftelli64(f);
 	if (aux_position < 0) {
 		check_errors();
@@ -299,6 +318,9 @@ uint64_t FileAccessWindows::get_position() const {
 uint64_t FileAccessWindows::get_length() const {
 	ERR_FAIL_NULL_V(f, 0);
 
+	if (mapped_data) {
+		return mapped_length;
+	}
 	uint64_t pos = get_position();
 	_fseeki64(f, 0, SEEK_END);
 	uint64_t size = get_position();
@@ -322,7 +344,7 @@ uint8_t FileAccessWindows::get_8() const {
 		prev_op = READ;
 	}
 	uint8_t b;
-	if (fread(&b, 1, 1, f) == 0) {
+	if (_read(&b, 1) == 0) {
 		check_errors();
 		b = '\0';
 	}
@@ -341,7 +363,7 @@ uint16_t FileAccessWindows::get_16() const {
 	}
 
 	uint16_t b = 0;
-	if (fread(&b, 1, 2, f) != 2) {
+	if (_read(&b, 2) != 2) {
 		check_errors();
 	}
 
@@ -363,7 +385,7 @@ uint32_t FileAccessWindows::get_32() const {
 	}
 
 	uint32_t b = 0;
-	if (fread(&b, 1, 4, f) != 4) {
+	if (_read(&b, 4) != 4) {
 		check_errors();
 	}
 
@@ -385,7 +407,7 @@ uint64_t FileAccessWindows::get_64() const {
 	}
 
 	uint64_t b = 0;
-	if (fread(&b, 1, 8, f) != 8) {
+	if (_read(&b, 8) != 8) {
 		check_errors();
 	}
 
@@ -406,11 +428,75 @@ uint64_t FileAccessWindows::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 		}
 		prev_op = READ;
 	}
-	uint64_t read = fread(p_dst, 1, p_length, f);
+	uint64_t read = _read(p_dst, p_length);
 	check_errors();
 	return read;
 }
 
+bool FileAccessWindows::_map() const {
+	// Only files opened for reading are mapped, so the view can't go stale.
+	if (map_failed || flags != READ || !is_memory_mapping_enabled()) {
+		return false;
+	}
+	map_failed = true;
+
+	HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(f));
+	LARGE_INTEGER size;
+	if (file_handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_handle, &size) || size.QuadPart <= 0 || (uint64_t)size.QuadPart > (uint64_t)SIZE_MAX) {
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		return false;
+	}
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping); // The view keeps the mapping alive.
+	if (data == nullptr) {
+		return false;
+	}
+
+	int64_t pos = _ftelli64(f);
+	if (pos < 0) {
+		UnmapViewOfFile(data);
+		return false;
+	}
+
+	// From now on reads are served from the view instead of stdio.
+	mapped_data = (uint8_t *)data;
+	mapped_length = size.QuadPart;
+	mapped_pos = pos;
+	map_failed = false;
+	return true;
+}
+
+uint64_t FileAccessWindows::_read(void *p_dst, uint64_t p_length) const {
+	if (!mapped_data) {
+		return fread(p_dst, 1, p_length, f);
+	}
+
+	const uint64_t available = mapped_pos < mapped_length ? mapped_length - mapped_pos : 0;
+	const uint64_t read = MIN(p_length, available);
+	memcpy(p_dst, mapped_data + mapped_pos, read);
+	mapped_pos += read;
+	if (read < p_length) {
+		last_error = ERR_FILE_EOF;
+	}
+	return read;
+}
+
+const uint8_t *FileAccessWindows::get_mapped_span(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_V(f, nullptr);
+
+	if (!mapped_data && !_map()) {
+		return nullptr;
+	}
+	if (p_offset > mapped_length || p_length > mapped_length - p_offset) {
+		return nullptr;
+	}
+	return mapped_data + p_offset;
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
@@ -6648,6 +6648,8 @@ EditorNode::EditorNode() {
 	ED_SHORTCUT("particles/restart_emission", TTR("Restart Emission"), KeyModifierMask::CTRL | Key::R);
 
 	FileAccess::set_backup_save(EDITOR_GET("filesystem/on_save/safe_save_on_backup_then_rename"));
+	// Without safe save, files are rewritten in place and could be truncated under a mapping.
+	FileAccess::set_memory_mapping_enabled(FileAccess::is_backup_save_enabled());
 
 	_update_vsync_mode();
 
@@ -44,6 +44,7 @@
 #include "core/io/file_access_zip.h"
 #include "core/io/image_loader.h"
 #include "core/io/ip.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
 #include "core/os/os.h"
@@ -1840,6 +1841,11 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 #endif
 	}
 
+	if (!editor && !project_manager) {
+		// Streamed subresources stay empty for a while, the editor must never see or save them like that.
+		ResourceFormatLoaderBinary::set_stream_threshold(uint64_t(int(GLOBAL_GET("filesystem/resources/binary_stream_threshold_kb"))) * 1024);
+	}
+
 #ifdef TOOLS_ENABLED
 	if (editor) {
 		Engine::get_singleton()->set_editor_hint(true);
@@ -4248,6 +4254,7 @@ bool Main::iteration() {
 		performance->set_process_time(USEC_TO_SEC(process_max));
 		performance->set_physics_process_time(USEC_TO_SEC(physics_process_max));
 		performance->set_navigation_process_time(USEC_TO_SEC(navigation_process_max));
+		performance->update_command_queue_stats(frames);
 		process_max = 0;
 		physics_process_max = 0;
 		navigation_process_max = 0;
@@ -91,6 +91,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_COMMANDS);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_BYTES);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_PRODUCER_STALLS);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -141,6 +144,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_merged"),
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
+		PNAME("command_queue/commands"),
+		PNAME("command_queue/bytes"),
+		PNAME("command_queue/producer_stalls"),
 
 	};
 
@@ -225,6 +231,12 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case COMMAND_QUEUE_COMMANDS:
+			return _command_queue_commands;
+		case COMMAND_QUEUE_BYTES:
+			return _command_queue_bytes;
+		case COMMAND_QUEUE_PRODUCER_STALLS:
+			return _command_queue_producer_stalls;
 
 		default: {
 		}
@@ -272,6 +284,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -290,6 +305,17 @@ void Performance::set_navigation_process_time(double p_pt) {
 	_navigation_process_time = p_pt;
 }
 
+void Performance::update_command_queue_stats(uint64_t p_frames) {
+	// Averaged per frame over the period since the last update.
+	CommandQueueMT::Stats stats = CommandQueueMT::get_total_stats();
+	if (p_frames > 0) {
+		_command_queue_commands = double(stats.commands - _command_queue_last_stats.commands) / p_frames;
+		_command_queue_bytes = double(stats.bytes - _command_queue_last_stats.bytes) / p_frames;
+		_command_queue_producer_stalls = double(stats.producer_stalls - _command_queue_last_stats.producer_stalls) / p_frames;
+	}
+	_command_queue_last_stats = stats;
+}
+
 void Performance::add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args) {
 	ERR_FAIL_COND_MSG(has_custom_monitor(p_id), "Custom monitor with id '" + String(p_id) + "' already exists.");
 	_monitor_map.insert(p_id, MonitorCall(p_callable, p_args));
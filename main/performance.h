@@ -32,6 +32,7 @@
 #define PERFORMANCE_H
 
 #include "core/object/class_db.h"
+#include "core/templates/command_queue_mt.h"
 #include "core/templates/hash_map.h"
 
 #define PERF_WARN_OFFLINE_FUNCTION
@@ -52,6 +53,11 @@ class Performance : public Object {
 	double _physics_process_time;
 	double _navigation_process_time;
 
+	CommandQueueMT::Stats _command_queue_last_stats;
+	double _command_queue_commands = 0;
+	double _command_queue_bytes = 0;
+	double _command_queue_producer_stalls = 0;
+
 	class MonitorCall {
 		Callable _callable;
 		Vector<Variant> _arguments;
@@ -100,6 +106,9 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		COMMAND_QUEUE_COMMANDS,
+		COMMAND_QUEUE_BYTES,
+		COMMAND_QUEUE_PRODUCER_STALLS,
 		MONITOR_MAX
 	};
 
@@ -117,6 +126,7 @@ public:
 	void set_process_time(double p_pt);
 	void set_physics_process_time(double p_pt);
 	void set_navigation_process_time(double p_pt);
+	void update_command_queue_stats(uint64_t p_frames);
 
 	void add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args);
 	void remove_custom_monitor(const StringName &p_id);
@@ -1250,6 +1250,12 @@ void GodotNavigationServer3D::flush_queries() {
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
 	MutexLock lock(commands_mutex);
+
+	// Commands may free maps and regions that batched path queries still read.
+	if (!commands.is_empty()) {
+		_finish_path_query_batches();
+	}
+
 	MutexLock lock2(operations_mutex);
 
 	for (SetCommand *command : commands) {
@@ -1341,6 +1347,7 @@ void GodotNavigationServer3D::init() {
 }
 
 void GodotNavigationServer3D::finish() {
+	_finish_path_query_batches();
 	flush_queries();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -1352,17 +1359,21 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_path_on_map(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_path_on_map(const NavMap *p_map, const PathQueryParameters &p_parameters) {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -1371,7 +1382,7 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -1433,6 +1444,153 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 	return r_query_result;
 }
 
+int64_t GodotNavigationServer3D::query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), -1, "The number of path query parameters and results must match.");
+
+	const uint32_t query_count = p_query_parameters.size();
+
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	batch->maps.resize(query_count);
+	batch->parameters.resize(query_count);
+	batch->results.resize(query_count);
+	batch->query_results = p_query_results;
+	batch->callback = p_callback;
+	batch->pending.set(query_count);
+
+	{
+		// Map lookups aren't safe on worker threads, resolve them here.
+		MutexLock lock(operations_mutex);
+		for (uint32_t i = 0; i < query_count; i++) {
+			const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+			const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+			if (query_parameters.is_null() || query_result.is_null()) {
+				memdelete(batch);
+				ERR_FAIL_V_MSG(-1, vformat("Invalid path query parameters or result at index %d.", i));
+			}
+			batch->parameters[i] = query_parameters->get_parameters();
+			batch->maps[i] = map_owner.get_or_null(batch->parameters[i].map);
+			ERR_CONTINUE_MSG(batch->maps[i] == nullptr, vformat("Path query at index %d uses an invalid navigation map.", i));
+		}
+	}
+
+	{
+		MutexLock lock(path_query_batch_mutex);
+		batch->id = ++path_query_batch_last_id;
+		path_query_batches.insert(batch->id, batch);
+	}
+
+	const int64_t batch_id = batch->id;
+	if (query_count == 0) {
+		callable_mp(this, &GodotNavigationServer3D::_finish_path_query_batch).call_deferred(batch_id);
+	} else {
+		batch->group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_query_path_batch_element, batch, query_count, -1, true, SNAME("NavigationServer3DPathQueryBatch"));
+	}
+	return batch_id;
+}
+
+bool GodotNavigationServer3D::is_path_query_batch_completed(int64_t p_batch_id) {
+	{
+		MutexLock lock(path_query_batch_mutex);
+		ERR_FAIL_COND_V_MSG(p_batch_id <= 0 || p_batch_id > path_query_batch_last_id, true, "Invalid path query batch ID.");
+
+		PathQueryBatch **batch = path_query_batches.getptr(p_batch_id);
+		if (batch == nullptr) {
+			// Already finished.
+			return true;
+		}
+		if ((*batch)->pending.get() > 0 || (*batch)->finishing) {
+			return false;
+		}
+	}
+
+	_finish_path_query_batch(p_batch_id);
+	return true;
+}
+
+void GodotNavigationServer3D::wait_for_path_query_batch_completion(int64_t p_batch_id) {
+	{
+		MutexLock lock(path_query_batch_mutex);
+		ERR_FAIL_COND_MSG(p_batch_id <= 0 || p_batch_id > path_query_batch_last_id, "Invalid path query batch ID.");
+	}
+
+	_finish_path_query_batch(p_batch_id);
+}
+
+void GodotNavigationServer3D::_query_path_batch_element(uint32_t p_index, PathQueryBatch *p_batch) {
+	if (p_batch->maps[p_index]) {
+		p_batch->results[p_index] = _query_path_on_map(p_batch->maps[p_index], p_batch->parameters[p_index]);
+	}
+
+	if (p_batch->pending.decrement() == 0) {
+		// The batch stays alive until its group task has been waited for, so
+		// this is the last access from the worker side.
+		callable_mp(this, &GodotNavigationServer3D::_finish_path_query_batch).call_deferred(p_batch->id);
+	}
+}
+
+void GodotNavigationServer3D::_finish_path_query_batch(int64_t p_batch_id) {
+	PathQueryBatch *batch = nullptr;
+	{
+		MutexLock lock(path_query_batch_mutex);
+		PathQueryBatch **E = path_query_batches.getptr(p_batch_id);
+		if (E == nullptr) {
+			// Finished earlier through polling, waiting or a flush.
+			return;
+		}
+		if ((*E)->finishing) {
+			// Another thread is copying the results, wait until they are stored.
+			while (path_query_batches.has(p_batch_id)) {
+				path_query_batch_finished.wait(lock);
+			}
+			return;
+		}
+		batch = *E;
+		batch->finishing = true;
+	}
+
+	if (batch->group_id != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_id);
+	}
+
+	for (uint32_t i = 0; i < batch->results.size(); i++) {
+		Ref<NavigationPathQueryResult3D> query_result = batch->query_results[i];
+		if (query_result.is_null()) {
+			continue;
+		}
+		const PathQueryResult &result = batch->results[i];
+		query_result->set_path(result.path);
+		query_result->set_path_types(result.path_types);
+		query_result->set_path_rids(result.path_rids);
+		query_result->set_path_owner_ids(result.path_owner_ids);
+	}
+
+	if (batch->callback.is_valid()) {
+		batch->callback.call_deferred();
+	}
+
+	{
+		MutexLock lock(path_query_batch_mutex);
+		path_query_batches.erase(p_batch_id);
+	}
+	path_query_batch_finished.notify_all();
+
+	memdelete(batch);
+}
+
+void GodotNavigationServer3D::_finish_path_query_batches() {
+	LocalVector<int64_t> batch_ids;
+	{
+		MutexLock lock(path_query_batch_mutex);
+		for (const KeyValue<int64_t, PathQueryBatch *> &E : path_query_batches) {
+			batch_ids.push_back(E.key);
+		}
+	}
+
+	for (int64_t batch_id : batch_ids) {
+		_finish_path_query_batch(batch_id);
+	}
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -37,6 +37,9 @@
 #include "../nav_obstacle.h"
 #include "../nav_region.h"
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/condition_variable.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -86,6 +89,28 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 #endif // _3D_DISABLED
 
+	// Path queries submitted through query_path_batch(). The maps are resolved
+	// on the submitting thread, the queries run on the WorkerThreadPool and the
+	// results are copied to the result objects once the whole batch is done.
+	// A batch stays in path_query_batches until its results are copied, other
+	// threads finishing it meanwhile wait on path_query_batch_finished.
+	struct PathQueryBatch {
+		int64_t id = 0;
+		LocalVector<const NavMap *> maps;
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		LocalVector<NavigationUtilities::PathQueryResult> results;
+		TypedArray<NavigationPathQueryResult3D> query_results;
+		Callable callback;
+		WorkerThreadPool::GroupID group_id = -1;
+		SafeNumeric<uint32_t> pending;
+		bool finishing = false;
+	};
+
+	BinaryMutex path_query_batch_mutex;
+	ConditionVariable path_query_batch_finished;
+	HashMap<int64_t, PathQueryBatch *> path_query_batches;
+	int64_t path_query_batch_last_id = 0;
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -286,11 +311,20 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
 
+	virtual int64_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override;
+	virtual bool is_path_query_batch_completed(int64_t p_batch_id) override;
+	virtual void wait_for_path_query_batch_completion(int64_t p_batch_id) override;
+
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	static NavigationUtilities::PathQueryResult _query_path_on_map(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters);
+	void _query_path_batch_element(uint32_t p_index, PathQueryBatch *p_batch);
+	void _finish_path_query_batch(int64_t p_batch_id);
+	void _finish_path_query_batches();
 };
 
 #undef COMMAND_1
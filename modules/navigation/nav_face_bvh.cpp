@@ -0,0 +1,288 @@
+/**************************************************************************/
+/*  nav_face_bvh.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_face_bvh.h"
+
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+namespace {
+
+struct FaceCenterComparator {
+	const Vector3 *centers = nullptr;
+	int axis = 0;
+
+	_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return centers[p_a][axis] < centers[p_b][axis];
+	}
+};
+
+_FORCE_INLINE_ real_t distance_squared_to_aabb(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 closest = p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size);
+	return closest.distance_squared_to(p_point);
+}
+
+// Enough for any tree built by median splits of a 32-bit face count.
+constexpr uint32_t STACK_SIZE = 64;
+
+} // namespace
+
+void NavFaceBVH::clear() {
+	faces.clear();
+	nodes.clear();
+}
+
+void NavFaceBVH::build(const LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	LocalVector<Face> fan_faces;
+	for (uint32_t polygon_index = 0; polygon_index < p_polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = p_polygons[polygon_index];
+		const uint32_t point_count = polygon.points.size();
+		for (uint32_t point_id = 2; point_id < point_count; point_id++) {
+			Face face;
+			face.face = Face3(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+			face.polygon = polygon_index;
+			face.outline_edges = 2; // The edge opposite to the fan origin.
+			if (point_id == 2) {
+				face.outline_edges |= 1;
+			}
+			if (point_id == point_count - 1) {
+				face.outline_edges |= 4;
+			}
+			fan_faces.push_back(face);
+		}
+	}
+	if (fan_faces.is_empty()) {
+		return;
+	}
+
+	LocalVector<Vector3> centers;
+	centers.resize(fan_faces.size());
+	LocalVector<uint32_t> order;
+	order.resize(fan_faces.size());
+	for (uint32_t i = 0; i < fan_faces.size(); i++) {
+		const Face3 &f = fan_faces[i].face;
+		centers[i] = (f.vertex[0] + f.vertex[1] + f.vertex[2]) / 3.0;
+		order[i] = i;
+	}
+
+	nodes.reserve(2 * fan_faces.size() / MAX_LEAF_FACES + 1);
+	nodes.push_back(Node());
+	_build_node(0, 0, fan_faces.size(), fan_faces, centers, order);
+
+	// Store faces in leaf order so leaves are contiguous.
+	faces.resize(fan_faces.size());
+	for (uint32_t i = 0; i < order.size(); i++) {
+		faces[i] = fan_faces[order[i]];
+	}
+}
+
+void NavFaceBVH::_build_node(uint32_t p_node, uint32_t p_begin, uint32_t p_end, const LocalVector<Face> &p_faces, const LocalVector<Vector3> &p_centers, LocalVector<uint32_t> &p_order) {
+	AABB bounds = p_faces[p_order[p_begin]].face.get_aabb();
+	AABB center_bounds(p_centers[p_order[p_begin]], Vector3());
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		bounds.merge_with(p_faces[p_order[i]].face.get_aabb());
+		center_bounds.expand_to(p_centers[p_order[i]]);
+	}
+	// Flat navigation meshes give zero-thickness boxes, keep segment tests robust.
+	nodes[p_node].bounds = bounds.grow(CMP_EPSILON);
+
+	const uint32_t count = p_end - p_begin;
+	if (count <= MAX_LEAF_FACES || center_bounds.get_longest_axis_size() == 0.0) {
+		nodes[p_node].first = p_begin;
+		nodes[p_node].count = count;
+		return;
+	}
+
+	// Median split along the longest axis of the face centers.
+	SortArray<uint32_t, FaceCenterComparator> sorter;
+	sorter.compare.centers = p_centers.ptr();
+	sorter.compare.axis = center_bounds.get_longest_axis_index();
+	const uint32_t half = count / 2;
+	sorter.nth_element(0, count, half, p_order.ptr() + p_begin);
+
+	// The first child must directly follow its parent.
+	const uint32_t left = nodes.size();
+	nodes.push_back(Node());
+	_build_node(left, p_begin, p_begin + half, p_faces, p_centers, p_order);
+	const uint32_t right = nodes.size();
+	nodes.push_back(Node());
+	_build_node(right, p_begin + half, p_end, p_faces, p_centers, p_order);
+	nodes[p_node].first = right;
+	nodes[p_node].count = 0;
+}
+
+const NavFaceBVH::Face *NavFaceBVH::get_closest_face(const Vector3 &p_point, real_t &r_distance_squared, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return nullptr;
+	}
+
+	const Face *closest = nullptr;
+	uint32_t stack[STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (distance_squared_to_aabb(node.bounds, p_point) >= r_distance_squared) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const Vector3 point = faces[i].face.get_closest_point_to(p_point);
+				const real_t distance_squared = point.distance_squared_to(p_point);
+				if (distance_squared < r_distance_squared) {
+					r_distance_squared = distance_squared;
+					r_point = point;
+					closest = &faces[i];
+				}
+			}
+			continue;
+		}
+
+		// Visit the nearer child first, it's the most likely to shrink the search radius.
+		const uint32_t left = &node - nodes.ptr() + 1;
+		const uint32_t right = node.first;
+		if (distance_squared_to_aabb(nodes[left].bounds, p_point) < distance_squared_to_aabb(nodes[right].bounds, p_point)) {
+			stack[stack_size++] = right;
+			stack[stack_size++] = left;
+		} else {
+			stack[stack_size++] = left;
+			stack[stack_size++] = right;
+		}
+	}
+
+	return closest;
+}
+
+const NavFaceBVH::Face *NavFaceBVH::intersect_segment(const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return nullptr;
+	}
+
+	const Face *closest = nullptr;
+	uint32_t stack[STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t index = stack[--stack_size];
+		const Node &node = nodes[index];
+		if (!node.bounds.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				Vector3 intersection;
+				if (faces[i].face.intersects_segment(p_from, p_to, &intersection)) {
+					const real_t distance = p_from.distance_to(intersection);
+					if (distance < r_distance) {
+						r_distance = distance;
+						r_point = intersection;
+						closest = &faces[i];
+					}
+				}
+			}
+			continue;
+		}
+
+		stack[stack_size++] = node.first;
+		stack[stack_size++] = index + 1;
+	}
+
+	return closest;
+}
+
+const NavFaceBVH::Face *NavFaceBVH::get_closest_face_to_segment(const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return nullptr;
+	}
+
+	const Face *closest = nullptr;
+	uint32_t stack[STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t index = stack[--stack_size];
+		const Node &node = nodes[index];
+		// Growing the box by the best distance so far covers every point
+		// within that distance, so the test never rejects a closer face.
+		if (r_distance < FLT_MAX && !node.bounds.grow(r_distance).intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const Face3 &f = faces[i].face;
+
+				const Vector3 from_closest = f.get_closest_point_to(p_from);
+				const real_t from_distance = p_from.distance_to(from_closest);
+				if (from_distance < r_distance) {
+					r_distance = from_distance;
+					r_point = from_closest;
+					closest = &faces[i];
+				}
+
+				const Vector3 to_closest = f.get_closest_point_to(p_to);
+				const real_t to_distance = p_to.distance_to(to_closest);
+				if (to_distance < r_distance) {
+					r_distance = to_distance;
+					r_point = to_closest;
+					closest = &faces[i];
+				}
+
+				for (int edge = 0; edge < 3; edge++) {
+					if (!(faces[i].outline_edges & (1 << edge))) {
+						continue;
+					}
+					Vector3 a;
+					Vector3 b;
+					Geometry3D::get_closest_points_between_segments(p_from, p_to, f.vertex[edge], f.vertex[(edge + 1) % 3], a, b);
+					const real_t distance = a.distance_to(b);
+					if (distance < r_distance) {
+						r_distance = distance;
+						r_point = b;
+						closest = &faces[i];
+					}
+				}
+			}
+			continue;
+		}
+
+		stack[stack_size++] = node.first;
+		stack[stack_size++] = index + 1;
+	}
+
+	return closest;
+}
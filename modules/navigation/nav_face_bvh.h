@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  nav_face_bvh.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_FACE_BVH_H
+#define NAV_FACE_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+#include "core/math/face3.h"
+#include "core/templates/local_vector.h"
+
+/// Static bounding volume hierarchy over the triangles of a set of polygons,
+/// used to answer closest point and segment queries without visiting every
+/// polygon. Polygons are triangulated as fans like everywhere else in the
+/// navigation code. Built once per region whenever its polygons change.
+class NavFaceBVH {
+public:
+	struct Face {
+		Face3 face;
+		/// Index of the polygon in the array the BVH was built from.
+		uint32_t polygon = 0;
+		/// Bit i is set when the edge from vertex i to vertex (i + 1) % 3 is on
+		/// the polygon outline rather than a diagonal of the fan.
+		uint32_t outline_edges = 0;
+	};
+
+private:
+	static constexpr uint32_t MAX_LEAF_FACES = 4;
+
+	struct Node {
+		AABB bounds;
+		/// Leaves have `count` faces starting at `first`. Inner nodes have a
+		/// count of 0, their first child follows them and `first` is the second.
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	LocalVector<Face> faces;
+	LocalVector<Node> nodes;
+
+	void _build_node(uint32_t p_node, uint32_t p_begin, uint32_t p_end, const LocalVector<Face> &p_faces, const LocalVector<Vector3> &p_centers, LocalVector<uint32_t> &p_order);
+
+public:
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+
+	bool is_empty() const { return nodes.is_empty(); }
+	AABB get_bounds() const { return nodes.is_empty() ? AABB() : nodes[0].bounds; }
+	uint32_t get_face_count() const { return faces.size(); }
+
+	/// Finds the point of any face closest to p_point, if it's closer than
+	/// the square root of r_distance_squared, which is then updated.
+	const Face *get_closest_face(const Vector3 &p_point, real_t &r_distance_squared, Vector3 &r_point) const;
+	/// Finds the face intersection closest to p_from, if it's closer than
+	/// r_distance, which is then updated.
+	const Face *intersect_segment(const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const;
+	/// Finds the point of any face or polygon outline closest to the segment
+	/// endpoints or the segment itself, if it's closer than r_distance.
+	const Face *get_closest_face_to_segment(const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const;
+};
+
+#endif // NAV_FACE_BVH_H
@@ -37,6 +37,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/flat_hash_map.h"
 
 #include <Obstacle2d.h>
 
@@ -63,6 +64,23 @@
 #define NAVMAP_ITERATION_ZERO_ERROR_MSG()
 #endif // DEBUG_ENABLED
 
+// Open and closed lists of the path search. Kept per thread, so path queries
+// running concurrently on worker threads don't share (or reallocate) them.
+struct PathQueryScratch {
+	LocalVector<gd::NavigationPoly> navigation_polys;
+	FlatHashMap<const gd::Polygon *, uint32_t> navigation_poly_ids;
+	LocalVector<uint32_t> to_visit;
+	LocalVector<uint8_t> corridor;
+
+	void clear() {
+		navigation_polys.clear();
+		navigation_poly_ids.clear();
+		to_visit.clear();
+	}
+};
+
+static thread_local PathQueryScratch path_query_scratch;
+
 void NavMap::set_up(Vector3 p_up) {
 	if (up == p_up) {
 		return;
@@ -154,40 +172,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+	real_t begin_ds = FLT_MAX;
+	real_t end_ds = FLT_MAX;
+	const int64_t begin_index = _get_closest_polygon(p_origin, true, p_navigation_layers, begin_ds, begin_point);
+	const int64_t end_index = _get_closest_polygon(p_destination, true, p_navigation_layers, end_ds, end_point);
+	const gd::Polygon *begin_poly = begin_index >= 0 ? &polygons[begin_index] : nullptr;
+	const gd::Polygon *end_poly = end_index >= 0 ? &polygons[end_index] : nullptr;
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -219,9 +211,16 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// The search lists live in per-thread scratch, so repeated (and batched)
+	// queries don't allocate once the buffers have grown.
+	PathQueryScratch &scratch = path_query_scratch;
+	scratch.clear();
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
+	LocalVector<gd::NavigationPoly> &navigation_polys = scratch.navigation_polys;
 	navigation_polys.reserve(polygons.size() * 0.75);
+	// Index of each reached polygon in navigation_polys.
+	FlatHashMap<const gd::Polygon *, uint32_t> &navigation_poly_ids = scratch.navigation_poly_ids;
 
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
@@ -230,11 +229,16 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
 	navigation_polys.push_back(begin_navigation_poly);
+	navigation_poly_ids.insert(begin_poly, 0);
 
 	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
+	LocalVector<uint32_t> &to_visit = scratch.to_visit;
 	to_visit.push_back(0);
 
+	// Long searches are limited to the clusters of the hierarchical route.
+	LocalVector<uint8_t> &corridor = scratch.corridor;
+	bool use_corridor = use_hierarchical_pathfinding && path_hierarchy.find_corridor(begin_poly, end_poly, end_point, p_navigation_layers, corridor);
+
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = 0;
 	int prev_least_cost_id = -1;
@@ -256,6 +260,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				if (use_corridor && !path_hierarchy.is_in_corridor(connection.polygon, corridor)) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -269,11 +277,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				const uint32_t *already_visited_polygon_index = navigation_poly_ids.getptr(connection.polygon);
 
-				if (already_visited_polygon_index != -1) {
+				if (already_visited_polygon_index) {
 					// Polygon already visited, check if we can reduce the travel cost.
-					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
+					gd::NavigationPoly &avp = navigation_polys[*already_visited_polygon_index];
 					if (new_distance < avp.traveled_distance) {
 						avp.back_navigation_poly_id = least_cost_id;
 						avp.back_navigation_edge = connection.edge;
@@ -293,6 +301,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					new_navigation_poly.traveled_distance = new_distance;
 					new_navigation_poly.entry = new_entry;
 					navigation_polys.push_back(new_navigation_poly);
+					navigation_poly_ids.insert(connection.polygon, new_navigation_poly.self_id);
 
 					// Add the neighbor polygon to the polygons to visit.
 					to_visit.push_back(navigation_polys.size() - 1);
@@ -304,6 +313,25 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		to_visit.erase(least_cost_id);
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
+		if (to_visit.size() == 0 && use_corridor) {
+			// The corridor cut the route somewhere, search all polygons instead.
+			use_corridor = false;
+
+			gd::NavigationPoly np = navigation_polys[0];
+			navigation_polys.clear();
+			navigation_polys.push_back(np);
+			navigation_poly_ids.clear();
+			navigation_poly_ids.insert(np.poly, 0);
+			to_visit.push_back(0);
+			least_cost_id = 0;
+			prev_least_cost_id = -1;
+
+			reachable_end = nullptr;
+			reachable_d = FLT_MAX;
+
+			continue;
+		}
+
 		if (to_visit.size() == 0) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
@@ -315,7 +343,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 			// Set as end point the furthest reachable point.
 			end_poly = reachable_end;
-			end_d = FLT_MAX;
+			real_t end_d = FLT_MAX;
 			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
 				Face3 f(end_poly->points[0].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
 				Vector3 spoint = f.get_closest_point_to(p_destination);
@@ -370,6 +398,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			gd::NavigationPoly np = navigation_polys[0];
 			navigation_polys.clear();
 			navigation_polys.push_back(np);
+			navigation_poly_ids.clear();
+			navigation_poly_ids.insert(np.poly, 0);
 			to_visit.clear();
 			to_visit.push_back(0);
 			least_cost_id = 0;
@@ -383,8 +413,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		// Find the polygon with the minimum cost from the list of polygons to visit.
 		least_cost_id = -1;
 		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
+		for (const uint32_t &element : to_visit) {
+			gd::NavigationPoly *np = &navigation_polys[element];
 			real_t cost = np->traveled_distance;
 			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
 			if (cost < least_cost) {
@@ -414,7 +444,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	// We did not find a route but we have both a start polygon and an end polygon at this point.
 	// Usually this happens because there was not a single external or internal connected edge, e.g. our start polygon is an isolated, single convex polygon.
 	if (!found_route) {
-		end_d = FLT_MAX;
+		real_t end_d = FLT_MAX;
 		// Search all faces of the start polygon for the closest point to our target position.
 		for (size_t point_id = 2; point_id < begin_poly->points.size(); point_id++) {
 			Face3 f(begin_poly->points[0].pos, begin_poly->points[point_id - 1].pos, begin_poly->points[point_id].pos);
@@ -607,62 +637,21 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 		return Vector3();
 	}
 
-	bool use_collision = p_use_collision;
 	Vector3 closest_point;
 	real_t closest_point_d = FLT_MAX;
+	bool collided = false;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
-			// If segment does not itersect face, check the distance from segment's endpoints.
-			else if (!use_collision) {
-				const Vector3 p_from_closest = f.get_closest_point_to(p_from);
-				const real_t d_p_from = p_from.distance_to(p_from_closest);
-				if (closest_point_d > d_p_from) {
-					closest_point = p_from_closest;
-					closest_point_d = d_p_from;
-				}
-
-				const Vector3 p_to_closest = f.get_closest_point_to(p_to);
-				const real_t d_p_to = p_to.distance_to(p_to_closest);
-				if (closest_point_d > d_p_to) {
-					closest_point = p_to_closest;
-					closest_point_d = d_p_to;
-				}
-			}
+	for (const RegionPolygons &E : region_polygons) {
+		if (E.region->get_face_bvh().intersect_segment(p_from, p_to, closest_point_d, closest_point)) {
+			collided = true;
 		}
-		// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
-		if (!use_collision) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
-
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
-				}
-			}
+	}
+
+	// Without an intersection, use the point closest to the segment endpoints
+	// or to the segment itself.
+	if (!collided && !p_use_collision) {
+		for (const RegionPolygons &E : region_polygons) {
+			E.region->get_face_bvh().get_closest_face_to_segment(p_from, p_to, closest_point_d, closest_point);
 		}
 	}
 
@@ -705,24 +694,32 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	gd::ClosestPointQueryResult result;
 	real_t closest_point_ds = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+	const int64_t polygon_index = _get_closest_polygon(p_point, false, 0, closest_point_ds, result.point, &result.normal);
+	if (polygon_index >= 0) {
+		result.owner = polygons[polygon_index].owner->get_self();
 	}
 
 	return result;
 }
 
+int64_t NavMap::_get_closest_polygon(const Vector3 &p_point, bool p_use_navigation_layers, uint32_t p_navigation_layers, real_t &r_distance_squared, Vector3 &r_point, Vector3 *r_normal) const {
+	int64_t closest = -1;
+	for (const RegionPolygons &E : region_polygons) {
+		// Only consider the polygons of regions with compatible layers.
+		if (p_use_navigation_layers && (p_navigation_layers & E.region->get_navigation_layers()) == 0) {
+			continue;
+		}
+		const NavFaceBVH::Face *face = E.region->get_face_bvh().get_closest_face(p_point, r_distance_squared, r_point);
+		if (face) {
+			closest = E.polygon_offset + face->polygon;
+			if (r_normal) {
+				*r_normal = face->face.get_plane().normal;
+			}
+		}
+	}
+	return closest;
+}
+
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
 	regenerate_links = true;
@@ -952,10 +949,12 @@ void NavMap::sync() {
 
 		// Copy all region polygons in the map.
 		count = 0;
+		region_polygons.clear();
 		for (const NavRegion *region : regions) {
 			if (!region->get_enabled()) {
 				continue;
 			}
+			region_polygons.push_back({ region, uint32_t(count) });
 			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
 			for (uint32_t n = 0; n < polygons_source.size(); n++) {
 				polygons[count + n] = polygons_source[n];
@@ -1087,49 +1086,16 @@ void NavMap::sync() {
 			const Vector3 start = link->get_start_position();
 			const Vector3 end = link->get_end_position();
 
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
+			// Find the closest polygons within the search radius of the start and end points.
 			Vector3 closest_start_point;
+			real_t closest_start_distance_squared = link_connection_radius * link_connection_radius;
+			const int64_t start_index = _get_closest_polygon(start, false, 0, closest_start_distance_squared, closest_start_point);
+			gd::Polygon *closest_start_polygon = start_index >= 0 ? &polygons[start_index] : nullptr;
 
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
 			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+			real_t closest_end_distance_squared = link_connection_radius * link_connection_radius;
+			const int64_t end_index = _get_closest_polygon(end, false, 0, closest_end_distance_squared, closest_end_point);
+			gd::Polygon *closest_end_polygon = end_index >= 0 ? &polygons[end_index] : nullptr;
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
 			if (closest_start_polygon && closest_end_polygon) {
@@ -1183,6 +1149,22 @@ void NavMap::sync() {
 			}
 		}
 
+		if (use_hierarchical_pathfinding) {
+			LocalVector<NavPathHierarchy::RegionSource> region_sources;
+			region_sources.reserve(region_polygons.size());
+			for (const RegionPolygons &region_polygon : region_polygons) {
+				NavPathHierarchy::RegionSource region_source;
+				region_source.region = region_polygon.region->get_self();
+				region_source.polygons_version = region_polygon.region->get_polygons_version();
+				region_source.polygon_offset = region_polygon.polygon_offset;
+				region_source.polygon_count = region_polygon.region->get_polygons().size();
+				region_sources.push_back(region_source);
+			}
+			path_hierarchy.build(polygons, link_polygons, link_poly_idx, region_sources, hierarchical_cluster_size);
+		} else {
+			path_hierarchy.clear();
+		}
+
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
 		iteration_id = iteration_id % UINT32_MAX + 1;
 	}
@@ -1429,6 +1411,8 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
+	hierarchical_cluster_size = MAX(real_t(GLOBAL_GET("navigation/pathfinding/hierarchical_cluster_size")), (real_t)0.1);
 }
 
 NavMap::~NavMap() {
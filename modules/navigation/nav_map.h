@@ -31,6 +31,7 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_path_hierarchy.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -84,6 +85,19 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Where the polygons of each enabled region start in `polygons`, to map
+	/// the results of the region face BVHs back to map polygons.
+	struct RegionPolygons {
+		const NavRegion *region = nullptr;
+		uint32_t polygon_offset = 0;
+	};
+	LocalVector<RegionPolygons> region_polygons;
+
+	/// Optional abstract graph that narrows down long path searches.
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_cluster_size = 16.0;
+	NavPathHierarchy path_hierarchy;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -163,6 +177,10 @@ public:
 		return link_connection_radius;
 	}
 
+	const NavPathHierarchy &get_path_hierarchy() const {
+		return path_hierarchy;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
@@ -230,6 +248,11 @@ private:
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	// Index in `polygons` of the polygon closest to p_point, or -1 if none is
+	// closer than sqrt(r_distance_squared). With p_use_navigation_layers,
+	// regions without any of p_navigation_layers are skipped.
+	int64_t _get_closest_polygon(const Vector3 &p_point, bool p_use_navigation_layers, uint32_t p_navigation_layers, real_t &r_distance_squared, Vector3 &r_point, Vector3 *r_normal = nullptr) const;
 };
 
 #endif // NAV_MAP_H
@@ -0,0 +1,556 @@
+/**************************************************************************/
+/*  nav_path_hierarchy.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_path_hierarchy.h"
+
+#include "nav_base.h"
+
+#include "core/templates/sort_array.h"
+
+namespace {
+
+struct OpenEntry {
+	uint32_t id = 0;
+	real_t cost = 0.0;
+};
+
+struct SortOpenEntries {
+	// Returns true when A is worse than B, so the cheapest entry is on top of the heap.
+	_FORCE_INLINE_ bool operator()(const OpenEntry &A, const OpenEntry &B) const {
+		return A.cost > B.cost;
+	}
+};
+
+// Search state, kept per thread since path queries may run on worker threads.
+// Entries are valid when their pass matches the current pass, so nothing
+// needs to be cleared between searches.
+struct HierarchyScratch {
+	LocalVector<real_t> polygon_costs;
+	LocalVector<uint32_t> polygon_passes;
+	LocalVector<uint32_t> polygon_closed;
+	uint32_t polygon_pass = 0;
+	LocalVector<OpenEntry> polygon_open;
+
+	LocalVector<real_t> node_costs;
+	LocalVector<int32_t> node_parents;
+	LocalVector<uint32_t> node_passes;
+	LocalVector<uint32_t> node_closed;
+	LocalVector<real_t> goal_costs;
+	LocalVector<uint32_t> goal_passes;
+	uint32_t node_pass = 0;
+	LocalVector<OpenEntry> node_open;
+
+	void begin_polygon_search(uint32_t p_count) {
+		if (polygon_passes.size() < p_count || polygon_pass == UINT32_MAX) {
+			polygon_costs.resize(p_count);
+			polygon_passes.resize(p_count);
+			polygon_closed.resize(p_count);
+			for (uint32_t i = 0; i < p_count; i++) {
+				polygon_passes[i] = 0;
+				polygon_closed[i] = 0;
+			}
+			polygon_pass = 0;
+		}
+		polygon_pass++;
+		polygon_open.clear();
+	}
+
+	void begin_node_search(uint32_t p_count) {
+		if (node_passes.size() < p_count || node_pass == UINT32_MAX) {
+			node_costs.resize(p_count);
+			node_parents.resize(p_count);
+			node_passes.resize(p_count);
+			node_closed.resize(p_count);
+			goal_costs.resize(p_count);
+			goal_passes.resize(p_count);
+			for (uint32_t i = 0; i < p_count; i++) {
+				node_passes[i] = 0;
+				node_closed[i] = 0;
+				goal_passes[i] = 0;
+			}
+			node_pass = 0;
+		}
+		node_pass++;
+		node_open.clear();
+	}
+};
+
+thread_local HierarchyScratch hierarchy_scratch;
+
+_FORCE_INLINE_ void push_open(LocalVector<OpenEntry> &r_open, uint32_t p_id, real_t p_cost) {
+	SortArray<OpenEntry, SortOpenEntries> sorter;
+	r_open.push_back({ p_id, p_cost });
+	sorter.push_heap(0, r_open.size() - 1, 0, r_open[r_open.size() - 1], r_open.ptr());
+}
+
+_FORCE_INLINE_ OpenEntry pop_open(LocalVector<OpenEntry> &r_open) {
+	SortArray<OpenEntry, SortOpenEntries> sorter;
+	sorter.pop_heap(0, r_open.size(), r_open.ptr());
+	const OpenEntry entry = r_open[r_open.size() - 1];
+	r_open.remove_at(r_open.size() - 1);
+	return entry;
+}
+
+} // namespace
+
+// Dijkstra over the polygons of the cluster of p_source, moving between
+// polygon centers through the middle of the connection pathways. Calls
+// p_settled(polygon, distance) for every polygon reached, in distance order.
+template <typename F>
+void NavPathHierarchy::_search_cluster(uint32_t p_source, F p_settled) const {
+	HierarchyScratch &scratch = hierarchy_scratch;
+	scratch.begin_polygon_search(polygon_clusters.size());
+	const uint32_t pass = scratch.polygon_pass;
+	const uint32_t cluster = polygon_clusters[p_source];
+
+	scratch.polygon_costs[p_source] = 0.0;
+	scratch.polygon_passes[p_source] = pass;
+	push_open(scratch.polygon_open, p_source, 0.0);
+
+	while (!scratch.polygon_open.is_empty()) {
+		const OpenEntry entry = pop_open(scratch.polygon_open);
+		if (scratch.polygon_closed[entry.id] == pass) {
+			continue;
+		}
+		scratch.polygon_closed[entry.id] = pass;
+		p_settled(entry.id, entry.cost);
+
+		const Vector3 &position = polygon_positions[entry.id];
+		for (const gd::Edge &edge : _get_polygon(entry.id).edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const int64_t to = _get_polygon_index(connection.polygon);
+				if (to < 0 || polygon_clusters[to] != cluster || scratch.polygon_closed[to] == pass) {
+					continue;
+				}
+
+				const Vector3 pathway_center = (connection.pathway_start + connection.pathway_end) * 0.5;
+				const real_t cost = entry.cost + position.distance_to(pathway_center) + pathway_center.distance_to(polygon_positions[to]);
+				if (scratch.polygon_passes[to] != pass || cost < scratch.polygon_costs[to]) {
+					scratch.polygon_costs[to] = cost;
+					scratch.polygon_passes[to] = pass;
+					push_open(scratch.polygon_open, to, cost);
+				}
+			}
+		}
+	}
+}
+
+void NavPathHierarchy::_build_region_cache(RegionCache &r_cache, const RegionSource &p_source) {
+	const uint32_t offset = p_source.polygon_offset;
+	const uint32_t count = p_source.polygon_count;
+
+	// Find the border polygons of each cluster, map clusters are already assigned.
+	LocalVector<int32_t> border_indices;
+	border_indices.resize(count);
+	LocalVector<uint32_t> cluster_border_counts;
+	cluster_border_counts.resize(r_cache.cluster_count);
+	for (uint32_t c = 0; c < r_cache.cluster_count; c++) {
+		cluster_border_counts[c] = 0;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		border_indices[i] = -1;
+		const uint32_t cluster = polygon_clusters[offset + i];
+		for (const gd::Edge &edge : polygons[offset + i].edges) {
+			bool shared_with_cluster = false;
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const int64_t to = _get_polygon_index(connection.polygon);
+				if (to >= 0 && polygon_clusters[to] == cluster) {
+					shared_with_cluster = true;
+					break;
+				}
+			}
+			if (!shared_with_cluster) {
+				border_indices[i] = cluster_border_counts[r_cache.polygon_clusters[i]]++;
+				break;
+			}
+		}
+	}
+
+	r_cache.border_offsets.resize(r_cache.cluster_count + 1);
+	r_cache.distance_offsets.resize(r_cache.cluster_count + 1);
+	r_cache.border_offsets[0] = 0;
+	r_cache.distance_offsets[0] = 0;
+	for (uint32_t c = 0; c < r_cache.cluster_count; c++) {
+		r_cache.border_offsets[c + 1] = r_cache.border_offsets[c] + cluster_border_counts[c];
+		r_cache.distance_offsets[c + 1] = r_cache.distance_offsets[c] + cluster_border_counts[c] * cluster_border_counts[c];
+	}
+
+	r_cache.border_polygons.resize(r_cache.border_offsets[r_cache.cluster_count]);
+	for (uint32_t i = 0; i < count; i++) {
+		if (border_indices[i] >= 0) {
+			r_cache.border_polygons[r_cache.border_offsets[r_cache.polygon_clusters[i]] + border_indices[i]] = i;
+		}
+	}
+
+	// Route lengths between every pair of border polygons of a cluster.
+	r_cache.border_distances.resize(r_cache.distance_offsets[r_cache.cluster_count]);
+	for (real_t &distance : r_cache.border_distances) {
+		distance = FLT_MAX;
+	}
+	for (uint32_t c = 0; c < r_cache.cluster_count; c++) {
+		const uint32_t border_count = cluster_border_counts[c];
+		for (uint32_t b = 0; b < border_count; b++) {
+			real_t *row = &r_cache.border_distances[r_cache.distance_offsets[c] + b * border_count];
+			_search_cluster(offset + r_cache.border_polygons[r_cache.border_offsets[c] + b], [&](uint32_t p_polygon, real_t p_distance) {
+				const int32_t border_index = border_indices[p_polygon - offset];
+				if (border_index >= 0) {
+					row[border_index] = p_distance;
+				}
+			});
+		}
+	}
+}
+
+void NavPathHierarchy::build(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, uint32_t p_link_polygon_count, const LocalVector<RegionSource> &p_regions, real_t p_cluster_size) {
+	polygons = p_polygons.ptr();
+	polygon_count = p_polygons.size();
+	link_polygons = p_link_polygons.ptr();
+	link_polygon_count = p_link_polygon_count;
+	rebuilt_region_count = 0;
+
+	if (cluster_size != p_cluster_size) {
+		region_caches.clear();
+		cluster_size = p_cluster_size;
+	}
+
+	const uint32_t total_count = polygon_count + link_polygon_count;
+	polygon_clusters.resize(total_count);
+	polygon_positions.resize(total_count);
+	for (uint32_t i = 0; i < total_count; i++) {
+		const gd::Polygon &polygon = _get_polygon(i);
+		Vector3 center;
+		for (const gd::Point &point : polygon.points) {
+			center += point.pos;
+		}
+		polygon_positions[i] = polygon.points.is_empty() ? center : center / polygon.points.size();
+	}
+
+	// Assign the clusters first, the cached routes of changed regions are
+	// computed once every polygon knows its cluster.
+	LocalVector<RegionCache *> caches;
+	LocalVector<RegionCache *> rebuilt_caches;
+	LocalVector<const RegionSource *> rebuilt_sources;
+	cluster_count = 0;
+	for (const RegionSource &source : p_regions) {
+		RegionCache *cache = region_caches.getptr(source.region);
+		if (cache == nullptr) {
+			cache = &region_caches.insert(source.region, RegionCache())->value;
+		}
+
+		if (cache->polygons_version != source.polygons_version || cache->polygon_count != source.polygon_count || cache->border_offsets.is_empty()) {
+			cache->polygons_version = source.polygons_version;
+			cache->polygon_count = source.polygon_count;
+			cache->polygon_clusters.resize(source.polygon_count);
+
+			HashMap<Vector3i, uint32_t> cells;
+			for (uint32_t i = 0; i < source.polygon_count; i++) {
+				const Vector3i cell = Vector3i((polygon_positions[source.polygon_offset + i] / cluster_size).floor());
+				HashMap<Vector3i, uint32_t>::Iterator E = cells.find(cell);
+				if (!E) {
+					E = cells.insert(cell, cells.size());
+				}
+				cache->polygon_clusters[i] = E->value;
+			}
+			cache->cluster_count = cells.size();
+
+			rebuilt_caches.push_back(cache);
+			rebuilt_sources.push_back(&source);
+		}
+
+		for (uint32_t i = 0; i < source.polygon_count; i++) {
+			polygon_clusters[source.polygon_offset + i] = cluster_count + cache->polygon_clusters[i];
+		}
+		cluster_count += cache->cluster_count;
+		cache->used = true;
+		caches.push_back(cache);
+	}
+
+	// Every link is a cluster of its own.
+	for (uint32_t i = polygon_count; i < total_count; i++) {
+		polygon_clusters[i] = cluster_count++;
+	}
+
+	for (uint32_t i = 0; i < rebuilt_caches.size(); i++) {
+		_build_region_cache(*rebuilt_caches[i], *rebuilt_sources[i]);
+	}
+	rebuilt_region_count = rebuilt_caches.size();
+
+	// Forget the regions that are gone.
+	LocalVector<RID> unused_regions;
+	for (KeyValue<RID, RegionCache> &E : region_caches) {
+		if (!E.value.used) {
+			unused_regions.push_back(E.key);
+		}
+		E.value.used = false;
+	}
+	for (const RID &region : unused_regions) {
+		region_caches.erase(region);
+	}
+
+	// Polygons with a connection to another cluster, in either direction, are nodes.
+	polygon_nodes.resize(total_count);
+	for (int32_t &node : polygon_nodes) {
+		node = -1;
+	}
+	for (uint32_t i = 0; i < total_count; i++) {
+		for (const gd::Edge &edge : _get_polygon(i).edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const int64_t to = _get_polygon_index(connection.polygon);
+				if (to >= 0 && polygon_clusters[to] != polygon_clusters[i]) {
+					polygon_nodes[i] = 0;
+					polygon_nodes[to] = 0;
+				}
+			}
+		}
+	}
+
+	nodes.clear();
+	for (uint32_t i = 0; i < total_count; i++) {
+		if (polygon_nodes[i] == 0) {
+			polygon_nodes[i] = nodes.size();
+			Node node;
+			node.polygon = i;
+			node.cluster = polygon_clusters[i];
+			nodes.push_back(node);
+		}
+	}
+
+	struct PendingEdge {
+		uint32_t from = 0;
+		uint32_t to = 0;
+		real_t distance = 0.0;
+	};
+	LocalVector<PendingEdge> pending_edges;
+
+	// Routes inside clusters, from the cached border routes.
+	LocalVector<uint8_t> is_border;
+	is_border.resize(total_count);
+	for (uint8_t &border : is_border) {
+		border = 0;
+	}
+	for (uint32_t r = 0; r < p_regions.size(); r++) {
+		const RegionCache &cache = *caches[r];
+		const uint32_t offset = p_regions[r].polygon_offset;
+		for (uint32_t c = 0; c < cache.cluster_count; c++) {
+			const uint32_t border_begin = cache.border_offsets[c];
+			const uint32_t border_count = cache.border_offsets[c + 1] - border_begin;
+			for (uint32_t a = 0; a < border_count; a++) {
+				const uint32_t polygon_a = offset + cache.border_polygons[border_begin + a];
+				is_border[polygon_a] = 1;
+				if (polygon_nodes[polygon_a] < 0) {
+					continue;
+				}
+				const real_t *row = &cache.border_distances[cache.distance_offsets[c] + a * border_count];
+				for (uint32_t b = 0; b < border_count; b++) {
+					const uint32_t polygon_b = offset + cache.border_polygons[border_begin + b];
+					if (a != b && polygon_nodes[polygon_b] >= 0 && row[b] != FLT_MAX) {
+						pending_edges.push_back({ uint32_t(polygon_nodes[polygon_a]), uint32_t(polygon_nodes[polygon_b]), row[b] });
+					}
+				}
+			}
+		}
+	}
+
+	// Nodes inside a cluster (e.g. where a link starts) aren't in the cache,
+	// search their routes now. Links are single polygon clusters.
+	for (uint32_t n = 0; n < nodes.size(); n++) {
+		const uint32_t polygon = nodes[n].polygon;
+		if (is_border[polygon] || polygon >= polygon_count) {
+			continue;
+		}
+		_search_cluster(polygon, [&](uint32_t p_polygon, real_t p_distance) {
+			const int32_t other = polygon_nodes[p_polygon];
+			if (other < 0 || uint32_t(other) == n) {
+				return;
+			}
+			pending_edges.push_back({ n, uint32_t(other), p_distance });
+			if (is_border[p_polygon]) {
+				// The other direction isn't found by any other search.
+				pending_edges.push_back({ uint32_t(other), n, p_distance });
+			}
+		});
+	}
+
+	// Connections between clusters.
+	for (uint32_t n = 0; n < nodes.size(); n++) {
+		const uint32_t polygon = nodes[n].polygon;
+		for (const gd::Edge &edge : _get_polygon(polygon).edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const int64_t to = _get_polygon_index(connection.polygon);
+				if (to < 0 || polygon_clusters[to] == nodes[n].cluster) {
+					continue;
+				}
+				const Vector3 pathway_center = (connection.pathway_start + connection.pathway_end) * 0.5;
+				const real_t distance = polygon_positions[polygon].distance_to(pathway_center) + pathway_center.distance_to(polygon_positions[to]);
+				pending_edges.push_back({ n, uint32_t(polygon_nodes[to]), distance });
+			}
+		}
+	}
+
+	// Store the edges grouped by node.
+	for (Node &node : nodes) {
+		node.edge_count = 0;
+	}
+	for (const PendingEdge &pending_edge : pending_edges) {
+		nodes[pending_edge.from].edge_count++;
+	}
+	uint32_t first_edge = 0;
+	for (Node &node : nodes) {
+		node.first_edge = first_edge;
+		first_edge += node.edge_count;
+		node.edge_count = 0;
+	}
+	edges.resize(pending_edges.size());
+	for (const PendingEdge &pending_edge : pending_edges) {
+		Node &node = nodes[pending_edge.from];
+		edges[node.first_edge + node.edge_count++] = { pending_edge.to, pending_edge.distance };
+	}
+}
+
+void NavPathHierarchy::clear() {
+	region_caches.clear();
+	polygons = nullptr;
+	polygon_count = 0;
+	link_polygons = nullptr;
+	link_polygon_count = 0;
+	cluster_count = 0;
+	rebuilt_region_count = 0;
+	polygon_clusters.clear();
+	polygon_positions.clear();
+	polygon_nodes.clear();
+	nodes.clear();
+	edges.clear();
+}
+
+bool NavPathHierarchy::find_corridor(const gd::Polygon *p_begin, const gd::Polygon *p_end, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	const int64_t begin = _get_polygon_index(p_begin);
+	const int64_t end = _get_polygon_index(p_end);
+	if (begin < 0 || end < 0 || begin >= polygon_count || end >= polygon_count) {
+		return false;
+	}
+	const uint32_t begin_cluster = polygon_clusters[begin];
+	const uint32_t end_cluster = polygon_clusters[end];
+	if (begin_cluster == end_cluster) {
+		return false;
+	}
+
+	// The target is an extra node after all the others.
+	const uint32_t target = nodes.size();
+	HierarchyScratch &scratch = hierarchy_scratch;
+	scratch.begin_node_search(nodes.size() + 1);
+	const uint32_t pass = scratch.node_pass;
+
+	auto open_node = [&](uint32_t p_node, real_t p_cost, int32_t p_parent) {
+		if (scratch.node_passes[p_node] == pass && p_cost >= scratch.node_costs[p_node]) {
+			return;
+		}
+		scratch.node_costs[p_node] = p_cost;
+		scratch.node_parents[p_node] = p_parent;
+		scratch.node_passes[p_node] = pass;
+		const real_t estimate = p_node == target ? 0.0 : polygon_positions[nodes[p_node].polygon].distance_to(p_end_point);
+		push_open(scratch.node_open, p_node, p_cost + estimate);
+	};
+
+	// How far the end polygon is from the nodes of its cluster.
+	const real_t end_travel_cost = p_end->owner->get_travel_cost();
+	_search_cluster(end, [&](uint32_t p_polygon, real_t p_distance) {
+		const int32_t node = polygon_nodes[p_polygon];
+		if (node >= 0) {
+			scratch.goal_costs[node] = p_distance * end_travel_cost;
+			scratch.goal_passes[node] = pass;
+		}
+	});
+
+	// Start from the nodes of the begin cluster.
+	const real_t begin_travel_cost = p_begin->owner->get_travel_cost();
+	_search_cluster(begin, [&](uint32_t p_polygon, real_t p_distance) {
+		const int32_t node = polygon_nodes[p_polygon];
+		if (node >= 0) {
+			open_node(node, p_distance * begin_travel_cost, -1);
+		}
+	});
+
+	bool found = false;
+	while (!scratch.node_open.is_empty()) {
+		const OpenEntry entry = pop_open(scratch.node_open);
+		if (entry.id == target) {
+			found = true;
+			break;
+		}
+		if (scratch.node_closed[entry.id] == pass) {
+			continue;
+		}
+		scratch.node_closed[entry.id] = pass;
+
+		const real_t cost = scratch.node_costs[entry.id];
+		if (scratch.goal_passes[entry.id] == pass) {
+			open_node(target, cost + scratch.goal_costs[entry.id], entry.id);
+		}
+
+		const Node &node = nodes[entry.id];
+		const NavBase *owner = _get_polygon(node.polygon).owner;
+		const real_t travel_cost = owner->get_travel_cost();
+		for (uint32_t e = node.first_edge; e < node.first_edge + node.edge_count; e++) {
+			const Edge &edge = edges[e];
+			if (scratch.node_closed[edge.to] == pass) {
+				continue;
+			}
+			const NavBase *to_owner = _get_polygon(nodes[edge.to].polygon).owner;
+			if ((p_navigation_layers & to_owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+			real_t new_cost = cost + edge.distance * travel_cost;
+			if (to_owner != owner) {
+				new_cost += to_owner->get_enter_cost();
+			}
+			open_node(edge.to, new_cost, entry.id);
+		}
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	r_corridor.resize(cluster_count);
+	for (uint8_t &in_corridor : r_corridor) {
+		in_corridor = 0;
+	}
+	r_corridor[begin_cluster] = 1;
+	r_corridor[end_cluster] = 1;
+	for (int32_t node = scratch.node_parents[target]; node >= 0; node = scratch.node_parents[node]) {
+		r_corridor[nodes[node].cluster] = 1;
+	}
+	return true;
+}
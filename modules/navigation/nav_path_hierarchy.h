@@ -0,0 +1,158 @@
+/**************************************************************************/
+/*  nav_path_hierarchy.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_PATH_HIERARCHY_H
+#define NAV_PATH_HIERARCHY_H
+
+#include "nav_utils.h"
+
+#include "core/math/vector3i.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid.h"
+
+/// Abstract graph over the map polygons used to answer long path queries
+/// hierarchically (HPA*).
+///
+/// The polygons of every region are grouped into clusters by spatial cell.
+/// Polygons with connections leaving their cluster are the nodes of the
+/// graph. Nodes of the same cluster are linked by the length of the shortest
+/// route between them inside the cluster, nodes of different clusters by the
+/// map connections (including links). A query searches this graph first and
+/// the polygon search is then limited to the clusters the route went through.
+///
+/// Routes inside a cluster only depend on the polygons of one region, so they
+/// are cached per region and only recomputed when that region changes.
+class NavPathHierarchy {
+public:
+	struct RegionSource {
+		RID region;
+		/// Changes whenever the region rebuilds its polygons.
+		uint32_t polygons_version = 0;
+		/// Range of the region polygons in the map polygons.
+		uint32_t polygon_offset = 0;
+		uint32_t polygon_count = 0;
+	};
+
+private:
+	struct Node {
+		/// Index in the map polygons, link polygons come after them.
+		uint32_t polygon = 0;
+		uint32_t cluster = 0;
+		uint32_t first_edge = 0;
+		uint32_t edge_count = 0;
+	};
+
+	struct Edge {
+		uint32_t to = 0;
+		real_t distance = 0.0;
+	};
+
+	struct RegionCache {
+		uint32_t polygons_version = 0;
+		uint32_t polygon_count = 0;
+		uint32_t cluster_count = 0;
+		bool used = false;
+		/// Cluster of each region polygon.
+		LocalVector<uint32_t> polygon_clusters;
+		/// Region polygons with an edge not shared with their cluster, grouped
+		/// per cluster. Cluster c owns [border_offsets[c], border_offsets[c + 1]).
+		LocalVector<uint32_t> border_polygons;
+		LocalVector<uint32_t> border_offsets;
+		/// Row-major distance matrix between the border polygons of each
+		/// cluster, starting at distance_offsets[c]. FLT_MAX when unreachable.
+		LocalVector<real_t> border_distances;
+		LocalVector<uint32_t> distance_offsets;
+	};
+
+	HashMap<RID, RegionCache> region_caches;
+	real_t cluster_size = 0.0;
+	uint32_t rebuilt_region_count = 0;
+
+	const gd::Polygon *polygons = nullptr;
+	uint32_t polygon_count = 0;
+	const gd::Polygon *link_polygons = nullptr;
+	uint32_t link_polygon_count = 0;
+
+	uint32_t cluster_count = 0;
+	/// Cluster and center of every map and link polygon.
+	LocalVector<uint32_t> polygon_clusters;
+	LocalVector<Vector3> polygon_positions;
+	/// Node of every map and link polygon, or -1.
+	LocalVector<int32_t> polygon_nodes;
+
+	LocalVector<Node> nodes;
+	LocalVector<Edge> edges;
+
+	_FORCE_INLINE_ const gd::Polygon &_get_polygon(uint32_t p_index) const {
+		return p_index < polygon_count ? polygons[p_index] : link_polygons[p_index - polygon_count];
+	}
+	_FORCE_INLINE_ int64_t _get_polygon_index(const gd::Polygon *p_polygon) const {
+		const uintptr_t address = (uintptr_t)p_polygon;
+		if (address >= (uintptr_t)polygons && address < (uintptr_t)(polygons + polygon_count)) {
+			return p_polygon - polygons;
+		}
+		if (address >= (uintptr_t)link_polygons && address < (uintptr_t)(link_polygons + link_polygon_count)) {
+			return polygon_count + (p_polygon - link_polygons);
+		}
+		return -1;
+	}
+
+	void _build_region_cache(RegionCache &r_cache, const RegionSource &p_source);
+	template <typename F>
+	void _search_cluster(uint32_t p_source, F p_settled) const;
+
+public:
+	/// Rebuilds the graph after the map polygons and their connections were
+	/// regenerated. The arrays must stay alive and unchanged until the next
+	/// build, queries keep pointers into them.
+	void build(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, uint32_t p_link_polygon_count, const LocalVector<RegionSource> &p_regions, real_t p_cluster_size);
+	void clear();
+
+	bool is_empty() const { return nodes.is_empty(); }
+	uint32_t get_cluster_count() const { return cluster_count; }
+	uint32_t get_node_count() const { return nodes.size(); }
+	uint32_t get_edge_count() const { return edges.size(); }
+	/// Regions whose cached cluster routes were recomputed by the last build.
+	uint32_t get_rebuilt_region_count() const { return rebuilt_region_count; }
+
+	/// Searches the abstract graph for a route between the clusters of the two
+	/// polygons and sets r_corridor[c] for every cluster it goes through.
+	/// Returns false when both polygons are in the same cluster or no route
+	/// exists, in which case the caller should search all polygons.
+	bool find_corridor(const gd::Polygon *p_begin, const gd::Polygon *p_end, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const;
+
+	_FORCE_INLINE_ bool is_in_corridor(const gd::Polygon *p_polygon, const LocalVector<uint8_t> &p_corridor) const {
+		const int64_t index = _get_polygon_index(p_polygon);
+		return index < 0 || p_corridor[polygon_clusters[index]];
+	}
+};
+
+#endif // NAV_PATH_HIERARCHY_H
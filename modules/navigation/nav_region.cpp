@@ -218,9 +218,49 @@ void NavRegion::update_polygons() {
 	if (!polygons_dirty) {
 		return;
 	}
+	polygons_dirty = false;
+
+	// The map scratches all regions at once when its own settings change,
+	// keep the previous layout so that only regions with different polygons
+	// get a new polygons version.
+	LocalVector<uint32_t> previous_sizes;
+	LocalVector<gd::Point> previous_points;
+	previous_sizes.reserve(polygons.size());
+	for (const gd::Polygon &polygon : polygons) {
+		previous_sizes.push_back(polygon.points.size());
+		for (const gd::Point &point : polygon.points) {
+			previous_points.push_back(point);
+		}
+	}
+
+	_build_polygons();
+
+	bool changed = previous_sizes.size() != polygons.size();
+	uint32_t point_index = 0;
+	for (uint32_t i = 0; i < polygons.size() && !changed; i++) {
+		const LocalVector<gd::Point> &points = polygons[i].points;
+		if (points.size() != previous_sizes[i]) {
+			changed = true;
+			break;
+		}
+		for (const gd::Point &point : points) {
+			const gd::Point &previous_point = previous_points[point_index++];
+			if (point.key.key != previous_point.key.key || point.pos != previous_point.pos) {
+				changed = true;
+				break;
+			}
+		}
+	}
+
+	if (changed) {
+		polygons_version++;
+	}
+}
+
+void NavRegion::_build_polygons() {
 	polygons.clear();
+	face_bvh.clear();
 	surface_area = 0.0;
-	polygons_dirty = false;
 
 	if (map == nullptr) {
 		return;
@@ -295,4 +335,6 @@ void NavRegion::update_polygons() {
 	}
 
 	surface_area = _new_region_surface_area;
+
+	face_bvh.build(polygons);
 }
@@ -32,6 +32,7 @@
 #define NAV_REGION_H
 
 #include "nav_base.h"
+#include "nav_face_bvh.h"
 #include "nav_utils.h"
 
 #include "core/os/rw_lock.h"
@@ -46,9 +47,11 @@ class NavRegion : public NavBase {
 	bool use_edge_connections = true;
 
 	bool polygons_dirty = true;
+	uint32_t polygons_version = 0;
 
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
+	NavFaceBVH face_bvh;
 
 	real_t surface_area = 0.0;
 
@@ -95,6 +98,14 @@ public:
 	LocalVector<gd::Polygon> const &get_polygons() const {
 		return polygons;
 	}
+	/// Incremented every time the rebuilt polygons differ from the previous ones.
+	uint32_t get_polygons_version() const {
+		return polygons_version;
+	}
+
+	const NavFaceBVH &get_face_bvh() const {
+		return face_bvh;
+	}
 
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
 
@@ -104,6 +115,7 @@ public:
 
 private:
 	void update_polygons();
+	void _build_polygons();
 };
 
 #endif // NAV_REGION_H
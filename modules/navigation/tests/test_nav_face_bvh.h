@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  test_nav_face_bvh.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_FACE_BVH_H
+#define TEST_NAV_FACE_BVH_H
+
+#include "../nav_face_bvh.h"
+
+#include "core/math/geometry_3d.h"
+#include "core/math/random_number_generator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavFaceBVH {
+
+// A grid of convex polygons with 3 to 6 points at slightly varying heights.
+static LocalVector<gd::Polygon> make_polygons(Ref<RandomNumberGenerator> &p_rng) {
+	LocalVector<gd::Polygon> polygons;
+	for (int x = 0; x < 30; x++) {
+		for (int z = 0; z < 30; z++) {
+			gd::Polygon polygon;
+			const int point_count = p_rng->randi_range(3, 6);
+			const real_t height = p_rng->randf_range(-1.0, 1.0);
+			for (int i = 0; i < point_count; i++) {
+				const real_t angle = i * Math_TAU / point_count;
+				gd::Point point;
+				point.pos = Vector3(x * 2 + Math::cos(angle), height, z * 2 + Math::sin(angle));
+				polygon.points.push_back(point);
+			}
+			polygons.push_back(polygon);
+		}
+	}
+	return polygons;
+}
+
+TEST_CASE("[Modules][Navigation] Face BVH closest point matches a linear scan") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(17);
+	const LocalVector<gd::Polygon> polygons = make_polygons(rng);
+
+	NavFaceBVH bvh;
+	bvh.build(polygons);
+	REQUIRE_FALSE(bvh.is_empty());
+
+	bool all_match = true;
+	for (int i = 0; i < 500; i++) {
+		const Vector3 point(rng->randf_range(-10, 70), rng->randf_range(-5, 5), rng->randf_range(-10, 70));
+
+		real_t expected_ds = FLT_MAX;
+		for (const gd::Polygon &polygon : polygons) {
+			for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+				const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+				expected_ds = MIN(expected_ds, face.get_closest_point_to(point).distance_squared_to(point));
+			}
+		}
+
+		real_t ds = FLT_MAX;
+		Vector3 closest;
+		const NavFaceBVH::Face *face = bvh.get_closest_face(point, ds, closest);
+		all_match = all_match && face != nullptr && ds == expected_ds;
+	}
+	CHECK(all_match);
+
+	// Nothing is found within a radius that's too small.
+	real_t ds = 0.01;
+	Vector3 closest;
+	CHECK(bvh.get_closest_face(Vector3(1, 50, 1), ds, closest) == nullptr);
+}
+
+TEST_CASE("[Modules][Navigation] Face BVH segment queries match a linear scan") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(23);
+	const LocalVector<gd::Polygon> polygons = make_polygons(rng);
+
+	NavFaceBVH bvh;
+	bvh.build(polygons);
+
+	bool all_match = true;
+	for (int i = 0; i < 200; i++) {
+		const Vector3 from(rng->randf_range(-10, 70), rng->randf_range(-5, 5), rng->randf_range(-10, 70));
+		const Vector3 to = from + Vector3(rng->randf_range(-4, 4), rng->randf_range(-4, 4), rng->randf_range(-4, 4));
+
+		real_t expected_intersection = FLT_MAX;
+		real_t expected_distance = FLT_MAX;
+		for (const gd::Polygon &polygon : polygons) {
+			for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+				const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+				Vector3 intersection;
+				if (face.intersects_segment(from, to, &intersection)) {
+					expected_intersection = MIN(expected_intersection, from.distance_to(intersection));
+				}
+				expected_distance = MIN(expected_distance, from.distance_to(face.get_closest_point_to(from)));
+				expected_distance = MIN(expected_distance, to.distance_to(face.get_closest_point_to(to)));
+			}
+			for (uint32_t point_id = 0; point_id < polygon.points.size(); point_id++) {
+				Vector3 a;
+				Vector3 b;
+				Geometry3D::get_closest_points_between_segments(from, to, polygon.points[point_id].pos, polygon.points[(point_id + 1) % polygon.points.size()].pos, a, b);
+				expected_distance = MIN(expected_distance, a.distance_to(b));
+			}
+		}
+
+		real_t distance = FLT_MAX;
+		Vector3 point;
+		bvh.intersect_segment(from, to, distance, point);
+		all_match = all_match && distance == expected_intersection;
+
+		distance = FLT_MAX;
+		bvh.get_closest_face_to_segment(from, to, distance, point);
+		all_match = all_match && distance == expected_distance;
+	}
+	CHECK(all_match);
+}
+
+} // namespace TestNavFaceBVH
+
+#endif // TEST_NAV_FACE_BVH_H
@@ -0,0 +1,257 @@
+/**************************************************************************/
+/*  test_nav_path_hierarchy.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_PATH_HIERARCHY_H
+#define TEST_NAV_PATH_HIERARCHY_H
+
+#include "../nav_base.h"
+#include "../nav_map.h"
+#include "../nav_path_hierarchy.h"
+#include "../nav_region.h"
+
+#include "scene/resources/navigation_mesh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavPathHierarchy {
+
+class TestNavOwner : public NavBase {};
+
+static const int GRID_SIZE = 48;
+
+static bool is_wall(int p_x, int p_z) {
+	return (p_x % 16 == 8 && p_z % 12 != 3) || (p_z % 20 == 10 && p_x % 11 != 5);
+}
+
+// A grid of unit quads connected to their neighbors, with walls that force
+// detours. Polygons in the left and right halves have different owners.
+static void make_grid(LocalVector<gd::Polygon> &r_polygons, TestNavOwner *p_owners) {
+	r_polygons.resize(GRID_SIZE * GRID_SIZE);
+	for (int z = 0; z < GRID_SIZE; z++) {
+		for (int x = 0; x < GRID_SIZE; x++) {
+			gd::Polygon &polygon = r_polygons[z * GRID_SIZE + x];
+			polygon.owner = &p_owners[x < GRID_SIZE / 2 ? 0 : 1];
+			const Vector3 corners[4] = { Vector3(x, 0, z), Vector3(x + 1, 0, z), Vector3(x + 1, 0, z + 1), Vector3(x, 0, z + 1) };
+			for (int i = 0; i < 4; i++) {
+				gd::Point point;
+				point.pos = corners[i];
+				polygon.points.push_back(point);
+			}
+			polygon.edges.resize(4);
+		}
+	}
+
+	const int offsets[4][2] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+	for (int z = 0; z < GRID_SIZE; z++) {
+		for (int x = 0; x < GRID_SIZE; x++) {
+			if (is_wall(x, z)) {
+				continue;
+			}
+			gd::Polygon &polygon = r_polygons[z * GRID_SIZE + x];
+			for (int i = 0; i < 4; i++) {
+				const int other_x = x + offsets[i][0];
+				const int other_z = z + offsets[i][1];
+				if (other_x < 0 || other_z < 0 || other_x >= GRID_SIZE || other_z >= GRID_SIZE || is_wall(other_x, other_z)) {
+					continue;
+				}
+				gd::Edge::Connection connection;
+				connection.polygon = &r_polygons[other_z * GRID_SIZE + other_x];
+				connection.edge = i;
+				connection.pathway_start = polygon.points[i].pos;
+				connection.pathway_end = polygon.points[(i + 1) % 4].pos;
+				polygon.edges[i].connections.push_back(connection);
+			}
+		}
+	}
+}
+
+static Vector3 get_center(const gd::Polygon &p_polygon) {
+	return (p_polygon.points[0].pos + p_polygon.points[2].pos) * 0.5;
+}
+
+// Length of the shortest route between polygon centers, optionally only
+// through the clusters of a corridor. FLT_MAX when there's no route.
+static real_t get_route_length(const LocalVector<gd::Polygon> &p_polygons, uint32_t p_from, uint32_t p_to, const NavPathHierarchy *p_hierarchy, const LocalVector<uint8_t> *p_corridor) {
+	LocalVector<real_t> lengths;
+	LocalVector<bool> visited;
+	lengths.resize(p_polygons.size());
+	visited.resize(p_polygons.size());
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		lengths[i] = FLT_MAX;
+		visited[i] = false;
+	}
+	lengths[p_from] = 0.0;
+
+	while (true) {
+		int64_t current = -1;
+		for (uint32_t i = 0; i < p_polygons.size(); i++) {
+			if (!visited[i] && lengths[i] != FLT_MAX && (current < 0 || lengths[i] < lengths[current])) {
+				current = i;
+			}
+		}
+		if (current < 0 || uint32_t(current) == p_to) {
+			return lengths[p_to];
+		}
+		visited[current] = true;
+
+		for (const gd::Edge &edge : p_polygons[current].edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				if (p_corridor && !p_hierarchy->is_in_corridor(connection.polygon, *p_corridor)) {
+					continue;
+				}
+				const uint32_t other = connection.polygon - p_polygons.ptr();
+				const Vector3 pathway_center = (connection.pathway_start + connection.pathway_end) * 0.5;
+				const real_t length = lengths[current] + get_center(p_polygons[current]).distance_to(pathway_center) + pathway_center.distance_to(get_center(p_polygons[other]));
+				lengths[other] = MIN(lengths[other], length);
+			}
+		}
+	}
+}
+
+TEST_CASE("[Modules][Navigation] Path hierarchy corridors contain the shortest route") {
+	TestNavOwner owners[2];
+	LocalVector<gd::Polygon> polygons;
+	make_grid(polygons, owners);
+	LocalVector<gd::Polygon> link_polygons;
+
+	LocalVector<NavPathHierarchy::RegionSource> regions;
+	NavPathHierarchy::RegionSource region;
+	region.region = RID::from_uint64(1);
+	region.polygons_version = 1;
+	region.polygon_count = polygons.size();
+	regions.push_back(region);
+
+	NavPathHierarchy hierarchy;
+	hierarchy.build(polygons, link_polygons, 0, regions, 8.0);
+	CHECK(hierarchy.get_cluster_count() == 36);
+	CHECK(hierarchy.get_node_count() > 0);
+	CHECK(hierarchy.get_rebuilt_region_count() == 1);
+
+	// Polygons of the same cluster are left to the regular search.
+	LocalVector<uint8_t> corridor;
+	CHECK_FALSE(hierarchy.find_corridor(&polygons[0], &polygons[GRID_SIZE + 1], get_center(polygons[GRID_SIZE + 1]), 1, corridor));
+
+	int corridor_count = 0;
+	bool routes_match = true;
+	for (uint32_t i = 0; i < 60; i++) {
+		const uint32_t from = (i * 7919) % polygons.size();
+		const uint32_t to = (i * 104729 + 1237) % polygons.size();
+		if (is_wall(from % GRID_SIZE, from / GRID_SIZE) || is_wall(to % GRID_SIZE, to / GRID_SIZE)) {
+			continue;
+		}
+		if (!hierarchy.find_corridor(&polygons[from], &polygons[to], get_center(polygons[to]), 1, corridor)) {
+			continue;
+		}
+		corridor_count++;
+
+		const real_t length = get_route_length(polygons, from, to, nullptr, nullptr);
+		const real_t corridor_length = get_route_length(polygons, from, to, &hierarchy, &corridor);
+		routes_match = routes_match && corridor_length != FLT_MAX && Math::is_equal_approx(length, corridor_length);
+	}
+	CHECK(corridor_count > 30);
+	CHECK(routes_match);
+
+	// Regions that don't share the query layers are avoided.
+	owners[1].set_navigation_layers(2);
+	CHECK_FALSE(hierarchy.find_corridor(&polygons[0], &polygons[GRID_SIZE * GRID_SIZE - 1], get_center(polygons[GRID_SIZE * GRID_SIZE - 1]), 1, corridor));
+}
+
+TEST_CASE("[Modules][Navigation] Path hierarchy only rebuilds changed regions") {
+	TestNavOwner owners[2];
+	LocalVector<gd::Polygon> polygons;
+	make_grid(polygons, owners);
+	LocalVector<gd::Polygon> link_polygons;
+
+	// Split the grid into two regions of rows.
+	LocalVector<NavPathHierarchy::RegionSource> regions;
+	for (uint32_t i = 0; i < 2; i++) {
+		NavPathHierarchy::RegionSource region;
+		region.region = RID::from_uint64(i + 1);
+		region.polygons_version = 1;
+		region.polygon_offset = i * polygons.size() / 2;
+		region.polygon_count = polygons.size() / 2;
+		regions.push_back(region);
+	}
+
+	NavPathHierarchy hierarchy;
+	hierarchy.build(polygons, link_polygons, 0, regions, 8.0);
+	CHECK(hierarchy.get_rebuilt_region_count() == 2);
+	const uint32_t node_count = hierarchy.get_node_count();
+	const uint32_t edge_count = hierarchy.get_edge_count();
+
+	hierarchy.build(polygons, link_polygons, 0, regions, 8.0);
+	CHECK(hierarchy.get_rebuilt_region_count() == 0);
+	CHECK(hierarchy.get_node_count() == node_count);
+	CHECK(hierarchy.get_edge_count() == edge_count);
+
+	regions[1].polygons_version = 2;
+	hierarchy.build(polygons, link_polygons, 0, regions, 8.0);
+	CHECK(hierarchy.get_rebuilt_region_count() == 1);
+	CHECK(hierarchy.get_node_count() == node_count);
+	CHECK(hierarchy.get_edge_count() == edge_count);
+
+	// A new cluster size invalidates everything.
+	hierarchy.build(polygons, link_polygons, 0, regions, 12.0);
+	CHECK(hierarchy.get_rebuilt_region_count() == 2);
+	CHECK(hierarchy.get_cluster_count() == 16);
+}
+
+TEST_CASE("[Modules][Navigation] Region polygons version only changes with the polygons") {
+	// The project settings read by the map are only registered by the navigation server.
+	ERR_PRINT_OFF;
+	NavMap map;
+	ERR_PRINT_ON;
+	NavRegion region;
+	region.set_map(&map);
+
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	navigation_mesh->set_vertices(PackedVector3Array({ Vector3(0, 0, 0), Vector3(0, 0, 4), Vector3(4, 0, 4), Vector3(4, 0, 0) }));
+	navigation_mesh->add_polygon(Vector<int>({ 0, 1, 2, 3 }));
+	region.set_navigation_mesh(navigation_mesh);
+	region.sync();
+	CHECK(region.get_polygons().size() == 1);
+	const uint32_t version = region.get_polygons_version();
+
+	// The map scratches every region when its own settings change.
+	region.scratch_polygons();
+	CHECK(region.sync());
+	CHECK(region.get_polygons_version() == version);
+
+	region.set_transform(Transform3D(Basis(), Vector3(1, 0, 0)));
+	region.sync();
+	CHECK(region.get_polygons_version() != version);
+
+	region.set_map(nullptr);
+}
+
+} // namespace TestNavPathHierarchy
+
+#endif // TEST_NAV_PATH_HIERARCHY_H
@@ -548,52 +548,7 @@ Projection RaycastOcclusionCull::_jitter_projection(const Projection &p_cam_proj
 		return p_cam_projection;
 	}
 
-	Projection p = p_cam_projection;
-
-	int32_t frame = Engine::get_singleton()->get_frames_drawn();
-	frame %= 9;
-
-	Vector2 jitter;
-
-	switch (frame) {
-		default:
-			break;
-		case 1: {
-			jitter = Vector2(-1, -1);
-		} break;
-		case 2: {
-			jitter = Vector2(1, -1);
-		} break;
-		case 3: {
-			jitter = Vector2(-1, 1);
-		} break;
-		case 4: {
-			jitter = Vector2(1, 1);
-		} break;
-		case 5: {
-			jitter = Vector2(-0.5f, -0.5f);
-		} break;
-		case 6: {
-			jitter = Vector2(0.5f, -0.5f);
-		} break;
-		case 7: {
-			jitter = Vector2(-0.5f, 0.5f);
-		} break;
-		case 8: {
-			jitter = Vector2(0.5f, 0.5f);
-		} break;
-	}
-
-	// The multiplier here determines the divergence from center,
-	// and is to some extent a balancing act.
-	// Higher divergence gives fewer false hidden, but more false shown.
-	// False hidden is obvious to viewer, false shown is not.
-	// False shown can lower percentage that are occluded, and therefore performance.
-	jitter *= Vector2(1 / (float)p_viewport_size.x, 1 / (float)p_viewport_size.y) * 0.05f;
-
-	p.add_jitter_offset(jitter);
-
-	return p;
+	return _get_jittered_projection(p_cam_projection, p_viewport_size);
 }
 
 void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
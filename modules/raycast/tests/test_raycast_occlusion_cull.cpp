@@ -0,0 +1,145 @@
+/**************************************************************************/
+/*  test_raycast_occlusion_cull.cpp                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "test_raycast_occlusion_cull.h"
+
+#include "../raycast_occlusion_cull.h"
+
+#include "core/os/os.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+
+namespace TestRaycastOcclusionCull {
+
+static const int FRAME_COUNT = 50;
+
+static void _add_buildings(RendererSceneOcclusionCull *p_occlusion_cull, RID p_scenario, int p_building_count, RID &r_occluder) {
+	const Vector3 corners[8] = {
+		Vector3(-1, 0, -1), Vector3(1, 0, -1), Vector3(1, 0, 1), Vector3(-1, 0, 1),
+		Vector3(-1, 1, -1), Vector3(1, 1, -1), Vector3(1, 1, 1), Vector3(-1, 1, 1)
+	};
+	const int32_t faces[36] = {
+		0, 1, 5, 0, 5, 4, 1, 2, 6, 1, 6, 5, 2, 3, 7, 2, 7, 6,
+		3, 0, 4, 3, 4, 7, 4, 5, 6, 4, 6, 7, 3, 2, 1, 3, 1, 0
+	};
+	PackedVector3Array vertices;
+	PackedInt32Array indices;
+	for (int i = 0; i < 8; i++) {
+		vertices.push_back(corners[i]);
+	}
+	for (int i = 0; i < 36; i++) {
+		indices.push_back(faces[i]);
+	}
+
+	r_occluder = p_occlusion_cull->occluder_allocate();
+	p_occlusion_cull->occluder_initialize(r_occluder);
+	p_occlusion_cull->occluder_set_mesh(r_occluder, vertices, indices);
+
+	// Buildings along streets going away from the camera.
+	const int side = MAX(1, (int)Math::sqrt((double)p_building_count));
+	for (int i = 0; i < p_building_count; i++) {
+		const real_t x = (i % side - side / 2) * 6.0;
+		const real_t z = -(i / side) * 6.0 - 8.0;
+		const real_t height = 2.0 + (i * 7919 % 13);
+		const Transform3D xform(Basis().scaled(Vector3(2.0, height, 2.0)), Vector3(x, -2.0, z));
+		p_occlusion_cull->scenario_set_instance(p_scenario, RID::from_uint64(100 + i), r_occluder, xform, true);
+	}
+}
+
+static uint64_t _update_buffer(RendererSceneOcclusionCull *p_occlusion_cull, RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	// Embree builds the scene on a thread, give it time before measuring.
+	for (int i = 0; i < 10; i++) {
+		p_occlusion_cull->buffer_update(p_buffer, p_cam_transform, p_cam_projection, false);
+		OS::get_singleton()->delay_usec(10000);
+	}
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < FRAME_COUNT; i++) {
+		p_occlusion_cull->buffer_update(p_buffer, p_cam_transform, p_cam_projection, false);
+	}
+	return (OS::get_singleton()->get_ticks_usec() - begin) / FRAME_COUNT;
+}
+
+void compare_with_raster_occlusion_cull(int p_building_count, const Vector2i &p_buffer_size) {
+	RendererSceneOcclusionCull *occlusion_culls[2] = { memnew(RaycastOcclusionCull), memnew(RasterOcclusionCull) };
+	const RID scenario = RID::from_uint64(1);
+	const RID buffer = RID::from_uint64(2);
+	RID occluders[2];
+
+	const Transform3D cam_transform(Basis(Vector3(1, 0, 0), -0.1), Vector3(1.0, 1.5, 0.0));
+	const Projection projection = Projection::create_perspective(75.0, (real_t)p_buffer_size.x / p_buffer_size.y, 0.05, 500.0);
+	uint64_t update_usec[2];
+
+	for (int i = 0; i < 2; i++) {
+		occlusion_culls[i]->add_scenario(scenario);
+		_add_buildings(occlusion_culls[i], scenario, p_building_count, occluders[i]);
+		occlusion_culls[i]->add_buffer(buffer);
+		occlusion_culls[i]->buffer_set_scenario(buffer, scenario);
+		occlusion_culls[i]->buffer_set_size(buffer, p_buffer_size);
+		update_usec[i] = _update_buffer(occlusion_culls[i], buffer, cam_transform, projection);
+	}
+
+	const RendererSceneOcclusionCull::HZBuffer *hz_buffers[2] = { occlusion_culls[0]->buffer_get_ptr(buffer), occlusion_culls[1]->buffer_get_ptr(buffer) };
+	const Transform3D cam_inv_transform = cam_transform.affine_inverse();
+	int probe_count = 0;
+	int occluded_count = 0;
+	int matching_count = 0;
+	for (int z = 0; z < 60; z++) {
+		for (int x = -30; x < 30; x++) {
+			const Vector3 center(x * 1.7, 0.5, -z * 3.1 - 5.0);
+			const Vector3 min = center - Vector3(0.4, 0.4, 0.4);
+			const Vector3 max = center + Vector3(0.4, 0.4, 0.4);
+			const real_t bounds[6] = { min.x, min.y, min.z, max.x, max.y, max.z };
+			uint64_t timeouts[2] = { 0, 0 };
+			const bool embree_occluded = hz_buffers[0]->is_occluded(bounds, cam_transform.origin, cam_inv_transform, projection, projection.get_z_near(), timeouts[0]);
+			const bool raster_occluded = hz_buffers[1]->is_occluded(bounds, cam_transform.origin, cam_inv_transform, projection, projection.get_z_near(), timeouts[1]);
+			probe_count++;
+			occluded_count += embree_occluded;
+			matching_count += embree_occluded == raster_occluded;
+		}
+	}
+
+	MESSAGE(p_building_count, " buildings at ", p_buffer_size.x, "x", p_buffer_size.y, ": Embree ", update_usec[0], " usec, raster ", update_usec[1], " usec per update. ",
+			occluded_count, " of ", probe_count, " probes occluded, ", matching_count, " agree.");
+	CHECK(occluded_count > 0);
+	CHECK(matching_count >= probe_count * 0.97);
+
+	for (int i = 0; i < 2; i++) {
+		for (int j = 0; j < p_building_count; j++) {
+			occlusion_culls[i]->scenario_remove_instance(scenario, RID::from_uint64(100 + j));
+		}
+		occlusion_culls[i]->remove_buffer(buffer);
+		occlusion_culls[i]->remove_scenario(scenario);
+		occlusion_culls[i]->free_occluder(occluders[i]);
+	}
+	memdelete(occlusion_culls[1]);
+	memdelete(occlusion_culls[0]);
+}
+
+} // namespace TestRaycastOcclusionCull
@@ -0,0 +1,52 @@
+/**************************************************************************/
+/*  test_raycast_occlusion_cull.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RAYCAST_OCCLUSION_CULL_H
+#define TEST_RAYCAST_OCCLUSION_CULL_H
+
+#include "core/math/vector2i.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRaycastOcclusionCull {
+
+// Renders the same city of box occluders with Embree and with the software
+// rasterizer, and compares the occlusion of a grid of probe boxes.
+void compare_with_raster_occlusion_cull(int p_building_count, const Vector2i &p_buffer_size);
+
+TEST_CASE("[Modules][Raycast][Benchmark] Compare with the software occlusion rasterizer" * doctest::skip()) {
+	compare_with_raster_occlusion_cull(100, Vector2i(256, 144));
+	compare_with_raster_occlusion_cull(1000, Vector2i(512, 288));
+	compare_with_raster_occlusion_cull(5000, Vector2i(512, 288));
+}
+
+} // namespace TestRaycastOcclusionCull
+
+#endif // TEST_RAYCAST_OCCLUSION_CULL_H
@@ -82,17 +82,35 @@ void Node3D::_notify_dirty() {
 	}
 }
 
+Transform3D Node3D::_get_local_transform() const {
+	if (data.transform_index >= 0) {
+		return data.transform_store->get_local_transform(data.transform_index);
+	}
+	return data.local_transform;
+}
+
+void Node3D::_set_local_transform(const Transform3D &p_transform) const {
+	if (data.transform_index >= 0) {
+		data.transform_store->set_local_transform(data.transform_index, p_transform);
+	} else {
+		data.local_transform = p_transform;
+	}
+}
+
 void Node3D::_update_local_transform() const {
-	// This function is called when the local transform (data.local_transform) is dirty and the right value is contained in the Euler rotation and scale.
-	data.local_transform.basis.set_euler_scale(data.euler_rotation, data.scale, data.euler_rotation_order);
+	// This function is called when the local transform (data.local_transform, or its slot in the transform store) is dirty and the right value is contained in the Euler rotation and scale.
+	Transform3D local_transform = _get_local_transform();
+	local_transform.basis.set_euler_scale(data.euler_rotation, data.scale, data.euler_rotation_order);
+	_set_local_transform(local_transform);
 	_clear_dirty_bits(DIRTY_LOCAL_TRANSFORM);
 }
 
 void Node3D::_update_rotation_and_scale() const {
 	// This function is called when the Euler rotation (data.euler_rotation) is dirty and the right value is contained in the local transform
 
-	data.scale = data.local_transform.basis.get_scale();
-	data.euler_rotation = data.local_transform.basis.get_euler_normalized(data.euler_rotation_order);
+	const Basis basis = _get_local_transform().basis;
+	data.scale = basis.get_scale();
+	data.euler_rotation = basis.get_euler_normalized(data.euler_rotation_order);
 	_clear_dirty_bits(DIRTY_EULER_ROTATION_AND_SCALE);
 }
 
@@ -102,11 +120,32 @@ void Node3D::_propagate_transform_changed_deferred() {
 	}
 }
 
+void Node3D::_queue_transform_notification() {
+	if (xform_change.in_list()) {
+		return;
+	}
+	if (likely(is_accessible_from_caller_thread())) {
+		get_tree()->xform_change_list.add(&xform_change);
+	} else {
+		// This should very rarely happen, but if it does at least make sure the notification is received eventually.
+		callable_mp(this, &Node3D::_propagate_transform_changed_deferred).call_deferred();
+	}
+}
+
 void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 	if (!is_inside_tree()) {
 		return;
 	}
 
+	if (data.transform_index >= 0) {
+		if (_test_dirty_bits(DIRTY_LOCAL_TRANSFORM)) {
+			// The store recomputes global transforms on its own, so it must always hold a valid local transform.
+			_update_local_transform();
+		}
+		data.transform_store->invalidate(data.transform_index);
+		return;
+	}
+
 	for (Node3D *&E : data.children) {
 		if (E->data.top_level) {
 			continue; //don't propagate to a top_level
@@ -114,20 +153,56 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		E->_propagate_transform_changed(p_origin);
 	}
 #ifdef TOOLS_ENABLED
-	if ((!data.gizmos.is_empty() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
+	if ((!data.gizmos.is_empty() || data.notify_transform) && !data.ignore_notification) {
 #else
-	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
+	if (data.notify_transform && !data.ignore_notification) {
 #endif
-		if (likely(is_accessible_from_caller_thread())) {
-			get_tree()->xform_change_list.add(&xform_change);
-		} else {
-			// This should very rarely happen, but if it does at least make sure the notification is received eventually.
-			callable_mp(this, &Node3D::_propagate_transform_changed_deferred).call_deferred();
-		}
+		_queue_transform_notification();
 	}
 	_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM);
 }
 
+void Node3D::_add_to_transform_store() {
+	Node3DTransformStore *store = get_tree()->get_transform_store_3d();
+	if (!store || (data.parent && data.parent->data.transform_index < 0)) {
+		return;
+	}
+
+	if (_test_dirty_bits(DIRTY_LOCAL_TRANSFORM)) {
+		_update_local_transform();
+	}
+	data.transform_store = store;
+	data.transform_index = store->add(this, data.parent ? data.parent->data.transform_index : -1, data.local_transform);
+	store->set_flag(data.transform_index, Node3DTransformStore::FLAG_TOP_LEVEL, data.top_level);
+	store->set_flag(data.transform_index, Node3DTransformStore::FLAG_DISABLE_SCALE, data.disable_scale);
+	_update_transform_store_notify();
+}
+
+void Node3D::_remove_from_transform_store() {
+	if (data.transform_index < 0) {
+		return;
+	}
+
+	// Keep the transforms around for use outside of the tree.
+	data.local_transform = data.transform_store->get_local_transform(data.transform_index);
+	data.global_transform = data.transform_store->get_global_transform(data.transform_index);
+	data.transform_store->remove(data.transform_index);
+	data.transform_store = nullptr;
+	data.transform_index = -1;
+}
+
+void Node3D::_update_transform_store_notify() {
+	if (data.transform_index < 0) {
+		return;
+	}
+#ifdef TOOLS_ENABLED
+	bool notify = (!data.gizmos.is_empty() || data.notify_transform) && !data.ignore_notification;
+#else
+	bool notify = data.notify_transform && !data.ignore_notification;
+#endif
+	data.transform_store->set_flag(data.transform_index, Node3DTransformStore::FLAG_NOTIFY, notify);
+}
+
 void Node3D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_ENTER_TREE: {
@@ -148,14 +223,15 @@ void Node3D::_notification(int p_what) {
 			if (data.top_level && !Engine::get_singleton()->is_editor_hint()) {
 				if (data.parent) {
 					if (!data.top_level) {
-						data.local_transform = data.parent->get_global_transform() * get_transform();
+						_set_local_transform(data.parent->get_global_transform() * get_transform());
 					} else {
-						data.local_transform = get_transform();
+						_set_local_transform(get_transform());
 					}
 					_replace_dirty_mask(DIRTY_EULER_ROTATION_AND_SCALE); // As local transform was updated, rot/scale should be dirty.
 				}
 			}
 
+			_add_to_transform_store();
 			_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM); // Global is always dirty upon entering a scene.
 			_notify_dirty();
 
@@ -170,6 +246,7 @@ void Node3D::_notification(int p_what) {
 			if (xform_change.in_list()) {
 				get_tree()->xform_change_list.remove(&xform_change);
 			}
+			_remove_from_transform_store();
 			if (data.C) {
 				data.parent->data.children.erase(data.C);
 			}
@@ -232,19 +309,21 @@ void Node3D::_notification(int p_what) {
 void Node3D::set_basis(const Basis &p_basis) {
 	ERR_THREAD_GUARD;
 
-	set_transform(Transform3D(p_basis, data.local_transform.origin));
+	set_transform(Transform3D(p_basis, _get_local_transform().origin));
 }
 void Node3D::set_quaternion(const Quaternion &p_quaternion) {
 	ERR_THREAD_GUARD;
 
 	if (_test_dirty_bits(DIRTY_EULER_ROTATION_AND_SCALE)) {
 		// We need the scale part, so if these are dirty, update it
-		data.scale = data.local_transform.basis.get_scale();
+		data.scale = _get_local_transform().basis.get_scale();
 		_clear_dirty_bits(DIRTY_EULER_ROTATION_AND_SCALE);
 	}
-	data.local_transform.basis = Basis(p_quaternion, data.scale);
+	Transform3D local_transform = _get_local_transform();
+	local_transform.basis = Basis(p_quaternion, data.scale);
+	_set_local_transform(local_transform);
 	// Rotscale should not be marked dirty because that would cause precision loss issues with the scale. Instead reconstruct rotation now.
-	data.euler_rotation = data.local_transform.basis.get_euler_normalized(data.euler_rotation_order);
+	data.euler_rotation = local_transform.basis.get_euler_normalized(data.euler_rotation_order);
 
 	_replace_dirty_mask(DIRTY_NONE);
 
@@ -304,7 +383,7 @@ void Node3D::set_global_rotation_degrees(const Vector3 &p_euler_degrees) {
 
 void Node3D::set_transform(const Transform3D &p_transform) {
 	ERR_THREAD_GUARD;
-	data.local_transform = p_transform;
+	_set_local_transform(p_transform);
 	_replace_dirty_mask(DIRTY_EULER_ROTATION_AND_SCALE); // Make rot/scale dirty.
 
 	_propagate_transform_changed(this);
@@ -338,7 +417,7 @@ Transform3D Node3D::get_transform() const {
 		_update_local_transform();
 	}
 
-	return data.local_transform;
+	return _get_local_transform();
 }
 
 Transform3D Node3D::get_global_transform() const {
@@ -349,6 +428,10 @@ Transform3D Node3D::get_global_transform() const {
 	 * the dirty/update process is thread safe by utilizing atomic copies.
 	 */
 
+	if (data.transform_index >= 0) {
+		return data.transform_store->get_global_transform(data.transform_index);
+	}
+
 	uint32_t dirty = _read_dirty_mask();
 	if (dirty & DIRTY_GLOBAL_TRANSFORM) {
 		if (dirty & DIRTY_LOCAL_TRANSFORM) {
@@ -357,9 +440,9 @@ Transform3D Node3D::get_global_transform() const {
 
 		Transform3D new_global;
 		if (data.parent && !data.top_level) {
-			new_global = data.parent->get_global_transform() * data.local_transform;
+			new_global = data.parent->get_global_transform() * _get_local_transform();
 		} else {
-			new_global = data.local_transform;
+			new_global = _get_local_transform();
 		}
 
 		if (data.disable_scale) {
@@ -409,7 +492,9 @@ Transform3D Node3D::get_relative_transform(const Node *p_parent) const {
 
 void Node3D::set_position(const Vector3 &p_position) {
 	ERR_THREAD_GUARD;
-	data.local_transform.origin = p_position;
+	Transform3D local_transform = _get_local_transform();
+	local_transform.origin = p_position;
+	_set_local_transform(local_transform);
 	_propagate_transform_changed(this);
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
@@ -424,7 +509,9 @@ void Node3D::set_rotation_edit_mode(RotationEditMode p_mode) {
 
 	bool transform_changed = false;
 	if (data.rotation_edit_mode == ROTATION_EDIT_MODE_BASIS && !_test_dirty_bits(DIRTY_LOCAL_TRANSFORM)) {
-		data.local_transform.orthogonalize();
+		Transform3D local_transform = _get_local_transform();
+		local_transform.orthogonalize();
+		_set_local_transform(local_transform);
 		transform_changed = true;
 	}
 
@@ -492,7 +579,7 @@ void Node3D::set_rotation(const Vector3 &p_euler_rad) {
 	ERR_THREAD_GUARD;
 	if (_test_dirty_bits(DIRTY_EULER_ROTATION_AND_SCALE)) {
 		// Update scale only if rotation and scale are dirty, as rotation will be overridden.
-		data.scale = data.local_transform.basis.get_scale();
+		data.scale = _get_local_transform().basis.get_scale();
 		_clear_dirty_bits(DIRTY_EULER_ROTATION_AND_SCALE);
 	}
 
@@ -514,7 +601,7 @@ void Node3D::set_scale(const Vector3 &p_scale) {
 	ERR_THREAD_GUARD;
 	if (_test_dirty_bits(DIRTY_EULER_ROTATION_AND_SCALE)) {
 		// Update rotation only if rotation and scale are dirty, as scale will be overridden.
-		data.euler_rotation = data.local_transform.basis.get_euler_normalized(data.euler_rotation_order);
+		data.euler_rotation = _get_local_transform().basis.get_euler_normalized(data.euler_rotation_order);
 		_clear_dirty_bits(DIRTY_EULER_ROTATION_AND_SCALE);
 	}
 
@@ -528,7 +615,7 @@ void Node3D::set_scale(const Vector3 &p_scale) {
 
 Vector3 Node3D::get_position() const {
 	ERR_READ_THREAD_GUARD_V(Vector3());
-	return data.local_transform.origin;
+	return _get_local_transform().origin;
 }
 
 Vector3 Node3D::get_rotation() const {
@@ -611,6 +698,7 @@ void Node3D::add_gizmo(Ref<Node3DGizmo> p_gizmo) {
 		return;
 	}
 	data.gizmos.push_back(p_gizmo);
+	_update_transform_store_notify();
 
 	if (p_gizmo.is_valid() && is_inside_world()) {
 		p_gizmo->create();
@@ -629,6 +717,7 @@ void Node3D::remove_gizmo(Ref<Node3DGizmo> p_gizmo) {
 	if (idx != -1) {
 		p_gizmo->free();
 		data.gizmos.remove_at(idx);
+		_update_transform_store_notify();
 	}
 #endif
 }
@@ -640,6 +729,7 @@ void Node3D::clear_gizmos() {
 		data.gizmos.write[i]->free();
 	}
 	data.gizmos.clear();
+	_update_transform_store_notify();
 #endif
 }
 
@@ -730,6 +820,9 @@ void Node3D::reparent(Node *p_parent, bool p_keep_global_transform) {
 void Node3D::set_disable_scale(bool p_enabled) {
 	ERR_THREAD_GUARD;
 	data.disable_scale = p_enabled;
+	if (data.transform_index >= 0) {
+		data.transform_store->set_flag(data.transform_index, Node3DTransformStore::FLAG_DISABLE_SCALE, p_enabled);
+	}
 }
 
 bool Node3D::is_scale_disabled() const {
@@ -750,6 +843,9 @@ void Node3D::set_as_top_level(bool p_enabled) {
 		}
 	}
 	data.top_level = p_enabled;
+	if (data.transform_index >= 0) {
+		data.transform_store->set_flag(data.transform_index, Node3DTransformStore::FLAG_TOP_LEVEL, p_enabled);
+	}
 }
 
 void Node3D::set_as_top_level_keep_local(bool p_enabled) {
@@ -758,6 +854,9 @@ void Node3D::set_as_top_level_keep_local(bool p_enabled) {
 		return;
 	}
 	data.top_level = p_enabled;
+	if (data.transform_index >= 0) {
+		data.transform_store->set_flag(data.transform_index, Node3DTransformStore::FLAG_TOP_LEVEL, p_enabled);
+	}
 	_propagate_transform_changed(this);
 }
 
@@ -967,6 +1066,7 @@ Vector3 Node3D::to_global(Vector3 p_local) const {
 void Node3D::set_notify_transform(bool p_enabled) {
 	ERR_THREAD_GUARD;
 	data.notify_transform = p_enabled;
+	_update_transform_store_notify();
 }
 
 bool Node3D::is_transform_notification_enabled() const {
@@ -31,6 +31,7 @@
 #ifndef NODE_3D_H
 #define NODE_3D_H
 
+#include "scene/3d/node_3d_transform_store.h"
 #include "scene/main/node.h"
 #include "scene/resources/3d/world_3d.h"
 
@@ -51,6 +52,8 @@ public:
 class Node3D : public Node {
 	GDCLASS(Node3D, Node);
 
+	friend class Node3DTransformStore;
+
 public:
 	// Edit mode for the rotation.
 	// THIS MODE ONLY AFFECTS HOW DATA IS EDITED AND SAVED
@@ -99,6 +102,12 @@ private:
 
 		mutable MTNumeric<uint32_t> dirty;
 
+		// When the SceneTree has a transform store, the transforms of the node live
+		// there while it's inside the tree, and local_transform and global_transform
+		// are only used while outside of it.
+		Node3DTransformStore *transform_store = nullptr;
+		int32_t transform_index = -1;
+
 		Viewport *viewport = nullptr;
 
 		bool top_level = false;
@@ -136,8 +145,15 @@ private:
 
 	void _update_gizmos();
 	void _notify_dirty();
+	void _queue_transform_notification();
 	void _propagate_transform_changed(Node3D *p_origin);
 
+	void _add_to_transform_store();
+	void _remove_from_transform_store();
+	void _update_transform_store_notify();
+	_FORCE_INLINE_ Transform3D _get_local_transform() const;
+	_FORCE_INLINE_ void _set_local_transform(const Transform3D &p_transform) const;
+
 	void _propagate_visibility_changed();
 
 	void _propagate_visibility_parent();
@@ -145,7 +161,12 @@ private:
 	void _propagate_transform_changed_deferred();
 
 protected:
-	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) { data.ignore_notification = p_ignore; }
+	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) {
+		data.ignore_notification = p_ignore;
+		if (data.transform_index >= 0) {
+			_update_transform_store_notify();
+		}
+	}
 
 	_FORCE_INLINE_ void _update_local_transform() const;
 	_FORCE_INLINE_ void _update_rotation_and_scale() const;
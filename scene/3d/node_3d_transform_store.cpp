@@ -0,0 +1,263 @@
+/**************************************************************************/
+/*  node_3d_transform_store.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "node_3d_transform_store.h"
+
+#include "scene/3d/node_3d.h"
+
+uint32_t Node3DTransformStore::add(Node3D *p_node, int32_t p_parent, const Transform3D &p_local_transform) {
+	const uint32_t index = nodes.size();
+	ERR_FAIL_COND_V(p_parent >= int32_t(index), index);
+
+	nodes.push_back(p_node);
+	parents.push_back(p_parent);
+	local_transforms.push_back(p_local_transform);
+	global_transforms.push_back(p_local_transform);
+	subtree_ends.push_back(index + 1);
+	flags.push_back(FLAG_GLOBAL_DIRTY);
+	pending_update.set();
+
+	// Nodes enter the tree parent first, so the order stays valid as long as
+	// the parent's subtree is the last one in the arrays.
+	if (!order_dirty) {
+		for (int32_t ancestor = p_parent; ancestor >= 0; ancestor = parents[ancestor]) {
+			if (subtree_ends[ancestor] != index) {
+				order_dirty = true;
+				break;
+			}
+			subtree_ends[ancestor] = index + 1;
+		}
+	}
+
+	return index;
+}
+
+void Node3DTransformStore::remove(uint32_t p_index) {
+	ERR_FAIL_UNSIGNED_INDEX(p_index, nodes.size());
+
+	// Children always leave the tree before their parent, so no live slot refers
+	// to this one anymore. The hole stays inside the subtree ranges until the
+	// next rebuild, which is harmless.
+	nodes[p_index] = nullptr;
+	flags[p_index] = 0;
+	free_slots++;
+}
+
+void Node3DTransformStore::_mark_dirty(uint32_t p_index) {
+	_set_flag_bits(p_index, FLAG_GLOBAL_DIRTY);
+	if (_get_flags(p_index) & FLAG_NOTIFY) {
+		nodes[p_index]->_queue_transform_notification();
+	}
+}
+
+void Node3DTransformStore::_invalidate_hierarchy(uint32_t p_index) {
+	_mark_dirty(p_index);
+	for (Node3D *child : nodes[p_index]->data.children) {
+		if (child->data.top_level) {
+			continue;
+		}
+		if (child->data.transform_index < 0) {
+			child->_propagate_transform_changed(child);
+		} else {
+			_invalidate_hierarchy(child->data.transform_index);
+		}
+	}
+}
+
+void Node3DTransformStore::invalidate(uint32_t p_index) {
+	pending_update.set();
+	if (order_dirty) {
+		_invalidate_hierarchy(p_index);
+		return;
+	}
+
+	_mark_dirty(p_index);
+	const uint32_t end = subtree_ends[p_index];
+	for (uint32_t i = p_index + 1; i < end; i++) {
+		if (_get_flags(i) & FLAG_TOP_LEVEL) {
+			i = subtree_ends[i] - 1; // Don't propagate to a top-level node.
+			continue;
+		}
+		_mark_dirty(i);
+	}
+}
+
+void Node3DTransformStore::_compute_global_transform(uint32_t p_index) {
+	const uint8_t slot_flags = _get_flags(p_index);
+	const int32_t parent = parents[p_index];
+	if (parent >= 0 && !(slot_flags & FLAG_TOP_LEVEL)) {
+		global_transforms[p_index] = get_global_transform(parent) * local_transforms[p_index];
+	} else {
+		global_transforms[p_index] = local_transforms[p_index];
+	}
+	if (slot_flags & FLAG_DISABLE_SCALE) {
+		global_transforms[p_index].basis.orthonormalize();
+	}
+	_clear_flag_bits(p_index, FLAG_GLOBAL_DIRTY);
+}
+
+Transform3D Node3DTransformStore::_calculate_global_transform(uint32_t p_index) const {
+	const uint8_t slot_flags = _get_flags(p_index);
+	if (!(slot_flags & FLAG_GLOBAL_DIRTY)) {
+		return global_transforms[p_index];
+	}
+	Transform3D global;
+	const int32_t parent = parents[p_index];
+	if (parent >= 0 && !(slot_flags & FLAG_TOP_LEVEL)) {
+		global = _calculate_global_transform(parent) * local_transforms[p_index];
+	} else {
+		global = local_transforms[p_index];
+	}
+	if (slot_flags & FLAG_DISABLE_SCALE) {
+		global.basis.orthonormalize();
+	}
+	return global;
+}
+
+void Node3DTransformStore::update_global_transforms() {
+	if (order_dirty || (free_slots > 64 && free_slots * 4 > nodes.size())) {
+		_rebuild_order();
+	}
+	if (!pending_update.is_set()) {
+		return;
+	}
+	pending_update.clear();
+
+	// Parents are always stored before their children, so a single forward pass
+	// sees every parent already up to date.
+	const uint32_t count = nodes.size();
+	const int32_t *parents_ptr = parents.ptr();
+	const Transform3D *local_ptr = local_transforms.ptr();
+	Transform3D *global_ptr = global_transforms.ptr();
+	uint8_t *flags_ptr = flags.ptr();
+	for (uint32_t i = 0; i < count; i++) {
+		const uint8_t slot_flags = flags_ptr[i];
+		if (!(slot_flags & FLAG_GLOBAL_DIRTY)) {
+			continue;
+		}
+		const int32_t parent = parents_ptr[i];
+		if (parent >= 0 && !(slot_flags & FLAG_TOP_LEVEL)) {
+			global_ptr[i] = global_ptr[parent] * local_ptr[i];
+		} else {
+			global_ptr[i] = local_ptr[i];
+		}
+		if (slot_flags & FLAG_DISABLE_SCALE) {
+			global_ptr[i].basis.orthonormalize();
+		}
+		flags_ptr[i] = slot_flags & ~FLAG_GLOBAL_DIRTY;
+	}
+}
+
+void Node3DTransformStore::_rebuild_order() {
+	const uint32_t count = nodes.size();
+
+	// Build child lists out of the parent indices, without touching the nodes.
+	LocalVector<int32_t> first_child;
+	LocalVector<int32_t> next_sibling;
+	first_child.resize(count);
+	next_sibling.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		first_child[i] = -1;
+		next_sibling[i] = -1;
+	}
+	for (int32_t i = int32_t(count) - 1; i >= 0; i--) {
+		if (nodes[i] && parents[i] >= 0) {
+			next_sibling[i] = first_child[parents[i]];
+			first_child[parents[i]] = i;
+		}
+	}
+
+	// Depth-first order, so every subtree is a contiguous range.
+	LocalVector<uint32_t> order;
+	LocalVector<int32_t> remap;
+	LocalVector<int32_t> stack;
+	order.reserve(count - free_slots);
+	remap.resize(count);
+	for (uint32_t root = 0; root < count; root++) {
+		if (!nodes[root] || parents[root] >= 0) {
+			continue;
+		}
+		stack.push_back(root);
+		while (!stack.is_empty()) {
+			const int32_t current = stack[stack.size() - 1];
+			stack.resize(stack.size() - 1);
+			remap[current] = order.size();
+			order.push_back(current);
+			for (int32_t child = first_child[current]; child >= 0; child = next_sibling[child]) {
+				stack.push_back(child);
+			}
+		}
+	}
+	ERR_FAIL_COND_MSG(order.size() != count - free_slots, "Node3D transform store hierarchy is inconsistent.");
+
+	const uint32_t new_count = order.size();
+	LocalVector<Transform3D> new_local_transforms;
+	LocalVector<Transform3D> new_global_transforms;
+	LocalVector<int32_t> new_parents;
+	LocalVector<uint32_t> new_subtree_ends;
+	LocalVector<uint8_t> new_flags;
+	LocalVector<Node3D *> new_nodes;
+	new_local_transforms.resize(new_count);
+	new_global_transforms.resize(new_count);
+	new_parents.resize(new_count);
+	new_subtree_ends.resize(new_count);
+	new_flags.resize(new_count);
+	new_nodes.resize(new_count);
+
+	for (uint32_t i = 0; i < new_count; i++) {
+		const uint32_t from = order[i];
+		new_local_transforms[i] = local_transforms[from];
+		new_global_transforms[i] = global_transforms[from];
+		new_parents[i] = parents[from] >= 0 ? remap[parents[from]] : -1;
+		new_subtree_ends[i] = i + 1;
+		new_flags[i] = flags[from];
+		new_nodes[i] = nodes[from];
+		new_nodes[i]->data.transform_index = i;
+	}
+
+	// Descendants come after their ancestors, so a reverse pass sees every
+	// subtree complete before extending its parent with it.
+	for (int32_t i = int32_t(new_count) - 1; i >= 0; i--) {
+		const int32_t parent = new_parents[i];
+		if (parent >= 0) {
+			new_subtree_ends[parent] = MAX(new_subtree_ends[parent], new_subtree_ends[i]);
+		}
+	}
+
+	local_transforms = new_local_transforms;
+	global_transforms = new_global_transforms;
+	parents = new_parents;
+	subtree_ends = new_subtree_ends;
+	flags = new_flags;
+	nodes = new_nodes;
+
+	free_slots = 0;
+	order_dirty = false;
+}
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  node_3d_transform_store.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NODE_3D_TRANSFORM_STORE_H
+#define NODE_3D_TRANSFORM_STORE_H
+
+#include "core/math/transform_3d.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "scene/main/node.h"
+
+class Node3D;
+
+SAFE_NUMERIC_TYPE_PUN_GUARANTEES(uint8_t)
+
+// Structure-of-arrays storage for the transforms of the Node3Ds in a SceneTree.
+//
+// When enabled (see the "application/run/use_transform_store_3d" project setting),
+// every Node3D inside the tree keeps its local and global transform here instead
+// of in the node, and accesses them through its regular API. Slots are kept in
+// depth-first order, so a node's subtree is a contiguous range: invalidating it
+// is a linear walk over a flag array, and recomputing global transforms is a
+// single pass where parents always come before their children.
+//
+// The order is rebuilt lazily after nodes are added or removed. Until then,
+// invalidation falls back to walking the node hierarchy.
+//
+// Only the main thread caches global transforms. The SceneTree updates them
+// before running threaded process groups, which compute dirty ones on the fly.
+// While groups are processed, flags are accessed atomically, like the dirty
+// mask of Node3D.
+class Node3DTransformStore {
+	friend class Node3D;
+
+public:
+	enum {
+		FLAG_GLOBAL_DIRTY = 1,
+		FLAG_TOP_LEVEL = 2,
+		FLAG_DISABLE_SCALE = 4,
+		FLAG_NOTIFY = 8, // The node wants NOTIFICATION_TRANSFORM_CHANGED.
+	};
+
+private:
+	LocalVector<Transform3D> local_transforms;
+	LocalVector<Transform3D> global_transforms;
+	LocalVector<int32_t> parents;
+	LocalVector<uint32_t> subtree_ends; // One past the last slot of the subtree, valid when the order is.
+	LocalVector<uint8_t> flags;
+	LocalVector<Node3D *> nodes;
+
+	uint32_t free_slots = 0;
+	bool order_dirty = false;
+	SafeFlag pending_update;
+
+	_FORCE_INLINE_ uint8_t _get_flags(uint32_t p_index) const {
+		return Node::is_group_processing() ? reinterpret_cast<const SafeNumeric<uint8_t> *>(&flags[p_index])->get() : flags[p_index];
+	}
+	_FORCE_INLINE_ void _set_flag_bits(uint32_t p_index, uint8_t p_bits) {
+		if (Node::is_group_processing()) {
+			reinterpret_cast<SafeNumeric<uint8_t> *>(&flags[p_index])->bit_or(p_bits);
+		} else {
+			flags[p_index] |= p_bits;
+		}
+	}
+	_FORCE_INLINE_ void _clear_flag_bits(uint32_t p_index, uint8_t p_bits) {
+		if (Node::is_group_processing()) {
+			reinterpret_cast<SafeNumeric<uint8_t> *>(&flags[p_index])->bit_and(~p_bits);
+		} else {
+			flags[p_index] &= ~p_bits;
+		}
+	}
+
+	void _mark_dirty(uint32_t p_index);
+	void _invalidate_hierarchy(uint32_t p_index);
+	void _compute_global_transform(uint32_t p_index);
+	Transform3D _calculate_global_transform(uint32_t p_index) const;
+	void _rebuild_order();
+
+public:
+	uint32_t add(Node3D *p_node, int32_t p_parent, const Transform3D &p_local_transform);
+	void remove(uint32_t p_index);
+
+	_FORCE_INLINE_ Transform3D get_local_transform(uint32_t p_index) const { return local_transforms[p_index]; }
+	_FORCE_INLINE_ void set_local_transform(uint32_t p_index, const Transform3D &p_transform) { local_transforms[p_index] = p_transform; }
+	_FORCE_INLINE_ Transform3D get_global_transform(uint32_t p_index) {
+		if (_get_flags(p_index) & FLAG_GLOBAL_DIRTY) {
+			if (!Thread::is_main_thread()) {
+				return _calculate_global_transform(p_index);
+			}
+			_compute_global_transform(p_index);
+		}
+		return global_transforms[p_index];
+	}
+
+	_FORCE_INLINE_ void set_flag(uint32_t p_index, uint8_t p_flag, bool p_enabled) {
+		if (p_enabled) {
+			_set_flag_bits(p_index, p_flag);
+		} else {
+			_clear_flag_bits(p_index, p_flag);
+		}
+	}
+
+	// Marks the global transform of the node and its non top-level descendants
+	// as dirty, and queues their transform notifications.
+	void invalidate(uint32_t p_index);
+
+	// Recomputes every dirty global transform in one pass. Called by the SceneTree
+	// before transform notifications are flushed.
+	void update_global_transforms();
+
+	uint32_t get_node_count() const { return nodes.size() - free_slots; }
+};
+
+#endif // NODE_3D_TRANSFORM_STORE_H
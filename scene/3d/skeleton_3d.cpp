@@ -31,6 +31,8 @@
 #include "skeleton_3d.h"
 #include "skeleton_3d.compat.inc"
 
+#include "core/math/simd_batch.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/type_info.h"
 #include "scene/3d/skeleton_modifier_3d.h"
 #include "scene/resources/surface_tool.h"
@@ -263,6 +265,17 @@ void Skeleton3D::_update_process_order() {
 		}
 	}
 
+	bone_process_order.clear();
+	for (int i = 0; i < parentless_bones.size(); i++) {
+		bone_process_order.push_back(parentless_bones[i]);
+	}
+	for (uint32_t i = 0; i < bone_process_order.size(); i++) {
+		const Bone &b = bonesptr[bone_process_order[i]];
+		for (int j = 0; j < b.child_bones.size(); j++) {
+			bone_process_order.push_back(b.child_bones[j]);
+		}
+	}
+
 	bones_backup.resize(bones.size());
 
 	concatenated_bone_names = StringName();
@@ -322,9 +335,6 @@ void Skeleton3D::_notification(int p_what) {
 
 			updating = true;
 
-			Bone *bonesptr = bones.ptrw();
-			int len = bones.size();
-
 			// Process modifiers.
 			_find_modifiers();
 			if (!modifiers.is_empty()) {
@@ -339,67 +349,19 @@ void Skeleton3D::_notification(int p_what) {
 			if (!(update_flags & UPDATE_FLAG_POSE)) {
 				updating = false;
 				update_flags = UPDATE_FLAG_NONE;
+				skin_transforms_ready = false;
 				return;
 			}
 
 			emit_signal(SceneStringName(skeleton_updated));
 
-			// Update skins.
-			RenderingServer *rs = RenderingServer::get_singleton();
-			for (SkinReference *E : skin_bindings) {
-				const Skin *skin = E->skin.operator->();
-				RID skeleton = E->skeleton;
-				uint32_t bind_count = skin->get_bind_count();
-
-				if (E->bind_count != bind_count) {
-					RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
-					E->bind_count = bind_count;
-					E->skin_bone_indices.resize(bind_count);
-					E->skin_bone_indices_ptrs = E->skin_bone_indices.ptrw();
-				}
-
-				if (E->skeleton_version != version) {
-					for (uint32_t i = 0; i < bind_count; i++) {
-						StringName bind_name = skin->get_bind_name(i);
-
-						if (bind_name != StringName()) {
-							// Bind name used, use this.
-							bool found = false;
-							for (int j = 0; j < len; j++) {
-								if (bonesptr[j].name == bind_name) {
-									E->skin_bone_indices_ptrs[i] = j;
-									found = true;
-									break;
-								}
-							}
-
-							if (!found) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
-								E->skin_bone_indices_ptrs[i] = 0;
-							}
-						} else if (skin->get_bind_bone(i) >= 0) {
-							int bind_index = skin->get_bind_bone(i);
-							if (bind_index >= len) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
-								E->skin_bone_indices_ptrs[i] = 0;
-							} else {
-								E->skin_bone_indices_ptrs[i] = bind_index;
-							}
-						} else {
-							ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
-							E->skin_bone_indices_ptrs[i] = 0;
-						}
-					}
-
-					E->skeleton_version = version;
-				}
-
-				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = E->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].global_pose * skin->get_bind_pose(i));
-				}
+			// Update skins, unless they were computed from the current poses by _flush_pending_updates().
+			if (!skin_transforms_ready) {
+				_update_skin_bindings();
+				_compute_skin_transforms();
 			}
+			skin_transforms_ready = false;
+			_upload_skin_transforms();
 
 			if (!modifiers.is_empty()) {
 				// Restore unmodified bone poses.
@@ -747,6 +709,7 @@ Transform3D Skeleton3D::get_bone_pose(int p_bone) const {
 }
 
 void Skeleton3D::_make_dirty() {
+	skin_transforms_ready = false;
 	if (dirty) {
 		return;
 	}
@@ -757,12 +720,99 @@ void Skeleton3D::_make_dirty() {
 void Skeleton3D::_update_deferred(UpdateFlag p_update_flag) {
 	if (is_inside_tree()) {
 		if (update_flags == UPDATE_FLAG_NONE && !updating) {
-			notify_deferred_thread_group(NOTIFICATION_UPDATE_SKELETON); // It must never be called more than once in a single frame.
+			// It must never be called more than once in a single frame.
+			if (Thread::is_main_thread()) {
+				if (!update_queued) {
+					if (pending_update_skeletons.is_empty()) {
+						callable_mp_static(&Skeleton3D::_flush_pending_updates).call_deferred();
+					}
+					pending_update_skeletons.push_back(get_instance_id());
+					update_queued = true;
+				}
+			} else {
+				notify_deferred_thread_group(NOTIFICATION_UPDATE_SKELETON);
+			}
 		}
 		update_flags |= p_update_flag;
 	}
 }
 
+LocalVector<ObjectID> Skeleton3D::pending_update_skeletons;
+
+void Skeleton3D::_update_pending_skeleton(void *p_userdata, uint32_t p_index) {
+	const PendingUpdate &update = static_cast<PendingUpdate *>(p_userdata)[p_index];
+	Skeleton3D *skeleton = update.skeleton;
+	if (update.update_poses) {
+		skeleton->_update_bone_global_poses();
+		skeleton->rest_dirty = false;
+		skeleton->dirty = false;
+	}
+	if (update.compute_skins) {
+		skeleton->_compute_skin_transforms();
+	}
+}
+
+void Skeleton3D::_flush_pending_updates() {
+	LocalVector<ObjectID> skeleton_ids;
+	for (const ObjectID &id : pending_update_skeletons) {
+		Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(id));
+		if (!skeleton) {
+			continue;
+		}
+		skeleton->update_queued = false;
+		// It may have been updated already, when it was notified directly.
+		if (skeleton->update_flags != UPDATE_FLAG_NONE) {
+			skeleton_ids.push_back(id);
+		}
+	}
+	pending_update_skeletons.clear();
+
+	// Updating the process order emits a signal, so it's done before any skeleton is referenced.
+	for (const ObjectID &id : skeleton_ids) {
+		Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(id));
+		if (skeleton) {
+			skeleton->_update_process_order();
+		}
+	}
+
+	LocalVector<PendingUpdate> updates;
+	for (const ObjectID &id : skeleton_ids) {
+		Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(id));
+		if (!skeleton) {
+			continue;
+		}
+		PendingUpdate update;
+		update.id = id;
+		update.skeleton = skeleton;
+		update.update_poses = skeleton->dirty;
+		skeleton->_find_modifiers();
+		// Modifiers change the poses, so skins are computed after processing them.
+		if (skeleton->modifiers.is_empty() && (skeleton->update_flags & UPDATE_FLAG_POSE)) {
+			skeleton->_update_skin_bindings();
+			update.compute_skins = true;
+		}
+		updates.push_back(update);
+	}
+
+	if (updates.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&Skeleton3D::_update_pending_skeleton, updates.ptr(), updates.size(), -1, true, SNAME("Skeleton3DUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (updates.size() == 1) {
+		_update_pending_skeleton(updates.ptr(), 0);
+	}
+
+	// Signals and modifiers may run scripts, so the rest is done on this thread.
+	// Poses changed by them in the meantime make the skeleton dirty again, and are updated by the notification.
+	for (const PendingUpdate &update : updates) {
+		if (update.update_poses && ObjectDB::get_instance(update.id)) {
+			update.skeleton->emit_signal(SceneStringName(pose_updated));
+		}
+		if (ObjectDB::get_instance(update.id)) {
+			update.skeleton->notification(NOTIFICATION_UPDATE_SKELETON);
+		}
+	}
+}
+
 void Skeleton3D::localize_rests() {
 	Vector<int> bones_to_process = get_parentless_bones();
 	while (bones_to_process.size() > 0) {
@@ -853,6 +903,97 @@ Ref<SkinReference> Skeleton3D::register_skin(const Ref<Skin> &p_skin) {
 	return skin_ref;
 }
 
+void Skeleton3D::_update_skin_bindings() {
+	const Bone *bonesptr = bones.ptr();
+	int len = bones.size();
+
+	for (SkinReference *E : skin_bindings) {
+		const Skin *skin = E->skin.operator->();
+		RID skeleton = E->skeleton;
+		uint32_t bind_count = skin->get_bind_count();
+
+		if (E->bind_count != bind_count) {
+			RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
+			E->bind_count = bind_count;
+			E->skin_bone_indices.resize(bind_count);
+			E->skin_bone_indices_ptrs = E->skin_bone_indices.ptrw();
+		}
+
+		if (E->skeleton_version != version) {
+			for (uint32_t i = 0; i < bind_count; i++) {
+				StringName bind_name = skin->get_bind_name(i);
+
+				if (bind_name != StringName()) {
+					// Bind name used, use this.
+					bool found = false;
+					for (int j = 0; j < len; j++) {
+						if (bonesptr[j].name == bind_name) {
+							E->skin_bone_indices_ptrs[i] = j;
+							found = true;
+							break;
+						}
+					}
+
+					if (!found) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
+						E->skin_bone_indices_ptrs[i] = 0;
+					}
+				} else if (skin->get_bind_bone(i) >= 0) {
+					int bind_index = skin->get_bind_bone(i);
+					if (bind_index >= len) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
+						E->skin_bone_indices_ptrs[i] = 0;
+					} else {
+						E->skin_bone_indices_ptrs[i] = bind_index;
+					}
+				} else {
+					ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
+					E->skin_bone_indices_ptrs[i] = 0;
+				}
+			}
+
+			E->skeleton_version = version;
+		}
+	}
+}
+
+void Skeleton3D::_compute_skin_transforms() {
+	// Only reads the skeleton and writes to its skins, so skeletons can be computed in parallel.
+	const Bone *bonesptr = bones.ptr();
+	uint32_t len = bones.size();
+	thread_local LocalVector<Transform3D> bind_poses;
+
+	for (SkinReference *E : skin_bindings) {
+		const Skin *skin = E->skin.operator->();
+		E->skin_transforms.resize(E->bind_count);
+		bind_poses.resize(E->bind_count);
+		Transform3D *transforms = E->skin_transforms.ptr();
+
+		// Gather the poses into contiguous arrays, then multiply them as one batch.
+		for (uint32_t i = 0; i < E->bind_count; i++) {
+			uint32_t bone_index = E->skin_bone_indices_ptrs[i];
+			if (likely(bone_index < len)) {
+				transforms[i] = bonesptr[bone_index].global_pose;
+			} else {
+				ERR_PRINT(vformat("Skin bind %d refers to invalid bone %d.", i, bone_index));
+				transforms[i] = Transform3D();
+			}
+			bind_poses[i] = skin->get_bind_pose(i);
+		}
+		SIMDBatch::multiply_transforms(transforms, bind_poses.ptr(), transforms, E->bind_count);
+	}
+	skin_transforms_ready = true;
+}
+
+void Skeleton3D::_upload_skin_transforms() {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	for (const SkinReference *E : skin_bindings) {
+		for (uint32_t i = 0; i < E->skin_transforms.size(); i++) {
+			rs->skeleton_bone_set_transform(E->skeleton, i, E->skin_transforms[i]);
+		}
+	}
+}
+
 void Skeleton3D::force_update_all_dirty_bones() {
 	if (!dirty) {
 		return;
@@ -862,9 +1003,7 @@ void Skeleton3D::force_update_all_dirty_bones() {
 
 void Skeleton3D::force_update_all_bone_transforms() {
 	_update_process_order();
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		force_update_bone_children_transforms(parentless_bones[i]);
-	}
+	_update_bone_global_poses();
 	rest_dirty = false;
 	dirty = false;
 	if (updating) {
@@ -873,6 +1012,62 @@ void Skeleton3D::force_update_all_bone_transforms() {
 	emit_signal(SceneStringName(pose_updated));
 }
 
+void Skeleton3D::_update_bone_global_pose(Bone *p_bones, int p_bone) {
+	Bone &b = p_bones[p_bone];
+	bool bone_enabled = b.enabled && !show_rest_only;
+
+	if (bone_enabled) {
+		b.update_pose_cache();
+		Transform3D pose = b.pose_cache;
+
+		if (b.parent >= 0) {
+			b.global_pose = p_bones[b.parent].global_pose * pose;
+		} else {
+			b.global_pose = pose;
+		}
+	} else {
+		if (b.parent >= 0) {
+			b.global_pose = p_bones[b.parent].global_pose * b.rest;
+		} else {
+			b.global_pose = b.rest;
+		}
+	}
+	if (rest_dirty) {
+		b.global_rest = b.parent >= 0 ? p_bones[b.parent].global_rest * b.rest : b.rest;
+	}
+
+#ifndef DISABLE_DEPRECATED
+	if (bone_enabled) {
+		Transform3D pose = b.pose_cache;
+		if (b.parent >= 0) {
+			b.pose_global_no_override = p_bones[b.parent].pose_global_no_override * pose;
+		} else {
+			b.pose_global_no_override = pose;
+		}
+	} else {
+		if (b.parent >= 0) {
+			b.pose_global_no_override = p_bones[b.parent].pose_global_no_override * b.rest;
+		} else {
+			b.pose_global_no_override = b.rest;
+		}
+	}
+	if (b.global_pose_override_amount >= CMP_EPSILON) {
+		b.global_pose = b.global_pose.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+	}
+	if (b.global_pose_override_reset) {
+		b.global_pose_override_amount = 0.0;
+	}
+#endif // _DISABLE_DEPRECATED
+}
+
+void Skeleton3D::_update_bone_global_poses() {
+	// Parents are processed first, so this is a single pass over the bones.
+	Bone *bonesptr = bones.ptrw();
+	for (const int bone_idx : bone_process_order) {
+		_update_bone_global_pose(bonesptr, bone_idx);
+	}
+}
+
 void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone_idx, bone_size);
@@ -885,54 +1080,10 @@ void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
 	uint32_t index = 0;
 	while (index < bones_to_process.size()) {
 		int current_bone_idx = bones_to_process[index];
-
-		Bone &b = bonesptr[current_bone_idx];
-		bool bone_enabled = b.enabled && !show_rest_only;
-
-		if (bone_enabled) {
-			b.update_pose_cache();
-			Transform3D pose = b.pose_cache;
-
-			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * pose;
-			} else {
-				b.global_pose = pose;
-			}
-		} else {
-			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * b.rest;
-			} else {
-				b.global_pose = b.rest;
-			}
-		}
-		if (rest_dirty) {
-			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
-		}
-
-#ifndef DISABLE_DEPRECATED
-		if (bone_enabled) {
-			Transform3D pose = b.pose_cache;
-			if (b.parent >= 0) {
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
-			} else {
-				b.pose_global_no_override = pose;
-			}
-		} else {
-			if (b.parent >= 0) {
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
-			} else {
-				b.pose_global_no_override = b.rest;
-			}
-		}
-		if (b.global_pose_override_amount >= CMP_EPSILON) {
-			b.global_pose = b.global_pose.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
-		}
-		if (b.global_pose_override_reset) {
-			b.global_pose_override_amount = 0.0;
-		}
-#endif // _DISABLE_DEPRECATED
+		_update_bone_global_pose(bonesptr, current_bone_idx);
 
 		// Add the bone's children to the list of bones to be processed.
+		const Bone &b = bonesptr[current_bone_idx];
 		int child_bone_size = b.child_bones.size();
 		for (int i = 0; i < child_bone_size; i++) {
 			bones_to_process.push_back(b.child_bones[i]);
@@ -50,6 +50,7 @@ class SkinReference : public RefCounted {
 	uint64_t skeleton_version = 0;
 	Vector<uint32_t> skin_bone_indices;
 	uint32_t *skin_bone_indices_ptrs = nullptr;
+	LocalVector<Transform3D> skin_transforms; // Sent to the rendering server once computed.
 
 protected:
 	static void _bind_methods();
@@ -91,6 +92,19 @@ private:
 	uint8_t update_flags = UPDATE_FLAG_NONE;
 	bool updating = false; // Is updating now?
 
+	// Skeletons made dirty on the main thread are updated together at the end of the frame,
+	// global poses and skins of all of them are computed on the WorkerThreadPool.
+	struct PendingUpdate {
+		ObjectID id;
+		Skeleton3D *skeleton = nullptr;
+		bool update_poses = false;
+		bool compute_skins = false;
+	};
+	static LocalVector<ObjectID> pending_update_skeletons;
+	bool update_queued = false;
+	static void _update_pending_skeleton(void *p_userdata, uint32_t p_index);
+	static void _flush_pending_updates();
+
 	struct Bone {
 		String name;
 
@@ -149,12 +163,17 @@ private:
 	};
 
 	HashSet<SkinReference *> skin_bindings;
+	bool skin_transforms_ready = false; // Computed from the current poses.
 	void _skin_changed();
+	void _update_skin_bindings();
+	void _compute_skin_transforms();
+	void _upload_skin_transforms();
 
 	Vector<Bone> bones;
 	bool process_order_dirty = false;
 
 	Vector<int> parentless_bones;
+	LocalVector<int> bone_process_order; // Parents come before their children.
 	HashMap<String, int> name_to_bone_index;
 
 	mutable StringName concatenated_bone_names = StringName();
@@ -170,6 +189,8 @@ private:
 	uint64_t version = 1;
 
 	void _update_process_order();
+	void _update_bone_global_pose(Bone *p_bones, int p_bone);
+	void _update_bone_global_poses();
 
 	// To process modifiers.
 	ModifierCallbackModeProcess modifier_callback_mode_process = MODIFIER_CALLBACK_MODE_PROCESS_IDLE;
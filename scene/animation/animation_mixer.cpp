@@ -33,6 +33,8 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
 #include "scene/2d/audio_stream_player_2d.h"
 #include "scene/animation/animation_player.h"
 #include "scene/audio/audio_stream_player.h"
@@ -42,10 +44,13 @@
 
 #ifndef _3D_DISABLED
 #include "scene/3d/audio_stream_player_3d.h"
+#include "scene/3d/camera_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
 #include "scene/3d/skeleton_modifier_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#include "scene/main/viewport.h"
 #endif // _3D_DISABLED
 
 #ifdef TOOLS_ENABLED
@@ -557,6 +562,11 @@ bool AnimationMixer::is_dummy() const {
 /* -------------------------------------------- */
 
 void AnimationMixer::_clear_caches() {
+	if (blend_pending_stage != BLEND_PENDING_NONE) {
+		// The queued blend refers to the caches being cleared.
+		blend_pending_stage = BLEND_PENDING_NONE;
+		clear_animation_instances();
+	}
 	_init_root_motion_cache();
 	_clear_audio_streams();
 	_clear_playing_caches();
@@ -564,6 +574,8 @@ void AnimationMixer::_clear_caches() {
 		memdelete(K.value);
 	}
 	track_cache.clear();
+	_update_track_cache_layout();
+	animation_track_remaps.clear();
 	cache_valid = false;
 	capture_cache.clear();
 
@@ -742,6 +754,9 @@ bool AnimationMixer::_update_caches() {
 							if (bone_idx != -1) {
 								has_rest = true;
 								track_xform->bone_idx = bone_idx;
+								for (int parent = sk->get_bone_parent(bone_idx); parent >= 0; parent = sk->get_bone_parent(parent)) {
+									track_xform->bone_depth++;
+								}
 								Transform3D rest = sk->get_bone_rest(bone_idx);
 								track_xform->init_loc = rest.origin;
 								track_xform->init_rot = rest.basis.get_rotation_quaternion();
@@ -915,19 +930,104 @@ bool AnimationMixer::_update_caches() {
 		to_delete.pop_front();
 	}
 
+	_update_track_cache_layout();
+
+	animation_track_remaps.clear();
+	for (const StringName &E : sname_list) {
+		Ref<Animation> anim = get_animation(E);
+		_make_animation_track_remap(anim, animation_track_remaps[anim->get_instance_id()]);
+	}
+
+	cache_valid = true;
+
+	return true;
+}
+
+void AnimationMixer::_update_track_cache_layout() {
 	track_map.clear();
+	track_cache_list.clear();
+	track_blend_indices.clear();
+	track_total_weights.clear();
+	transform_init_locs.clear();
+	transform_init_rots.clear();
+	transform_init_scales.clear();
+	transform_locs.clear();
+	transform_rots.clear();
+	transform_scales.clear();
+	blend_shape_init_values.clear();
+	blend_shape_values.clear();
+#ifndef _3D_DISABLED
+	track_lod_depths.clear();
+	lod_interpolating = false;
+#endif // _3D_DISABLED
 
-	int idx = 0;
 	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
-		track_map[K.value->path] = idx;
-		idx++;
+		TrackCache *track = K.value;
+		track->index = track_cache_list.size();
+		track_map[track->path] = track->index;
+		track_cache_list.push_back(track);
+		track_total_weights.push_back(track->total_weight);
+
+		// Current values are copied too, so restored backups can be applied.
+		switch (track->type) {
+			case Animation::TYPE_POSITION_3D: {
+				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+				t->transform_slot = transform_locs.size();
+				transform_init_locs.push_back(t->init_loc);
+				transform_init_rots.push_back(t->init_rot);
+				transform_init_scales.push_back(t->init_scale);
+				transform_locs.push_back(t->loc);
+				transform_rots.push_back(t->rot);
+				transform_scales.push_back(t->scale);
+			} break;
+			case Animation::TYPE_BLEND_SHAPE: {
+				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
+				t->blend_shape_slot = blend_shape_values.size();
+				blend_shape_init_values.push_back(t->init_value);
+				blend_shape_values.push_back(t->value);
+			} break;
+			default: {
+			} break;
+		}
+
+#ifndef _3D_DISABLED
+		if (track->type == Animation::TYPE_POSITION_3D) {
+			track_lod_depths.push_back(static_cast<TrackCacheTransform *>(track)->bone_depth);
+		} else {
+			track_lod_depths.push_back(track->type == Animation::TYPE_BLEND_SHAPE ? INT32_MAX : 0);
+		}
+#endif // _3D_DISABLED
 	}
 
-	track_count = idx;
+	// Caches with the same path share the blend index of the last one.
+	for (TrackCache *track : track_cache_list) {
+		track_blend_indices.push_back(track_map[track->path]);
+	}
 
-	cache_valid = true;
+	track_count = track_cache_list.size();
+	track_weight_passes.resize(track_count);
+	for (uint64_t &pass : track_weight_passes) {
+		pass = 0;
+	}
+	track_weight_pass = 0;
+}
 
-	return true;
+void AnimationMixer::_make_animation_track_remap(const Ref<Animation> &p_animation, LocalVector<int> &r_remap) const {
+	r_remap.resize(p_animation->get_track_count());
+	for (uint32_t i = 0; i < r_remap.size(); i++) {
+		TrackCache *const *track = track_cache.getptr(p_animation->track_get_type_hash(i));
+		r_remap[i] = track ? (*track)->index : -1;
+	}
+}
+
+const LocalVector<int> &AnimationMixer::_get_animation_track_remap(const Ref<Animation> &p_animation) {
+	const LocalVector<int> *remap = animation_track_remaps.getptr(p_animation->get_instance_id());
+	if (remap && remap->size() == (uint32_t)p_animation->get_track_count()) {
+		return *remap;
+	}
+	// Animations which aren't in the libraries, like the capture animation, are remapped every time.
+	_make_animation_track_remap(p_animation, uncached_track_remap);
+	return uncached_track_remap;
 }
 
 /* -------------------------------------------- */
@@ -935,11 +1035,20 @@ bool AnimationMixer::_update_caches() {
 /* -------------------------------------------- */
 
 void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
+#ifndef _3D_DISABLED
+	if (!lod_processing) {
+		// Direct calls, such as seeking, blend every track.
+		lod_skip_details = false;
+	}
+#endif // _3D_DISABLED
 	_blend_init();
 	if (_blend_pre_process(p_delta, track_count, track_map)) {
 		_blend_capture(p_delta);
 		_blend_calc_total_weight();
 		_blend_process(p_delta, p_update_only);
+#ifndef _3D_DISABLED
+		_blend_lod_targets(lod_processing);
+#endif // _3D_DISABLED
 		_blend_apply();
 		_blend_post_process();
 		emit_signal(SNAME("mixer_applied"));
@@ -947,9 +1056,100 @@ void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 	clear_animation_instances();
 }
 
+void AnimationMixer::_process_internal(double p_delta) {
+#ifndef _3D_DISABLED
+	if (lod_enabled && !_lod_process(p_delta, p_delta)) {
+		return;
+	}
+	lod_processing = true;
+#endif // _3D_DISABLED
+	// The queue is shared by all mixers and flushed by a deferred call, so
+	// mixers in threaded process groups are blended right away.
+	// Scripts overriding the key values can't be called from threads.
+	if (parallel_blending && Thread::is_main_thread() && !GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value)) {
+		_queue_process_animation(p_delta);
+	} else {
+		_process_animation(p_delta);
+	}
+#ifndef _3D_DISABLED
+	lod_processing = false;
+#endif // _3D_DISABLED
+}
+
+LocalVector<ObjectID> AnimationMixer::pending_blend_mixers;
+
+void AnimationMixer::_queue_process_animation(double p_delta) {
+	// Tracks with side effects are processed right away, as they would be without parallel blending.
+	_blend_init();
+	if (!_blend_pre_process(p_delta, track_count, track_map)) {
+		clear_animation_instances();
+		return;
+	}
+	_blend_capture(p_delta);
+	_blend_calc_total_weight();
+	_blend_process(p_delta, false, BLEND_PROCESS_TRACKS_EVENTS);
+
+	if (pending_blend_mixers.is_empty()) {
+		callable_mp_static(&AnimationMixer::_flush_pending_blends).call_deferred();
+	}
+	pending_blend_mixers.push_back(get_instance_id());
+	blend_pending_stage = BLEND_PENDING_SAMPLE;
+	blend_pending_delta = p_delta;
+}
+
+void AnimationMixer::_blend_finish_pending() {
+	if (blend_pending_stage == BLEND_PENDING_SAMPLE) {
+		_blend_process(blend_pending_delta, false, BLEND_PROCESS_TRACKS_SAMPLED);
+	}
+	blend_pending_stage = BLEND_PENDING_NONE;
+#ifndef _3D_DISABLED
+	_blend_lod_targets(true); // Only _process_internal() queues blends.
+#endif // _3D_DISABLED
+	_blend_apply();
+	_blend_post_process();
+	emit_signal(SNAME("mixer_applied"));
+	clear_animation_instances();
+}
+
+void AnimationMixer::_blend_pending_sample(void *p_userdata, uint32_t p_index) {
+	AnimationMixer *mixer = static_cast<AnimationMixer **>(p_userdata)[p_index];
+	mixer->_blend_process(mixer->blend_pending_delta, false, BLEND_PROCESS_TRACKS_SAMPLED);
+	mixer->blend_pending_stage = BLEND_PENDING_APPLY;
+}
+
+void AnimationMixer::_flush_pending_blends() {
+	LocalVector<ObjectID> mixer_ids;
+	LocalVector<AnimationMixer *> mixers;
+	for (const ObjectID &id : pending_blend_mixers) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		// The mixer may have been freed, or already applied when it was processed again.
+		if (mixer && mixer->blend_pending_stage == BLEND_PENDING_SAMPLE) {
+			mixer_ids.push_back(id);
+			mixers.push_back(mixer);
+		}
+	}
+	pending_blend_mixers.clear();
+
+	if (mixers.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationMixer::_blend_pending_sample, mixers.ptr(), mixers.size(), -1, true, SNAME("AnimationMixerBlend"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (mixers.size() == 1) {
+		_blend_pending_sample(mixers.ptr(), 0);
+	}
+
+	// Applying sets the properties of other nodes and emits signals, so it's done on this thread in the order the mixers were processed.
+	for (const ObjectID &id : mixer_ids) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (mixer && mixer->blend_pending_stage == BLEND_PENDING_APPLY) {
+			mixer->_blend_finish_pending();
+		}
+	}
+}
+
 Variant AnimationMixer::post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant p_value, ObjectID p_object_id, int p_object_sub_idx) {
 	Variant res;
-	if (GDVIRTUAL_CALL(_post_process_key_value, p_anim, p_track, p_value, p_object_id, p_object_sub_idx, res)) {
+	// Queued blends are sampled on threads, they are only queued when there's no override to call.
+	if (blend_pending_stage != BLEND_PENDING_SAMPLE && GDVIRTUAL_CALL(_post_process_key_value, p_anim, p_track, p_value, p_object_id, p_object_sub_idx, res)) {
 		return res;
 	}
 	return _post_process_key_value(p_anim, p_track, p_value, p_object_id, p_object_sub_idx);
@@ -975,6 +1175,11 @@ Variant AnimationMixer::_post_process_key_value(const Ref<Animation> &p_anim, in
 }
 
 void AnimationMixer::_blend_init() {
+	if (blend_pending_stage != BLEND_PENDING_NONE) {
+		// Processed again before the queued blend was applied, apply it first so no frame is lost.
+		_blend_finish_pending();
+	}
+
 	// Check all tracks, see if they need modification.
 	root_motion_position = Vector3(0, 0, 0);
 	root_motion_rotation = Quaternion(0, 0, 0, 1);
@@ -990,27 +1195,19 @@ void AnimationMixer::_blend_init() {
 	}
 
 	// Init all value/transform/blend/bezier tracks that track_cache has.
-	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
-		TrackCache *track = K.value;
-
-		track->total_weight = 0.0;
+	for (real_t &weight : track_total_weights) {
+		weight = 0.0;
+	}
+	transform_locs = transform_init_locs;
+	transform_rots = transform_init_rots;
+	transform_scales = transform_init_scales;
+	blend_shape_values = blend_shape_init_values;
+	root_motion_cache.loc = Vector3(0, 0, 0);
+	root_motion_cache.rot = Quaternion(0, 0, 0, 1);
+	root_motion_cache.scale = Vector3(1, 1, 1);
 
+	for (TrackCache *track : track_cache_list) {
 		switch (track->type) {
-			case Animation::TYPE_POSITION_3D: {
-				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
-				if (track->root_motion) {
-					root_motion_cache.loc = Vector3(0, 0, 0);
-					root_motion_cache.rot = Quaternion(0, 0, 0, 1);
-					root_motion_cache.scale = Vector3(1, 1, 1);
-				}
-				t->loc = t->init_loc;
-				t->rot = t->init_rot;
-				t->scale = t->init_scale;
-			} break;
-			case Animation::TYPE_BLEND_SHAPE: {
-				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
-				t->value = t->init_value;
-			} break;
 			case Animation::TYPE_VALUE: {
 				TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 				t->value = Animation::cast_to_blendwise(t->init_value);
@@ -1081,28 +1278,28 @@ void AnimationMixer::_blend_calc_total_weight() {
 		Ref<Animation> a = ai.animation_data.animation;
 		real_t weight = ai.playback_info.weight;
 		Vector<real_t> track_weights = ai.playback_info.track_weights;
-		Vector<Animation::TypeHash> processed_hashes;
+		const LocalVector<int> &remap = _get_animation_track_remap(a);
+		track_weight_pass++;
 		for (int i = 0; i < a->get_track_count(); i++) {
 			if (!a->track_is_enabled(i)) {
 				continue;
 			}
-			Animation::TypeHash thash = a->track_get_type_hash(i);
-			if (!track_cache.has(thash) || processed_hashes.has(thash)) {
+			int cache_idx = remap[i];
+			if (cache_idx < 0 || track_weight_passes[cache_idx] == track_weight_pass) {
 				// No path, but avoid error spamming.
 				// Or, there is the case different track type with same path; These can be distinguished by hash. So don't add the weight doubly.
 				continue;
 			}
-			TrackCache *track = track_cache[thash];
-			int blend_idx = track_map[track->path];
+			int blend_idx = track_blend_indices[cache_idx];
 			ERR_CONTINUE(blend_idx < 0 || blend_idx >= track_count);
 			real_t blend = blend_idx < track_weights.size() ? track_weights[blend_idx] * weight : weight;
-			track->total_weight += blend;
-			processed_hashes.push_back(thash);
+			track_total_weights[cache_idx] += blend;
+			track_weight_passes[cache_idx] = track_weight_pass;
 		}
 	}
 }
 
-void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
+void AnimationMixer::_blend_process(double p_delta, bool p_update_only, BlendProcessTracks p_tracks) {
 	// Apply value/transform/blend/bezier blends to track caches and execute method/audio/animation tracks.
 #ifdef TOOLS_ENABLED
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
@@ -1121,29 +1318,51 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 #ifndef _3D_DISABLED
 		bool calc_root = !seeked || is_external_seeking;
 #endif // _3D_DISABLED
+		const LocalVector<int> &remap = _get_animation_track_remap(a);
+#ifndef _3D_DISABLED
+		// Compressed tracks share their pages, so they're all sampled at once.
+		const Animation::CompressedPose *pose = nullptr;
+		if (p_tracks != BLEND_PROCESS_TRACKS_EVENTS && a->is_compressed() && a->sample_compressed_pose(time, compressed_pose)) {
+			pose = &compressed_pose;
+		}
+#endif // _3D_DISABLED
 
 		for (int i = 0; i < a->get_track_count(); i++) {
 			if (!a->track_is_enabled(i)) {
 				continue;
 			}
-			Animation::TypeHash thash = a->track_get_type_hash(i);
-			if (!track_cache.has(thash)) {
+			int cache_idx = remap[i];
+			if (cache_idx < 0) {
 				continue; // No path, but avoid error spamming.
 			}
-			TrackCache *track = track_cache[thash];
-			ERR_CONTINUE(!track_map.has(track->path));
-			int blend_idx = track_map[track->path];
+			TrackCache *track = track_cache_list[cache_idx];
+#ifndef _3D_DISABLED
+			if (_is_lod_detail_track(cache_idx)) {
+				continue; // Distant mixers leave them as they are.
+			}
+#endif // _3D_DISABLED
+			int blend_idx = track_blend_indices[cache_idx];
 			ERR_CONTINUE(blend_idx < 0 || blend_idx >= track_count);
 			real_t blend = blend_idx < track_weights.size() ? track_weights[blend_idx] * weight : weight;
 			if (!deterministic) {
 				// If non-deterministic, do normalization.
 				// It would be better to make this if statement outside the for loop, but come here since too much code...
-				if (Math::is_zero_approx(track->total_weight)) {
+				real_t total_weight = track_total_weights[cache_idx];
+				if (Math::is_zero_approx(total_weight)) {
 					continue;
 				}
-				blend = blend / track->total_weight;
+				blend = blend / total_weight;
 			}
 			Animation::TrackType ttype = a->track_get_type(i);
+			if (p_tracks != BLEND_PROCESS_TRACKS_ALL) {
+				bool is_event = ttype == Animation::TYPE_METHOD || ttype == Animation::TYPE_AUDIO || ttype == Animation::TYPE_ANIMATION;
+				if (ttype == Animation::TYPE_VALUE) {
+					is_event = a->value_track_get_update_mode(i) == Animation::UPDATE_DISCRETE && callback_mode_discrete != ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS;
+				}
+				if (is_event != (p_tracks == BLEND_PROCESS_TRACKS_EVENTS)) {
+					continue;
+				}
+			}
 			track->root_motion = root_motion_track == a->track_get_path(i);
 			switch (ttype) {
 				case Animation::TYPE_POSITION_3D: {
@@ -1225,12 +1444,17 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
-						if (err != OK) {
-							continue;
+						if (pose && pose->slots[i] >= 0) {
+							const int slot = pose->slots[i];
+							loc = Vector3(pose->x[slot], pose->y[slot], pose->z[slot]);
+						} else {
+							Error err = a->try_position_track_interpolate(i, time, &loc);
+							if (err != OK) {
+								continue;
+							}
 						}
 						loc = post_process_key_value(a, i, loc, t->object_id, t->bone_idx);
-						t->loc += (loc - t->init_loc) * blend;
+						transform_locs[t->transform_slot] += (loc - transform_init_locs[t->transform_slot]) * blend;
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1312,12 +1536,18 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
-						if (err != OK) {
-							continue;
+						if (pose && pose->slots[i] >= 0) {
+							const int slot = pose->slots[i];
+							rot = Quaternion(pose->x[slot], pose->y[slot], pose->z[slot], pose->w[slot]);
+						} else {
+							Error err = a->try_rotation_track_interpolate(i, time, &rot);
+							if (err != OK) {
+								continue;
+							}
 						}
 						rot = post_process_key_value(a, i, rot, t->object_id, t->bone_idx);
-						t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rot, blend)).normalized();
+						Quaternion &blended_rot = transform_rots[t->transform_slot];
+						blended_rot = (blended_rot * Quaternion().slerp(transform_init_rots[t->transform_slot].inverse() * rot, blend)).normalized();
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1400,12 +1630,17 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
-						if (err != OK) {
-							continue;
+						if (pose && pose->slots[i] >= 0) {
+							const int slot = pose->slots[i];
+							scale = Vector3(pose->x[slot], pose->y[slot], pose->z[slot]);
+						} else {
+							Error err = a->try_scale_track_interpolate(i, time, &scale);
+							if (err != OK) {
+								continue;
+							}
 						}
 						scale = post_process_key_value(a, i, scale, t->object_id, t->bone_idx);
-						t->scale += (scale - t->init_scale) * blend;
+						transform_scales[t->transform_slot] += (scale - transform_init_scales[t->transform_slot]) * blend;
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1416,13 +1651,17 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
-					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
-					if (err != OK) {
-						continue;
+					if (pose && pose->slots[i] >= 0) {
+						value = pose->x[pose->slots[i]];
+					} else {
+						Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+						//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+						if (err != OK) {
+							continue;
+						}
 					}
 					value = post_process_key_value(a, i, value, t->object_id, t->shape_index);
-					t->value += (value - t->init_value) * blend;
+					blend_shape_values[t->blend_shape_slot] += (value - blend_shape_init_values[t->blend_shape_slot]) * blend;
 #endif // _3D_DISABLED
 				} break;
 				case Animation::TYPE_BEZIER:
@@ -1721,53 +1960,23 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 
 void AnimationMixer::_blend_apply() {
 	// Finally, set the tracks.
-	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
-		TrackCache *track = K.value;
-		bool is_zero_amount = Math::is_zero_approx(track->total_weight);
+	for (uint32_t cache_idx = 0; cache_idx < track_cache_list.size(); cache_idx++) {
+		TrackCache *track = track_cache_list[cache_idx];
+		real_t total_weight = track_total_weights[cache_idx];
+		bool is_zero_amount = Math::is_zero_approx(total_weight);
 		if (!deterministic && is_zero_amount) {
 			continue;
 		}
+#ifndef _3D_DISABLED
+		if (_is_lod_detail_track(cache_idx)) {
+			continue;
+		}
+#endif // _3D_DISABLED
 		switch (track->type) {
 			case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
-				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
-
-				if (t->root_motion) {
-					root_motion_position = root_motion_cache.loc;
-					root_motion_rotation = root_motion_cache.rot;
-					root_motion_scale = root_motion_cache.scale - Vector3(1, 1, 1);
-					root_motion_position_accumulator = t->loc;
-					root_motion_rotation_accumulator = t->rot;
-					root_motion_scale_accumulator = t->scale;
-				} else if (t->skeleton_id.is_valid() && t->bone_idx >= 0) {
-					Skeleton3D *t_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(t->skeleton_id));
-					if (!t_skeleton) {
-						return;
-					}
-					if (t->loc_used) {
-						t_skeleton->set_bone_pose_position(t->bone_idx, t->loc);
-					}
-					if (t->rot_used) {
-						t_skeleton->set_bone_pose_rotation(t->bone_idx, t->rot);
-					}
-					if (t->scale_used) {
-						t_skeleton->set_bone_pose_scale(t->bone_idx, t->scale);
-					}
-
-				} else if (!t->skeleton_id.is_valid()) {
-					Node3D *t_node_3d = Object::cast_to<Node3D>(ObjectDB::get_instance(t->object_id));
-					if (!t_node_3d) {
-						return;
-					}
-					if (t->loc_used) {
-						t_node_3d->set_position(t->loc);
-					}
-					if (t->rot_used) {
-						t_node_3d->set_rotation(t->rot.get_euler());
-					}
-					if (t->scale_used) {
-						t_node_3d->set_scale(t->scale);
-					}
+				if (!_blend_apply_transform(static_cast<TrackCacheTransform *>(track))) {
+					return;
 				}
 #endif // _3D_DISABLED
 			} break;
@@ -1777,7 +1986,7 @@ void AnimationMixer::_blend_apply() {
 
 				MeshInstance3D *t_mesh_3d = Object::cast_to<MeshInstance3D>(ObjectDB::get_instance(t->object_id));
 				if (t_mesh_3d) {
-					t_mesh_3d->set_blend_shape_value(t->shape_index, t->value);
+					t_mesh_3d->set_blend_shape_value(t->shape_index, blend_shape_values[t->blend_shape_slot]);
 				}
 #endif // _3D_DISABLED
 			} break;
@@ -1806,7 +2015,7 @@ void AnimationMixer::_blend_apply() {
 				if (t->value.is_array()) {
 					int actual_blended_size = (int)Math::round(Math::abs(t->element_size.operator real_t()));
 					if (actual_blended_size < (t->value.operator Array()).size()) {
-						real_t abs_weight = Math::abs(track->total_weight);
+						real_t abs_weight = Math::abs(total_weight);
 						if (abs_weight >= 1.0) {
 							(t->value.operator Array()).resize(actual_blended_size);
 						} else if (t->init_value.is_string()) {
@@ -1885,6 +2094,54 @@ void AnimationMixer::_blend_apply() {
 	}
 }
 
+bool AnimationMixer::_blend_apply_transform(TrackCacheTransform *p_track) {
+#ifndef _3D_DISABLED
+	TrackCacheTransform *t = p_track;
+	const Vector3 &loc = transform_locs[t->transform_slot];
+	const Quaternion &rot = transform_rots[t->transform_slot];
+	const Vector3 &scale = transform_scales[t->transform_slot];
+
+	if (t->root_motion) {
+		root_motion_position = root_motion_cache.loc;
+		root_motion_rotation = root_motion_cache.rot;
+		root_motion_scale = root_motion_cache.scale - Vector3(1, 1, 1);
+		root_motion_position_accumulator = loc;
+		root_motion_rotation_accumulator = rot;
+		root_motion_scale_accumulator = scale;
+	} else if (t->skeleton_id.is_valid() && t->bone_idx >= 0) {
+		Skeleton3D *t_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(t->skeleton_id));
+		if (!t_skeleton) {
+			return false;
+		}
+		if (t->loc_used) {
+			t_skeleton->set_bone_pose_position(t->bone_idx, loc);
+		}
+		if (t->rot_used) {
+			t_skeleton->set_bone_pose_rotation(t->bone_idx, rot);
+		}
+		if (t->scale_used) {
+			t_skeleton->set_bone_pose_scale(t->bone_idx, scale);
+		}
+
+	} else if (!t->skeleton_id.is_valid()) {
+		Node3D *t_node_3d = Object::cast_to<Node3D>(ObjectDB::get_instance(t->object_id));
+		if (!t_node_3d) {
+			return false;
+		}
+		if (t->loc_used) {
+			t_node_3d->set_position(loc);
+		}
+		if (t->rot_used) {
+			t_node_3d->set_rotation(rot.get_euler());
+		}
+		if (t->scale_used) {
+			t_node_3d->set_scale(scale);
+		}
+	}
+#endif // _3D_DISABLED
+	return true;
+}
+
 void AnimationMixer::_call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred) {
 	// Separate function to use alloca() more efficiently
 	const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * p_params.size());
@@ -1968,6 +2225,174 @@ Vector3 AnimationMixer::get_root_motion_scale_accumulator() const {
 	return root_motion_scale_accumulator;
 }
 
+/* -------------------------------------------- */
+/* -- Animation LOD --------------------------- */
+/* -------------------------------------------- */
+
+#ifndef _3D_DISABLED
+void AnimationMixer::set_lod_enabled(bool p_enabled) {
+	lod_enabled = p_enabled;
+	lod_interval = 1;
+	lod_frame = 0;
+	lod_delta = 0.0;
+	lod_skip_details = false;
+	lod_interpolating = false;
+}
+
+bool AnimationMixer::is_lod_enabled() const {
+	return lod_enabled;
+}
+
+void AnimationMixer::set_lod_distance(real_t p_distance) {
+	lod_distance = MAX(p_distance, 0.0);
+}
+
+real_t AnimationMixer::get_lod_distance() const {
+	return lod_distance;
+}
+
+void AnimationMixer::set_lod_max_interval(int p_interval) {
+	lod_max_interval = MAX(p_interval, 1);
+}
+
+int AnimationMixer::get_lod_max_interval() const {
+	return lod_max_interval;
+}
+
+void AnimationMixer::set_lod_max_bone_depth(int p_depth) {
+	lod_max_bone_depth = MAX(p_depth, -1);
+}
+
+int AnimationMixer::get_lod_max_bone_depth() const {
+	return lod_max_bone_depth;
+}
+
+void AnimationMixer::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod_visibility_notifier = p_path;
+}
+
+NodePath AnimationMixer::get_lod_visibility_notifier() const {
+	return lod_visibility_notifier;
+}
+
+int AnimationMixer::_get_lod_interval() const {
+	if (lod_distance <= 0 || lod_max_interval <= 1 || !is_inside_tree()) {
+		return 1;
+	}
+	const Node3D *root_3d = Object::cast_to<Node3D>(get_node_or_null(root_node));
+	const Camera3D *camera = get_viewport()->get_camera_3d();
+	if (!root_3d || !camera) {
+		return 1;
+	}
+	const real_t distance = camera->get_global_position().distance_to(root_3d->get_global_position());
+	return CLAMP(1 + (int)(distance / lod_distance), 1, lod_max_interval);
+}
+
+bool AnimationMixer::_lod_process(double p_delta, double &r_delta) {
+	lod_delta += p_delta;
+
+	// Nothing is applied while hidden, the skipped time is caught up with once visible again.
+	const VisibleOnScreenNotifier3D *notifier = Object::cast_to<VisibleOnScreenNotifier3D>(get_node_or_null(lod_visibility_notifier));
+	bool skip = notifier && !notifier->is_on_screen();
+	if (skip) {
+		lod_frame = 0;
+		lod_interpolating = false;
+		lod_from_locs.clear();
+		// Catching up more than the longest animation would only wrap loops around again.
+		lod_delta = MIN(lod_delta, _get_lod_max_delta());
+	} else {
+		lod_frame++;
+		skip = lod_frame < _get_lod_interval();
+		if (skip && lod_interpolating) {
+			_apply_lod_interpolation();
+		}
+	}
+
+	if (skip) {
+		root_motion_position = Vector3(0, 0, 0);
+		root_motion_rotation = Quaternion(0, 0, 0, 1);
+		root_motion_scale = Vector3(0, 0, 0);
+		return false;
+	}
+
+	lod_interval = _get_lod_interval();
+	lod_frame = 0;
+	lod_skip_details = lod_interval > 1 && lod_max_bone_depth >= 0;
+	if (lod_interval > 1) {
+		// The last applied pose is where the interpolation towards the next update starts.
+		lod_from_locs = transform_locs;
+		lod_from_rots = transform_rots;
+		lod_from_scales = transform_scales;
+	}
+	r_delta = lod_delta;
+	lod_delta = 0.0;
+	return true;
+}
+
+double AnimationMixer::_get_lod_max_delta() const {
+	double max_delta = 0.0;
+	for (const KeyValue<StringName, AnimationData> &E : animation_set) {
+		max_delta = MAX(max_delta, E.value.animation->get_length());
+	}
+	return max_delta;
+}
+
+void AnimationMixer::_blend_lod_targets(bool p_interpolate) {
+	// Direct calls, such as seeking, apply their exact pose and stop any interpolation in progress.
+	lod_interpolating = p_interpolate && lod_enabled && lod_interval > 1;
+	if (!lod_interpolating) {
+		return;
+	}
+
+	lod_to_locs = transform_locs;
+	lod_to_rots = transform_rots;
+	lod_to_scales = transform_scales;
+	if (lod_from_locs.size() != transform_locs.size()) {
+		// Caches were rebuilt or nothing was applied yet, start from the blended pose.
+		lod_from_locs = transform_locs;
+		lod_from_rots = transform_rots;
+		lod_from_scales = transform_scales;
+	}
+
+	const real_t weight = 1.0 / lod_interval;
+	for (uint32_t i = 0; i < transform_locs.size(); i++) {
+		transform_locs[i] = lod_from_locs[i].lerp(lod_to_locs[i], weight);
+		transform_rots[i] = lod_from_rots[i].slerp(lod_to_rots[i], weight);
+		transform_scales[i] = lod_from_scales[i].lerp(lod_to_scales[i], weight);
+	}
+}
+
+void AnimationMixer::_apply_lod_interpolation() {
+	if (lod_to_locs.size() != transform_locs.size() || lod_from_locs.size() != transform_locs.size()) {
+		return;
+	}
+
+	const real_t weight = MIN(real_t(lod_frame + 1) / lod_interval, 1.0);
+	for (uint32_t i = 0; i < transform_locs.size(); i++) {
+		transform_locs[i] = lod_from_locs[i].lerp(lod_to_locs[i], weight);
+		transform_rots[i] = lod_from_rots[i].slerp(lod_to_rots[i], weight);
+		transform_scales[i] = lod_from_scales[i].lerp(lod_to_scales[i], weight);
+	}
+
+	for (uint32_t cache_idx = 0; cache_idx < track_cache_list.size(); cache_idx++) {
+		TrackCache *track = track_cache_list[cache_idx];
+		if (track->type != Animation::TYPE_POSITION_3D || _is_lod_detail_track(cache_idx)) {
+			continue;
+		}
+		if (!deterministic && Math::is_zero_approx(track_total_weights[cache_idx])) {
+			continue;
+		}
+		TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+		if (t->root_motion) {
+			continue; // The motion was already handed out by the last update.
+		}
+		if (!_blend_apply_transform(t)) {
+			return;
+		}
+	}
+}
+#endif // _3D_DISABLED
+
 /* -------------------------------------------- */
 /* -- Reset on save --------------------------- */
 /* -------------------------------------------- */
@@ -1985,13 +2410,15 @@ bool AnimationMixer::can_apply_reset() const {
 }
 
 void AnimationMixer::_build_backup_track_cache() {
-	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
-		TrackCache *track = K.value;
+	for (TrackCache *track : track_cache_list) {
 		track->total_weight = 1.0;
 		switch (track->type) {
 			case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
 				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+				t->loc = transform_locs[t->transform_slot];
+				t->rot = transform_rots[t->transform_slot];
+				t->scale = transform_scales[t->transform_slot];
 				if (t->root_motion) {
 					// Do nothing.
 				} else if (t->skeleton_id.is_valid() && t->bone_idx >= 0) {
@@ -2028,6 +2455,7 @@ void AnimationMixer::_build_backup_track_cache() {
 			case Animation::TYPE_BLEND_SHAPE: {
 #ifndef _3D_DISABLED
 				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
+				t->value = blend_shape_values[t->blend_shape_slot];
 				MeshInstance3D *t_mesh_3d = Object::cast_to<MeshInstance3D>(ObjectDB::get_instance(t->object_id));
 				if (t_mesh_3d) {
 					t->value = t_mesh_3d->get_blend_shape_value(t->shape_index);
@@ -2110,9 +2538,15 @@ void AnimationMixer::reset() {
 
 void AnimationMixer::restore(const Ref<AnimatedValuesBackup> &p_backup) {
 	ERR_FAIL_COND(p_backup.is_null());
+	if (blend_pending_stage != BLEND_PENDING_NONE) {
+		_blend_finish_pending();
+	}
 	track_cache = p_backup->get_data();
+	_update_track_cache_layout();
 	_blend_apply();
 	track_cache = HashMap<Animation::TypeHash, AnimationMixer::TrackCache *>();
+	_update_track_cache_layout();
+	animation_track_remaps.clear();
 	cache_valid = false;
 }
 
@@ -2200,18 +2634,19 @@ void AnimationMixer::_notification(int p_what) {
 				set_physics_process_internal(false);
 				set_process_internal(false);
 			}
+			parallel_blending = GLOBAL_GET("animation/mixer/parallel_blending") && !Engine::get_singleton()->is_editor_hint();
 			_clear_caches();
 		} break;
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+				_process_internal(get_process_delta_time());
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+				_process_internal(get_physics_process_delta_time());
 			}
 		} break;
 
@@ -2290,6 +2725,20 @@ void AnimationMixer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_root_motion_rotation_accumulator"), &AnimationMixer::get_root_motion_rotation_accumulator);
 	ClassDB::bind_method(D_METHOD("get_root_motion_scale_accumulator"), &AnimationMixer::get_root_motion_scale_accumulator);
 
+	/* ---- Animation LOD ---- */
+#ifndef _3D_DISABLED
+	ClassDB::bind_method(D_METHOD("set_lod_enabled", "enabled"), &AnimationMixer::set_lod_enabled);
+	ClassDB::bind_method(D_METHOD("is_lod_enabled"), &AnimationMixer::is_lod_enabled);
+	ClassDB::bind_method(D_METHOD("set_lod_distance", "distance"), &AnimationMixer::set_lod_distance);
+	ClassDB::bind_method(D_METHOD("get_lod_distance"), &AnimationMixer::get_lod_distance);
+	ClassDB::bind_method(D_METHOD("set_lod_max_interval", "interval"), &AnimationMixer::set_lod_max_interval);
+	ClassDB::bind_method(D_METHOD("get_lod_max_interval"), &AnimationMixer::get_lod_max_interval);
+	ClassDB::bind_method(D_METHOD("set_lod_max_bone_depth", "depth"), &AnimationMixer::set_lod_max_bone_depth);
+	ClassDB::bind_method(D_METHOD("get_lod_max_bone_depth"), &AnimationMixer::get_lod_max_bone_depth);
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationMixer::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationMixer::get_lod_visibility_notifier);
+#endif // _3D_DISABLED
+
 	/* ---- Blending processor ---- */
 	ClassDB::bind_method(D_METHOD("clear_caches"), &AnimationMixer::clear_caches);
 	ClassDB::bind_method(D_METHOD("advance", "delta"), &AnimationMixer::advance);
@@ -2310,6 +2759,15 @@ void AnimationMixer::_bind_methods() {
 	ADD_GROUP("Root Motion", "root_motion_");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
 
+#ifndef _3D_DISABLED
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lod_enabled"), "set_lod_enabled", "is_lod_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance", PROPERTY_HINT_RANGE, "0,1000,0.01,or_greater,suffix:m"), "set_lod_distance", "get_lod_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_interval", PROPERTY_HINT_RANGE, "1,16,1,or_greater"), "set_lod_max_interval", "get_lod_max_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_bone_depth", PROPERTY_HINT_RANGE, "-1,64,1,or_greater"), "set_lod_max_bone_depth", "get_lod_max_bone_depth");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+
+#endif // _3D_DISABLED
 	ADD_GROUP("Audio", "audio_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "audio_max_polyphony", PROPERTY_HINT_RANGE, "1,127,1"), "set_audio_max_polyphony", "get_audio_max_polyphony");
 
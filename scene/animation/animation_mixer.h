@@ -146,7 +146,8 @@ protected:
 		Animation::TrackType type = Animation::TrackType::TYPE_ANIMATION;
 		NodePath path;
 		ObjectID object_id;
-		real_t total_weight = 0.0;
+		real_t total_weight = 0.0; // Only used by backups, blending uses track_total_weights.
+		int index = -1; // In track_cache_list.
 
 		TrackCache() = default;
 		TrackCache(const TrackCache &p_other) :
@@ -154,7 +155,8 @@ protected:
 				setup_pass(p_other.setup_pass),
 				type(p_other.type),
 				object_id(p_other.object_id),
-				total_weight(p_other.total_weight) {}
+				total_weight(p_other.total_weight),
+				index(p_other.index) {}
 
 		virtual ~TrackCache() {}
 	};
@@ -164,15 +166,18 @@ protected:
 		ObjectID skeleton_id;
 #endif // _3D_DISABLED
 		int bone_idx = -1;
+		int bone_depth = 0; // Amount of ancestors of the bone.
 		bool loc_used = false;
 		bool rot_used = false;
 		bool scale_used = false;
 		Vector3 init_loc = Vector3(0, 0, 0);
 		Quaternion init_rot = Quaternion(0, 0, 0, 1);
 		Vector3 init_scale = Vector3(1, 1, 1);
+		// Only used by backups, blending uses the transform arrays of the mixer.
 		Vector3 loc;
 		Quaternion rot;
 		Vector3 scale;
+		int transform_slot = -1;
 
 		TrackCacheTransform(const TrackCacheTransform &p_other) :
 				TrackCache(p_other),
@@ -180,6 +185,7 @@ protected:
 				skeleton_id(p_other.skeleton_id),
 #endif
 				bone_idx(p_other.bone_idx),
+				bone_depth(p_other.bone_depth),
 				loc_used(p_other.loc_used),
 				rot_used(p_other.rot_used),
 				scale_used(p_other.scale_used),
@@ -188,7 +194,8 @@ protected:
 				init_scale(p_other.init_scale),
 				loc(p_other.loc),
 				rot(p_other.rot),
-				scale(p_other.scale) {
+				scale(p_other.scale),
+				transform_slot(p_other.transform_slot) {
 		}
 
 		TrackCacheTransform() {
@@ -205,14 +212,16 @@ protected:
 
 	struct TrackCacheBlendShape : public TrackCache {
 		float init_value = 0;
-		float value = 0;
+		float value = 0; // Only used by backups, blending uses blend_shape_values.
 		int shape_index = -1;
+		int blend_shape_slot = -1;
 
 		TrackCacheBlendShape(const TrackCacheBlendShape &p_other) :
 				TrackCache(p_other),
 				init_value(p_other.init_value),
 				value(p_other.value),
-				shape_index(p_other.shape_index) {}
+				shape_index(p_other.shape_index),
+				blend_shape_slot(p_other.blend_shape_slot) {}
 
 		TrackCacheBlendShape() { type = Animation::TYPE_BLEND_SHAPE; }
 		~TrackCacheBlendShape() {}
@@ -309,12 +318,41 @@ protected:
 	HashSet<TrackCache *> playing_caches;
 	Vector<Node *> playing_audio_stream_players;
 
+	// Flat layout of track_cache, so blending doesn't look up the caches of every track of every animation.
+	// Caches are listed in the order of track_cache, which is the order of their blend index in track_map.
+	// Transforms and blend shapes are blended in contiguous arrays, indexed by the slot of their cache.
+	LocalVector<TrackCache *> track_cache_list;
+	LocalVector<int> track_blend_indices;
+	LocalVector<real_t> track_total_weights;
+	LocalVector<Vector3> transform_init_locs;
+	LocalVector<Quaternion> transform_init_rots;
+	LocalVector<Vector3> transform_init_scales;
+	LocalVector<Vector3> transform_locs;
+	LocalVector<Quaternion> transform_rots;
+	LocalVector<Vector3> transform_scales;
+	LocalVector<float> blend_shape_init_values;
+	LocalVector<float> blend_shape_values;
+#ifndef _3D_DISABLED
+	LocalVector<int> track_lod_depths; // Bone depth of transforms, blend shapes are always details.
+	Animation::CompressedPose compressed_pose; // Compressed tracks of the animation being blended.
+#endif // _3D_DISABLED
+
+	// Index in track_cache_list of every track of the cached animations, -1 for tracks without a cache.
+	HashMap<ObjectID, LocalVector<int>> animation_track_remaps;
+	LocalVector<int> uncached_track_remap;
+	// Tracks of an animation sharing a cache only add their weight once.
+	LocalVector<uint64_t> track_weight_passes;
+	uint64_t track_weight_pass = 0;
+
 	// Helpers.
 	void _clear_caches();
 	void _clear_audio_streams();
 	void _clear_playing_caches();
 	void _init_root_motion_cache();
 	bool _update_caches();
+	void _update_track_cache_layout();
+	void _make_animation_track_remap(const Ref<Animation> &p_animation, LocalVector<int> &r_remap) const;
+	const LocalVector<int> &_get_animation_track_remap(const Ref<Animation> &p_animation);
 
 	/* ---- Audio ---- */
 	AudioServer::PlaybackType playback_type;
@@ -325,6 +363,56 @@ protected:
 	int track_count = 0;
 	bool deterministic = false;
 
+	enum BlendProcessTracks {
+		BLEND_PROCESS_TRACKS_ALL,
+		BLEND_PROCESS_TRACKS_SAMPLED, // Only accumulate into their track cache, can be blended on threads.
+		BLEND_PROCESS_TRACKS_EVENTS, // Discrete values, methods, audio and animations, which have side effects.
+	};
+
+	enum BlendPendingStage {
+		BLEND_PENDING_NONE,
+		BLEND_PENDING_SAMPLE,
+		BLEND_PENDING_APPLY,
+	};
+
+	// Mixers processed by the tree queue the sampled tracks here when parallel blending is enabled,
+	// they are blended on threads together and applied once the tree has processed every node.
+	static LocalVector<ObjectID> pending_blend_mixers;
+	bool parallel_blending = false;
+	BlendPendingStage blend_pending_stage = BLEND_PENDING_NONE;
+	double blend_pending_delta = 0.0;
+
+#ifndef _3D_DISABLED
+	/* ---- Animation LOD ---- */
+	bool lod_enabled = false;
+	real_t lod_distance = 20.0;
+	int lod_max_interval = 4;
+	int lod_max_bone_depth = -1;
+	NodePath lod_visibility_notifier;
+
+	// Updates are spread over lod_interval frames, in between transforms are interpolated
+	// from the values applied before the last update to the values it blended.
+	int lod_interval = 1;
+	int lod_frame = 0;
+	double lod_delta = 0.0;
+	bool lod_skip_details = false;
+	bool lod_interpolating = false;
+	bool lod_processing = false; // Set while blending from _process_internal().
+	LocalVector<Vector3> lod_from_locs;
+	LocalVector<Quaternion> lod_from_rots;
+	LocalVector<Vector3> lod_from_scales;
+	LocalVector<Vector3> lod_to_locs;
+	LocalVector<Quaternion> lod_to_rots;
+	LocalVector<Vector3> lod_to_scales;
+
+	int _get_lod_interval() const;
+	bool _is_lod_detail_track(int p_cache_idx) const { return lod_skip_details && track_lod_depths[p_cache_idx] > lod_max_bone_depth; }
+	bool _lod_process(double p_delta, double &r_delta);
+	double _get_lod_max_delta() const;
+	void _blend_lod_targets(bool p_interpolate);
+	void _apply_lod_interpolation();
+#endif // _3D_DISABLED
+
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
 	Vector3 root_motion_position = Vector3(0, 0, 0);
@@ -354,6 +442,11 @@ protected:
 
 	/* ---- Blending processor ---- */
 	virtual void _process_animation(double p_delta, bool p_update_only = false);
+	void _process_internal(double p_delta);
+	void _queue_process_animation(double p_delta);
+	void _blend_finish_pending();
+	static void _blend_pending_sample(void *p_userdata, uint32_t p_index);
+	static void _flush_pending_blends();
 
 	// For post process with retrieved key value during blending.
 	virtual Variant _post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant p_value, ObjectID p_object_id, int p_object_sub_idx = -1);
@@ -364,8 +457,9 @@ protected:
 	virtual bool _blend_pre_process(double p_delta, int p_track_count, const HashMap<NodePath, int> &p_track_map);
 	virtual void _blend_capture(double p_delta);
 	void _blend_calc_total_weight(); // For undeterministic blending.
-	void _blend_process(double p_delta, bool p_update_only = false);
+	void _blend_process(double p_delta, bool p_update_only = false, BlendProcessTracks p_tracks = BLEND_PROCESS_TRACKS_ALL);
 	void _blend_apply();
+	bool _blend_apply_transform(TrackCacheTransform *p_track);
 	virtual void _blend_post_process();
 	void _call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred);
 
@@ -435,6 +529,24 @@ public:
 	void set_audio_max_polyphony(int p_audio_max_polyphony);
 	int get_audio_max_polyphony() const;
 
+#ifndef _3D_DISABLED
+	/* ---- Animation LOD ---- */
+	void set_lod_enabled(bool p_enabled);
+	bool is_lod_enabled() const;
+
+	void set_lod_distance(real_t p_distance);
+	real_t get_lod_distance() const;
+
+	void set_lod_max_interval(int p_interval);
+	int get_lod_max_interval() const;
+
+	void set_lod_max_bone_depth(int p_depth);
+	int get_lod_max_bone_depth() const;
+
+	void set_lod_visibility_notifier(const NodePath &p_path);
+	NodePath get_lod_visibility_notifier() const;
+#endif // _3D_DISABLED
+
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	void set_root_motion_track(const NodePath &p_track);
 	NodePath get_root_motion_track() const;
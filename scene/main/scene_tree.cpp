@@ -59,6 +59,7 @@
 #include "servers/navigation_server_3d.h"
 #include "servers/physics_server_2d.h"
 #ifndef _3D_DISABLED
+#include "scene/3d/node_3d_transform_store.h"
 #include "scene/resources/3d/world_3d.h"
 #include "servers/physics_server_3d.h"
 #endif // _3D_DISABLED
@@ -178,6 +179,12 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+#ifndef _3D_DISABLED
+	if (transform_store_3d) {
+		transform_store_3d->update_global_transforms();
+	}
+#endif // _3D_DISABLED
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -188,6 +195,21 @@ void SceneTree::flush_transform_notifications() {
 	}
 }
 
+void SceneTree::set_use_transform_store_3d(bool p_enable) {
+#ifndef _3D_DISABLED
+	if (p_enable == (transform_store_3d != nullptr)) {
+		return;
+	}
+	if (p_enable) {
+		transform_store_3d = memnew(Node3DTransformStore);
+	} else {
+		ERR_FAIL_COND_MSG(transform_store_3d->get_node_count() != 0, "The transform store can't be disabled while Node3Ds are using it.");
+		memdelete(transform_store_3d);
+		transform_store_3d = nullptr;
+	}
+#endif // _3D_DISABLED
+}
+
 void SceneTree::_flush_ugc() {
 	ugc_locked = true;
 
@@ -1042,6 +1064,12 @@ void SceneTree::_process(bool p_physics) {
 				}
 
 				if (using_threads) {
+#ifndef _3D_DISABLED
+					// Threads don't write to the store, so cache what the previous groups changed.
+					if (transform_store_3d) {
+						transform_store_3d->update_global_transforms();
+					}
+#endif // _3D_DISABLED
 					WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_groups_thread, p_physics, local_process_group_cache.size(), -1, true);
 					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
 				}
@@ -1739,6 +1767,12 @@ SceneTree::SceneTree() {
 	process_group_call_queue_allocator = memnew(CallQueue::Allocator(64));
 	Math::randomize();
 
+#ifndef _3D_DISABLED
+	if (GLOBAL_DEF_RST("application/run/use_transform_store_3d", false) && !Engine::get_singleton()->is_editor_hint()) {
+		set_use_transform_store_3d(true);
+	}
+#endif // _3D_DISABLED
+
 	// Create with mainloop.
 
 	root = memnew(Window);
@@ -1908,6 +1942,12 @@ SceneTree::~SceneTree() {
 
 	memdelete(process_group_call_queue_allocator);
 
+#ifndef _3D_DISABLED
+	if (transform_store_3d) {
+		memdelete(transform_store_3d);
+	}
+#endif // _3D_DISABLED
+
 	if (singleton == this) {
 		singleton = nullptr;
 	}
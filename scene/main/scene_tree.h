@@ -41,6 +41,7 @@
 
 class PackedScene;
 class Node;
+class Node3DTransformStore;
 class Window;
 class Material;
 class Mesh;
@@ -233,6 +234,7 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	Node3DTransformStore *transform_store_3d = nullptr;
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -309,6 +311,8 @@ public:
 	}
 
 	void flush_transform_notifications();
+	_FORCE_INLINE_ Node3DTransformStore *get_transform_store_3d() const { return transform_store_3d; }
+	void set_use_transform_store_3d(bool p_enable);
 
 	virtual void initialize() override;
 
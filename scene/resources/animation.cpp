@@ -33,6 +33,7 @@
 
 #include "core/io/marshalls.h"
 #include "core/math/geometry_3d.h"
+#include "core/math/simd_batch.h"
 
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 	String prop_name = p_name;
@@ -5136,6 +5137,163 @@ bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track,
 	return true;
 }
 
+// Same as _uncompress_quaternion(), from normalized values.
+static _FORCE_INLINE_ void _uncompress_quaternion_unorm(float p_x, float p_y, float p_angle, float *r_quaternion) {
+	// Octahedron decoding of the axis.
+	float nx = p_x * 2.0f - 1.0f;
+	float ny = p_y * 2.0f - 1.0f;
+	const float nz = 1.0f - Math::abs(nx) - Math::abs(ny);
+	const float t = CLAMP(-nz, 0.0f, 1.0f);
+	nx += nx >= 0 ? -t : t;
+	ny += ny >= 0 ? -t : t;
+	const float s = Math::sin(p_angle * (float)Math_PI) / Math::sqrt(nx * nx + ny * ny + nz * nz);
+	r_quaternion[0] = nx * s;
+	r_quaternion[1] = ny * s;
+	r_quaternion[2] = nz * s;
+	r_quaternion[3] = Math::cos(p_angle * (float)Math_PI);
+}
+
+bool Animation::sample_compressed_pose(double p_time, CompressedPose &r_pose) const {
+	ERR_FAIL_COND_V(!compression.enabled, false);
+	p_time = CLAMP(p_time, 0, length);
+
+	// All tracks are sampled from the same page.
+	int32_t page_index = _find_compressed_page(p_time);
+	ERR_FAIL_COND_V(page_index == -1, false); // Should not happen.
+
+	const uint32_t compressed_track_count = compression.bounds.size();
+	r_pose.tracks.resize(compressed_track_count);
+	r_pose.types.resize(compressed_track_count);
+	r_pose.slots.resize(tracks.size());
+	r_pose.x.resize(compressed_track_count);
+	r_pose.y.resize(compressed_track_count);
+	r_pose.z.resize(compressed_track_count);
+	r_pose.w.resize(compressed_track_count);
+	r_pose.next_x.resize(compressed_track_count);
+	r_pose.next_y.resize(compressed_track_count);
+	r_pose.next_z.resize(compressed_track_count);
+	r_pose.weights.resize(compressed_track_count);
+	r_pose.offsets_x.resize(compressed_track_count);
+	r_pose.offsets_y.resize(compressed_track_count);
+	r_pose.offsets_z.resize(compressed_track_count);
+	r_pose.scales_x.resize(compressed_track_count);
+	r_pose.scales_y.resize(compressed_track_count);
+	r_pose.scales_z.resize(compressed_track_count);
+
+	// Keys are delta encoded in a bit stream, so they're decoded one track at a time.
+	// Only their normalized values are stored, to be uncompressed for all the tracks of a type together.
+	// Rescaled tracks fill the slots from the front and rotations from the back, so each kind is contiguous.
+	uint32_t rescaled_count = 0;
+	uint32_t rotation_start = compressed_track_count;
+	for (int i = 0; i < tracks.size(); i++) {
+		const Track *t = tracks[i];
+		int32_t compressed_track = -1;
+		switch (t->type) {
+			case TYPE_POSITION_3D: {
+				compressed_track = static_cast<const PositionTrack *>(t)->compressed_track;
+			} break;
+			case TYPE_ROTATION_3D: {
+				compressed_track = static_cast<const RotationTrack *>(t)->compressed_track;
+			} break;
+			case TYPE_SCALE_3D: {
+				compressed_track = static_cast<const ScaleTrack *>(t)->compressed_track;
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				compressed_track = static_cast<const BlendShapeTrack *>(t)->compressed_track;
+			} break;
+			default: {
+			} break;
+		}
+		r_pose.slots[i] = -1;
+		if (compressed_track < 0) {
+			continue;
+		}
+		ERR_FAIL_COND_V(rescaled_count == rotation_start, false); // Should not happen.
+
+		Vector3i current;
+		Vector3i next;
+		double time_current;
+		double time_next;
+		uint32_t slot;
+		if (t->type == TYPE_BLEND_SHAPE) {
+			ERR_FAIL_COND_V(!_fetch_compressed_in_page<1>(page_index, compressed_track, p_time, current, time_current, next, time_next), false);
+			current.y = current.z = next.y = next.z = 0;
+			slot = rescaled_count++;
+			// Same as (unorm * 2.0 - 1.0) * BLEND_SHAPE_RANGE, the range is a power of two.
+			r_pose.offsets_x[slot] = -float(Compression::BLEND_SHAPE_RANGE);
+			r_pose.scales_x[slot] = 2.0f * float(Compression::BLEND_SHAPE_RANGE);
+			r_pose.offsets_y[slot] = r_pose.offsets_z[slot] = 0.0f;
+			r_pose.scales_y[slot] = r_pose.scales_z[slot] = 0.0f;
+		} else {
+			ERR_FAIL_COND_V(!_fetch_compressed_in_page<3>(page_index, compressed_track, p_time, current, time_current, next, time_next), false);
+			if (t->type == TYPE_ROTATION_3D) {
+				slot = --rotation_start;
+			} else {
+				slot = rescaled_count++;
+				const AABB &bounds = compression.bounds[compressed_track];
+				r_pose.offsets_x[slot] = bounds.position.x;
+				r_pose.offsets_y[slot] = bounds.position.y;
+				r_pose.offsets_z[slot] = bounds.position.z;
+				r_pose.scales_x[slot] = bounds.size.x;
+				r_pose.scales_y[slot] = bounds.size.y;
+				r_pose.scales_z[slot] = bounds.size.z;
+			}
+		}
+
+		float weight = 0.0;
+		if (time_current >= p_time || time_current == time_next) {
+			weight = 0.0;
+		} else if (p_time >= time_next) {
+			current = next;
+		} else {
+			weight = (p_time - time_current) / (time_next - time_current);
+		}
+
+		r_pose.tracks[slot] = i;
+		r_pose.slots[i] = slot;
+		r_pose.types[slot] = t->type;
+		r_pose.x[slot] = float(current.x) / 65535.0;
+		r_pose.y[slot] = float(current.y) / 65535.0;
+		r_pose.z[slot] = float(current.z) / 65535.0;
+		r_pose.next_x[slot] = float(next.x) / 65535.0;
+		r_pose.next_y[slot] = float(next.y) / 65535.0;
+		r_pose.next_z[slot] = float(next.z) / 65535.0;
+		r_pose.weights[slot] = weight;
+	}
+	ERR_FAIL_COND_V(rescaled_count != rotation_start, false); // Should not happen.
+	r_pose.rotation_start = rotation_start;
+
+	float *x = r_pose.x.ptr();
+	float *y = r_pose.y.ptr();
+	float *z = r_pose.z.ptr();
+	float *w = r_pose.w.ptr();
+	const float *next_x = r_pose.next_x.ptr();
+	const float *next_y = r_pose.next_y.ptr();
+	const float *next_z = r_pose.next_z.ptr();
+	const float *weights = r_pose.weights.ptr();
+
+	// Interpolating the normalized values is the same as interpolating the uncompressed ones.
+	SIMDBatch::lerp_rescale(x, next_x, weights, r_pose.scales_x.ptr(), r_pose.offsets_x.ptr(), x, rescaled_count);
+	SIMDBatch::lerp_rescale(y, next_y, weights, r_pose.scales_y.ptr(), r_pose.offsets_y.ptr(), y, rescaled_count);
+	SIMDBatch::lerp_rescale(z, next_z, weights, r_pose.scales_z.ptr(), r_pose.offsets_z.ptr(), z, rescaled_count);
+
+	// Rotations are slerped like in _rotation_interpolate_compressed(), keys can be far apart.
+	// This needs trigonometry per track, so it stays scalar.
+	for (uint32_t i = rotation_start; i < compressed_track_count; i++) {
+		float from[4];
+		float to[4];
+		_uncompress_quaternion_unorm(x[i], y[i], z[i], from);
+		_uncompress_quaternion_unorm(next_x[i], next_y[i], next_z[i], to);
+		const Quaternion rotation = Quaternion(from[0], from[1], from[2], from[3]).slerp(Quaternion(to[0], to[1], to[2], to[3]), weights[i]);
+		x[i] = rotation.x;
+		y[i] = rotation.y;
+		z[i] = rotation.z;
+		w[i] = rotation.w;
+	}
+
+	return true;
+}
+
 template <uint32_t COMPONENTS>
 bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
 	ERR_FAIL_COND_V(!compression.enabled, false);
@@ -5145,8 +5303,13 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 		*key_index = 0;
 	}
 
-	double frame_to_sec = 1.0 / double(compression.fps);
+	int32_t page_index = _find_compressed_page(p_time);
+	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
+
+	return _fetch_compressed_in_page<COMPONENTS>(page_index, p_compressed_track, p_time, r_current_value, r_current_time, r_next_value, r_next_time, key_index);
+}
 
+int32_t Animation::_find_compressed_page(double p_time) const {
 	int32_t page_index = -1;
 	for (uint32_t i = 0; i < compression.pages.size(); i++) {
 		if (compression.pages[i].time_offset > p_time) {
@@ -5154,8 +5317,13 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 		}
 		page_index = i;
 	}
+	return page_index;
+}
 
-	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
+template <uint32_t COMPONENTS>
+bool Animation::_fetch_compressed_in_page(uint32_t p_page, uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
+	double frame_to_sec = 1.0 / double(compression.fps);
+	uint32_t page_index = p_page;
 
 	double page_base_time = compression.pages[page_index].time_offset;
 	const uint8_t *page_data = compression.pages[page_index].data.ptr();
@@ -90,6 +90,32 @@ public:
 		FIND_MODE_EXACT,
 	};
 
+	// Every compressed track sampled at the same time by sample_compressed_pose().
+	// Components are stored in separate arrays with one slot per compressed track: x, y and z for position and scale,
+	// x, y, z and w for rotation, and x for blend shape tracks. Rotations take the slots from rotation_start on.
+	struct CompressedPose {
+		LocalVector<int> tracks; // Track index of every slot.
+		LocalVector<int> slots; // Slot of every track, -1 for tracks that aren't compressed.
+		LocalVector<TrackType> types;
+		LocalVector<float> x;
+		LocalVector<float> y;
+		LocalVector<float> z;
+		LocalVector<float> w;
+		uint32_t rotation_start = 0;
+
+		// Keys surrounding the sampled time and the bounds they are rescaled to, only used while sampling.
+		LocalVector<float> next_x;
+		LocalVector<float> next_y;
+		LocalVector<float> next_z;
+		LocalVector<float> weights;
+		LocalVector<float> offsets_x;
+		LocalVector<float> offsets_y;
+		LocalVector<float> offsets_z;
+		LocalVector<float> scales_x;
+		LocalVector<float> scales_y;
+		LocalVector<float> scales_z;
+	};
+
 #ifdef TOOLS_ENABLED
 	enum HandleMode {
 		HANDLE_MODE_FREE,
@@ -349,6 +375,9 @@ private:
 	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
+	int32_t _find_compressed_page(double p_time) const;
+	template <uint32_t COMPONENTS>
+	bool _fetch_compressed_in_page(uint32_t p_page, uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed_by_index(uint32_t p_compressed_track, int p_index, Vector3i &r_value, double &r_time) const;
 	int _get_compressed_key_count(uint32_t p_compressed_track) const;
@@ -510,6 +539,8 @@ public:
 
 	void optimize(real_t p_allowed_velocity_err = 0.01, real_t p_allowed_angular_err = 0.01, int p_precision = 3);
 	void compress(uint32_t p_page_size = 8192, uint32_t p_fps = 120, float p_split_tolerance = 4.0); // 4.0 seems to be the split tolerance sweet spot from many tests.
+	bool is_compressed() const { return compression.enabled; }
+	bool sample_compressed_pose(double p_time, CompressedPose &r_pose) const;
 
 	// Helper functions for Variant.
 	static bool is_variant_interpolatable(const Variant p_value);
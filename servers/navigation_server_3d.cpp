@@ -72,6 +72,9 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_random_point", "map", "navigation_layers", "uniformly"), &NavigationServer3D::map_get_random_point);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_path_batch", "parameters", "results", "callback"), &NavigationServer3D::query_path_batch, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("is_path_query_batch_completed", "batch_id"), &NavigationServer3D::is_path_query_batch_completed);
+	ClassDB::bind_method(D_METHOD("wait_for_path_query_batch_completion", "batch_id"), &NavigationServer3D::wait_for_path_query_batch_completion);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer3D::region_set_enabled);
@@ -242,6 +245,9 @@ NavigationServer3D::NavigationServer3D() {
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_high_priority_threads", true);
 
+	GLOBAL_DEF("navigation/pathfinding/use_hierarchical_pathfinding", false);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "navigation/pathfinding/hierarchical_cluster_size", PROPERTY_HINT_RANGE, "0.1,1000,0.1,or_greater"), 16.0);
+
 	GLOBAL_DEF("navigation/baking/use_crash_prevention_checks", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_high_priority_threads", true);
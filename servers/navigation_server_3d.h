@@ -344,6 +344,13 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Queries many paths at once, spread over the WorkerThreadPool.
+	/// Results are written to the result objects when the batch completes,
+	/// which is reported through the callback or by polling the returned ID.
+	virtual int64_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) = 0;
+	virtual bool is_path_query_batch_completed(int64_t p_batch_id) = 0;
+	virtual void wait_for_path_query_batch_completion(int64_t p_batch_id) = 0;
+
 #ifndef _3D_DISABLED
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
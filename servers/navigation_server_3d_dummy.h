@@ -195,6 +195,9 @@ public:
 	void finish() override {}
 
 	NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override { return NavigationUtilities::PathQueryResult(); }
+	int64_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override { return -1; }
+	bool is_path_query_batch_completed(int64_t p_batch_id) override { return true; }
+	void wait_for_path_query_batch_completion(int64_t p_batch_id) override {}
 	int get_process_info(ProcessInfo p_info) const override { return 0; }
 
 	void set_debug_enabled(bool p_enabled) {}
@@ -33,11 +33,15 @@
 #include "godot_collision_solver_2d.h"
 #include "godot_physics_server_2d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/templates/pair.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+#define RAY_BATCH_PARALLEL_MIN_RAYS 64
+#define RAY_BATCH_PACKET_SIZE 16
+#define SHAPE_BATCH_PARALLEL_MIN_QUERIES 16
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
@@ -114,16 +118,10 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
-	Vector2 begin, end;
-	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
-
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+static bool _intersect_ray_candidates(const PhysicsDirectSpaceState2D::RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D *const *p_objects, const int *p_shapes, int p_amount, PhysicsDirectSpaceState2D::RayResult &r_result) {
+	const Vector2 &begin = p_from;
+	const Vector2 &end = p_to;
+	Vector2 normal = (end - begin).normalized();
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -133,18 +131,18 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject2D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_shapes[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -204,39 +202,116 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
 
-	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
-	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
-	aabb = aabb.grow(p_parameters.margin);
+	return _intersect_ray_candidates(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+void GodotPhysicsDirectSpaceState2D::_intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch) {
+	const uint32_t first = p_batch->offsets[p_index];
+	const Vector2 &from = p_batch->origins[p_index];
+	p_batch->hits[p_index] = _intersect_ray_candidates(*p_batch->parameters, from, from + p_batch->motions[p_index], p_batch->objects + first, p_batch->shapes + first, p_batch->offsets[p_index + 1] - first, p_batch->results[p_index]);
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	ERR_FAIL_COND(p_count < 0);
+
+	// All the buffers are local, so that batches can run concurrently.
+	LocalVector<GodotCollisionObject2D *> cull_objects;
+	LocalVector<int> cull_shapes;
+	cull_objects.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	cull_shapes.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+
+	// Broadphase candidates of every ray, ray i owns [offsets[i], offsets[i + 1]).
+	LocalVector<GodotCollisionObject2D *> objects;
+	LocalVector<int> shapes;
+	LocalVector<uint32_t> offsets;
+	offsets.resize(p_count + 1);
+
+	// The broadphase is traversed once per packet of consecutive rays, with
+	// their combined bounds. Each ray then keeps the candidates whose bounds
+	// its segment goes through, which are the ones cull_segment() would
+	// return. The traversal stays serial, only the shape tests run in parallel.
+	for (int packet_begin = 0; packet_begin < p_count; packet_begin += RAY_BATCH_PACKET_SIZE) {
+		const int packet_end = MIN(packet_begin + RAY_BATCH_PACKET_SIZE, p_count);
+		Rect2 packet_bounds(p_origins[packet_begin], Vector2());
+		for (int i = packet_begin; i < packet_end; i++) {
+			packet_bounds.expand_to(p_origins[i]);
+			packet_bounds.expand_to(p_origins[i] + p_motions[i]);
+		}
+
+		int amount = space->broadphase->cull_aabb(packet_bounds, cull_objects.ptr(), GodotSpace2D::INTERSECTION_QUERY_MAX, cull_shapes.ptr());
+		if (amount < GodotSpace2D::INTERSECTION_QUERY_MAX) {
+			for (int i = packet_begin; i < packet_end; i++) {
+				offsets[i] = objects.size();
+				const Vector2 &from = p_origins[i];
+				const Vector2 to = from + p_motions[i];
+				for (int j = 0; j < amount; j++) {
+					if (cull_objects[j]->get_shape_aabb(cull_shapes[j]).intersects_segment(from, to)) {
+						objects.push_back(cull_objects[j]);
+						shapes.push_back(cull_shapes[j]);
+					}
+				}
+			}
+		} else {
+			// Too many candidates for the whole packet, cull its rays one by one.
+			for (int i = packet_begin; i < packet_end; i++) {
+				offsets[i] = objects.size();
+				int ray_amount = space->broadphase->cull_segment(p_origins[i], p_origins[i] + p_motions[i], cull_objects.ptr(), GodotSpace2D::INTERSECTION_QUERY_MAX, cull_shapes.ptr());
+				for (int j = 0; j < ray_amount; j++) {
+					objects.push_back(cull_objects[j]);
+					shapes.push_back(cull_shapes[j]);
+				}
+			}
+		}
+	}
+	offsets[p_count] = objects.size();
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.objects = objects.ptr();
+	batch.shapes = shapes.ptr();
+	batch.offsets = offsets.ptr();
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	if (p_count < RAY_BATCH_PARALLEL_MIN_RAYS) {
+		for (int i = 0; i < p_count; i++) {
+			_intersect_ray_batch_task(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_ray_batch_task, &batch, p_count, -1, true, SNAME("Physics2DRayBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
 
+static int _intersect_shape_candidates(const PhysicsDirectSpaceState2D::ShapeParameters &p_parameters, const GodotShape2D *p_shape, const Transform2D &p_transform, GodotCollisionObject2D *const *p_objects, const int *p_shapes, int p_amount, PhysicsDirectSpaceState2D::ShapeResult *r_results, int p_result_max) {
 	int cc = 0;
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 		if (cc >= p_result_max) {
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = p_objects[i];
+		int shape_idx = p_shapes[i];
 
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (!GodotCollisionSolver2D::solve(p_shape, p_transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
@@ -253,9 +328,13 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
 	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
+	ERR_FAIL_NULL_V(shape, 0);
 
 	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
@@ -263,33 +342,37 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 
 	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
+	return _intersect_shape_candidates(p_parameters, shape, p_parameters.transform, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_results, p_result_max);
+}
+
+static void _cast_motion_candidates(const PhysicsDirectSpaceState2D::ShapeParameters &p_parameters, const GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, GodotCollisionObject2D *const *p_objects, const int *p_shapes, int p_amount, real_t &p_closest_safe, real_t &p_closest_unsafe) {
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = p_objects[i];
+		int shape_idx = p_shapes[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (!GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
-		if (GodotCollisionSolver2D::solve(shape, p_parameters.transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (GodotCollisionSolver2D::solve(p_shape, p_transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
-		Vector2 mnormal = p_parameters.motion.normalized();
+		Vector2 mnormal = p_motion.normalized();
 
 		//just do kinematic solving
 		real_t low = 0.0;
@@ -299,7 +382,7 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
 			Vector2 sep = mnormal; //important optimization for this to work fast enough
-			bool collided = GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
+			bool collided = GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
 
 			if (collided) {
 				hi = fraction;
@@ -332,10 +415,145 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 
 	p_closest_safe = best_safe;
 	p_closest_unsafe = best_unsafe;
+}
+
+bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
+	aabb = aabb.grow(p_parameters.margin);
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	_cast_motion_candidates(p_parameters, shape, p_parameters.transform, p_parameters.motion, space->intersection_query_results, space->intersection_query_subindex_results, amount, p_closest_safe, p_closest_unsafe);
 
 	return true;
 }
 
+void GodotPhysicsDirectSpaceState2D::_cull_shape_batch(const Rect2 *p_bounds, int p_count, LocalVector<GodotCollisionObject2D *> &r_objects, LocalVector<int> &r_shapes, LocalVector<uint32_t> &r_offsets) {
+	// All the buffers are local, so that batches can run concurrently.
+	LocalVector<GodotCollisionObject2D *> cull_objects;
+	LocalVector<int> cull_shapes;
+	cull_objects.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	cull_shapes.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+
+	// Query i owns the candidates in [r_offsets[i], r_offsets[i + 1]).
+	r_offsets.resize(p_count + 1);
+	for (int i = 0; i < p_count; i++) {
+		r_offsets[i] = r_objects.size();
+		int amount = space->broadphase->cull_aabb(p_bounds[i], cull_objects.ptr(), GodotSpace2D::INTERSECTION_QUERY_MAX, cull_shapes.ptr());
+		for (int j = 0; j < amount; j++) {
+			r_objects.push_back(cull_objects[j]);
+			r_shapes.push_back(cull_shapes[j]);
+		}
+	}
+	r_offsets[p_count] = r_objects.size();
+}
+
+void GodotPhysicsDirectSpaceState2D::_intersect_shape_batch_task(uint32_t p_index, ShapeBatch *p_batch) {
+	const uint32_t first = p_batch->offsets[p_index];
+	p_batch->counts[p_index] = _intersect_shape_candidates(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], p_batch->objects + first, p_batch->shapes + first, p_batch->offsets[p_index + 1] - first, p_batch->results + p_index * p_batch->result_max, p_batch->result_max);
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_shapes(const ShapeParameters &p_parameters, const Transform2D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_counts) {
+	ERR_FAIL_COND(space->locked);
+	ERR_FAIL_COND(p_count < 0);
+	if (p_result_max <= 0) {
+		for (int i = 0; i < p_count; i++) {
+			r_counts[i] = 0;
+		}
+		return;
+	}
+
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	LocalVector<Rect2> bounds;
+	bounds.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Rect2 aabb = p_transforms[i].xform(shape->get_aabb());
+		aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
+		bounds[i] = aabb.grow(p_parameters.margin);
+	}
+
+	// The broadphase is culled serially, only the shape tests run in parallel.
+	LocalVector<GodotCollisionObject2D *> objects;
+	LocalVector<int> shapes;
+	LocalVector<uint32_t> offsets;
+	_cull_shape_batch(bounds.ptr(), p_count, objects, shapes, offsets);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.objects = objects.ptr();
+	batch.shapes = shapes.ptr();
+	batch.offsets = offsets.ptr();
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.counts = r_counts;
+
+	if (p_count < SHAPE_BATCH_PARALLEL_MIN_QUERIES) {
+		for (int i = 0; i < p_count; i++) {
+			_intersect_shape_batch_task(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_shape_batch_task, &batch, p_count, -1, true, SNAME("Physics2DShapeBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState2D::_cast_motion_batch_task(uint32_t p_index, ShapeBatch *p_batch) {
+	const uint32_t first = p_batch->offsets[p_index];
+	_cast_motion_candidates(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], p_batch->motions[p_index], p_batch->objects + first, p_batch->shapes + first, p_batch->offsets[p_index + 1] - first, p_batch->closest_safe[p_index], p_batch->closest_unsafe[p_index]);
+}
+
+void GodotPhysicsDirectSpaceState2D::cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ERR_FAIL_COND(space->locked);
+	ERR_FAIL_COND(p_count < 0);
+
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	LocalVector<Rect2> bounds;
+	bounds.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Rect2 aabb = p_transforms[i].xform(shape->get_aabb());
+		aabb = aabb.merge(Rect2(aabb.position + p_motions[i], aabb.size)); //motion
+		bounds[i] = aabb.grow(p_parameters.margin);
+	}
+
+	// The broadphase is culled serially, only the shape tests run in parallel.
+	LocalVector<GodotCollisionObject2D *> objects;
+	LocalVector<int> shapes;
+	LocalVector<uint32_t> offsets;
+	_cull_shape_batch(bounds.ptr(), p_count, objects, shapes, offsets);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.objects = objects.ptr();
+	batch.shapes = shapes.ptr();
+	batch.offsets = offsets.ptr();
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	if (p_count < SHAPE_BATCH_PARALLEL_MIN_QUERIES) {
+		for (int i = 0; i < p_count; i++) {
+			_cast_motion_batch_task(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_cast_motion_batch_task, &batch, p_count, -1, true, SNAME("Physics2DMotionBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool GodotPhysicsDirectSpaceState2D::collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -45,13 +45,48 @@
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector2 *origins = nullptr;
+		const Vector2 *motions = nullptr;
+		GodotCollisionObject2D *const *objects = nullptr;
+		const int *shapes = nullptr;
+		const uint32_t *offsets = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	void _intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch);
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape2D *shape = nullptr;
+		const Transform2D *transforms = nullptr;
+		const Vector2 *motions = nullptr;
+		GodotCollisionObject2D *const *objects = nullptr;
+		const int *shapes = nullptr;
+		const uint32_t *offsets = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *counts = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	void _cull_shape_batch(const Rect2 *p_bounds, int p_count, LocalVector<GodotCollisionObject2D *> &r_objects, LocalVector<int> &r_shapes, LocalVector<uint32_t> &r_offsets);
+	void _intersect_shape_batch_task(uint32_t p_index, ShapeBatch *p_batch);
+	void _cast_motion_batch_task(uint32_t p_index, ShapeBatch *p_batch);
+
 public:
 	GodotSpace2D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform2D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_counts) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 
@@ -161,6 +161,26 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
+bool GodotBodyPair3D::_can_reuse_contacts(const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B, const Transform3D &p_relative_transform) const {
+	if (!contacts_cached || !collided || contact_count == 0) {
+		return false;
+	}
+	if (p_shape_A != cached_shape_A || p_shape_B != cached_shape_B || p_shape_A->get_version() != cached_shape_version_A || p_shape_B->get_version() != cached_shape_version_B) {
+		return false;
+	}
+
+	// Upper bound of how far any point of shape B moved relative to shape A.
+	const AABB &aabb_B = p_shape_B->get_aabb();
+	real_t radius_B = aabb_B.position.abs().max(aabb_B.get_end().abs()).length();
+	real_t basis_change = 0.0;
+	for (int i = 0; i < 3; i++) {
+		basis_change += (p_relative_transform.basis.rows[i] - cached_relative_transform.basis.rows[i]).length_squared();
+	}
+	real_t motion = p_relative_transform.origin.distance_to(cached_relative_transform.origin) + Math::sqrt(basis_change) * radius_B;
+
+	return motion < space->get_contact_recycle_radius();
+}
+
 // _test_ccd prevents tunneling by slowing down a high velocity body that is about to collide so that next frame it will be at an appropriate location to collide (i.e. slight overlap)
 // Warning: the way velocity is adjusted down to cause a collision means the momentum will be weaker than it should for a bounce!
 // Process: only proceed if body A's motion is high relative to its size.
@@ -260,6 +280,7 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 
 bool GodotBodyPair3D::setup(real_t p_step) {
 	check_ccd = false;
+	contacts_reused = false;
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
@@ -294,8 +315,26 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
+	// Resting contacts don't need the narrow phase, the ones that are still
+	// valid are kept with their accumulated impulses.
+	Transform3D relative_transform = xform_A.affine_inverse() * xform_B;
+	if (_can_reuse_contacts(shape_A_ptr, shape_B_ptr, relative_transform)) {
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].used = true;
+		}
+		contacts_reused = true;
+		return true;
+	}
+
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
+	contacts_cached = true;
+	cached_relative_transform = relative_transform;
+	cached_shape_A = shape_A_ptr;
+	cached_shape_B = shape_B_ptr;
+	cached_shape_version_A = shape_A_ptr->get_version();
+	cached_shape_version_B = shape_B_ptr->get_version();
+
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
 			check_ccd = true;
@@ -97,11 +97,22 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Placement of shape B relative to shape A when the contacts were last
+	// computed. While it barely changes, the contacts are kept as they are.
+	bool contacts_cached = false;
+	Transform3D cached_relative_transform;
+	const GodotShape3D *cached_shape_A = nullptr;
+	const GodotShape3D *cached_shape_B = nullptr;
+	uint64_t cached_shape_version_A = 0;
+	uint64_t cached_shape_version_B = 0;
+	bool contacts_reused = false;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
+	bool _can_reuse_contacts(const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B, const Transform3D &p_relative_transform) const;
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
@@ -109,6 +120,9 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	// Whether the last setup() kept the previous contacts instead of running the narrow phase.
+	bool are_contacts_reused() const { return contacts_reused; }
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
@@ -33,6 +33,7 @@
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
+#include "core/math/simd_batch.h"
 #include "core/templates/sort_array.h"
 
 // GodotHeightMapShape3D is based on Bullet btHeightfieldTerrainShape.
@@ -68,6 +69,7 @@ const double cylinder_face_support_threshold = 0.999;
 void GodotShape3D::configure(const AABB &p_aabb) {
 	aabb = p_aabb;
 	configured = true;
+	version++;
 	for (const KeyValue<GodotShapeOwner3D *, int> &E : owners) {
 		GodotShapeOwner3D *co = const_cast<GodotShapeOwner3D *>(E.key);
 		co->_shape_changed();
@@ -837,16 +839,7 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		r_min = p_normal.dot(p_transform.xform(get_support(-n)));
 		r_max = p_normal.dot(p_transform.xform(get_support(n)));
 	} else {
-		for (uint32_t i = 0; i < vertex_count; i++) {
-			real_t d = p_normal.dot(p_transform.xform(vrts[i]));
-
-			if (i == 0 || d > r_max) {
-				r_max = d;
-			}
-			if (i == 0 || d < r_min) {
-				r_min = d;
-			}
-		}
+		SIMDBatch::project_points(p_transform, p_normal, vrts, vertex_count, r_min, r_max);
 	}
 }
 
@@ -859,6 +852,13 @@ Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 	// Get the array of vertices
 	const Vector3 *const vertices_array = mesh.vertices.ptr();
 
+	// If all vertices are extreme, checking them all is the fastest way.
+	// They are stored in the order of extreme_vertices, so that ties still
+	// go to the first extreme vertex.
+	if (!extreme_vertex_positions.is_empty()) {
+		return extreme_vertex_positions[SIMDBatch::get_support_index(p_normal, extreme_vertex_positions.ptr(), extreme_vertex_positions.size())];
+	}
+
 	// Start with an initial assumption of the first extreme vertex.
 	int best_vertex = extreme_vertices[0];
 	real_t max_support = p_normal.dot(vertices_array[best_vertex]);
@@ -872,11 +872,6 @@ Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 		}
 	}
 
-	// If we checked all vertices in the mesh then we're done.
-	if (extreme_vertices.size() == mesh.vertices.size()) {
-		return vertices_array[best_vertex];
-	}
-
 	// Move along the surface until we reach the true support vertex.
 	int last_vertex = -1;
 	while (true) {
@@ -1100,6 +1095,7 @@ void GodotConvexPolygonShape3D::_setup(const Vector<Vector3> &p_vertices) {
 		ERR_PRINT("Failed to build convex hull");
 	}
 	extreme_vertices.resize(0);
+	extreme_vertex_positions.resize(0);
 	vertex_neighbors.resize(0);
 
 	AABB _aabb;
@@ -1148,6 +1144,11 @@ void GodotConvexPolygonShape3D::_setup(const Vector<Vector3> &p_vertices) {
 			vertex_neighbors[edge.vertex_a].push_back(edge.vertex_b);
 			vertex_neighbors[edge.vertex_b].push_back(edge.vertex_a);
 		}
+	} else {
+		extreme_vertex_positions.resize(extreme_vertices.size());
+		for (uint32_t i = 0; i < extreme_vertices.size(); i++) {
+			extreme_vertex_positions[i] = mesh.vertices[extreme_vertices[i]];
+		}
 	}
 }
 
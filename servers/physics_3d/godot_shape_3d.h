@@ -49,6 +49,7 @@ class GodotShape3D {
 	RID self;
 	AABB aabb;
 	bool configured = false;
+	uint64_t version = 0;
 	real_t custom_bias = 0.0;
 
 	HashMap<GodotShapeOwner3D *, int> owners;
@@ -73,6 +74,8 @@ public:
 
 	_FORCE_INLINE_ const AABB &get_aabb() const { return aabb; }
 	_FORCE_INLINE_ bool is_configured() const { return configured; }
+	// Incremented every time the shape data changes.
+	_FORCE_INLINE_ uint64_t get_version() const { return version; }
 
 	virtual bool is_concave() const { return false; }
 
@@ -278,6 +281,7 @@ public:
 struct GodotConvexPolygonShape3D : public GodotShape3D {
 	Geometry3D::MeshData mesh;
 	LocalVector<int> extreme_vertices;
+	LocalVector<Vector3> extreme_vertex_positions;
 	LocalVector<LocalVector<int>> vertex_neighbors;
 
 	void _setup(const Vector<Vector3> &p_vertices);
@@ -34,9 +34,13 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+#define RAY_BATCH_PARALLEL_MIN_RAYS 64
+#define RAY_BATCH_PACKET_SIZE 16
+#define SHAPE_BATCH_PARALLEL_MIN_QUERIES 16
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
@@ -105,16 +109,10 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
-	Vector3 begin, end;
-	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
-
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+static bool _intersect_ray_candidates(const PhysicsDirectSpaceState3D::RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_shapes, int p_amount, PhysicsDirectSpaceState3D::RayResult &r_result) {
+	const Vector3 &begin = p_from;
+	const Vector3 &end = p_to;
+	Vector3 normal = (end - begin).normalized();
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -125,22 +123,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_objects[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_shapes[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -205,41 +203,120 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
 
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	return _intersect_ray_candidates(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch) {
+	const uint32_t first = p_batch->offsets[p_index];
+	const Vector3 &from = p_batch->origins[p_index];
+	p_batch->hits[p_index] = _intersect_ray_candidates(*p_batch->parameters, from, from + p_batch->motions[p_index], p_batch->objects + first, p_batch->shapes + first, p_batch->offsets[p_index + 1] - first, p_batch->results[p_index]);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	ERR_FAIL_COND(p_count < 0);
+
+	// All the buffers are local, so that batches can run concurrently.
+	LocalVector<GodotCollisionObject3D *> cull_objects;
+	LocalVector<int> cull_shapes;
+	cull_objects.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	cull_shapes.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	// Broadphase candidates of every ray, ray i owns [offsets[i], offsets[i + 1]).
+	LocalVector<GodotCollisionObject3D *> objects;
+	LocalVector<int> shapes;
+	LocalVector<uint32_t> offsets;
+	offsets.resize(p_count + 1);
+
+	// The broadphase is traversed once per packet of consecutive rays, with
+	// their combined bounds. Each ray then keeps the candidates whose bounds
+	// its segment goes through, which are the ones cull_segment() would
+	// return. The traversal stays serial, only the shape tests run in parallel.
+	for (int packet_begin = 0; packet_begin < p_count; packet_begin += RAY_BATCH_PACKET_SIZE) {
+		const int packet_end = MIN(packet_begin + RAY_BATCH_PACKET_SIZE, p_count);
+		AABB packet_bounds(p_origins[packet_begin], Vector3());
+		for (int i = packet_begin; i < packet_end; i++) {
+			packet_bounds.expand_to(p_origins[i]);
+			packet_bounds.expand_to(p_origins[i] + p_motions[i]);
+		}
 
+		int amount = space->broadphase->cull_aabb(packet_bounds, cull_objects.ptr(), GodotSpace3D::INTERSECTION_QUERY_MAX, cull_shapes.ptr());
+		if (amount < GodotSpace3D::INTERSECTION_QUERY_MAX) {
+			for (int i = packet_begin; i < packet_end; i++) {
+				offsets[i] = objects.size();
+				const Vector3 &from = p_origins[i];
+				const Vector3 to = from + p_motions[i];
+				for (int j = 0; j < amount; j++) {
+					if (cull_objects[j]->get_shape_aabb(cull_shapes[j]).intersects_segment(from, to)) {
+						objects.push_back(cull_objects[j]);
+						shapes.push_back(cull_shapes[j]);
+					}
+				}
+			}
+		} else {
+			// Too many candidates for the whole packet, cull its rays one by one.
+			for (int i = packet_begin; i < packet_end; i++) {
+				offsets[i] = objects.size();
+				int ray_amount = space->broadphase->cull_segment(p_origins[i], p_origins[i] + p_motions[i], cull_objects.ptr(), GodotSpace3D::INTERSECTION_QUERY_MAX, cull_shapes.ptr());
+				for (int j = 0; j < ray_amount; j++) {
+					objects.push_back(cull_objects[j]);
+					shapes.push_back(cull_shapes[j]);
+				}
+			}
+		}
+	}
+	offsets[p_count] = objects.size();
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.objects = objects.ptr();
+	batch.shapes = shapes.ptr();
+	batch.offsets = offsets.ptr();
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	if (p_count < RAY_BATCH_PARALLEL_MIN_RAYS) {
+		for (int i = 0; i < p_count; i++) {
+			_intersect_ray_batch_task(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_task, &batch, p_count, -1, true, SNAME("Physics3DRayBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+static int _intersect_shape_candidates(const PhysicsDirectSpaceState3D::ShapeParameters &p_parameters, const GodotShape3D *p_shape, const Transform3D &p_transform, GodotCollisionObject3D *const *p_objects, const int *p_shapes, int p_amount, PhysicsDirectSpaceState3D::ShapeResult *r_results, int p_result_max) {
 	int cc = 0;
 
 	//Transform3D ai = p_xform.affine_inverse();
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 		if (cc >= p_result_max) {
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
+		int shape_idx = p_shapes[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -260,55 +337,61 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
+	ERR_FAIL_NULL_V(shape, 0);
 
 	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
-	aabb = aabb.grow(p_parameters.margin);
 
 	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
+	return _intersect_shape_candidates(p_parameters, shape, p_parameters.transform, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_results, p_result_max);
+}
+
+static void _cast_motion_candidates(const PhysicsDirectSpaceState3D::ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, const AABB &p_aabb, GodotCollisionObject3D *const *p_objects, const int *p_shapes, int p_amount, real_t &p_closest_safe, real_t &p_closest_unsafe, PhysicsDirectSpaceState3D::ShapeRestInfo *r_info) {
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
-	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+	mshape.shape = p_shape;
+	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
-	Vector3 motion_normal = p_parameters.motion.normalized();
+	Vector3 motion_normal = p_motion.normalized();
 
 	Vector3 closest_A, closest_B;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
+		int shape_idx = p_shapes[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, p_aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, p_aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -319,11 +402,11 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 		for (int j = 0; j < 8; j++) { //steps should be customizable..
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
-			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+			mshape.motion = xform_inv.basis.xform(p_motion * fraction);
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, p_aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -375,10 +458,144 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 	p_closest_safe = best_safe;
 	p_closest_unsafe = best_unsafe;
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	aabb = aabb.grow(p_parameters.margin);
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	_cast_motion_candidates(p_parameters, shape, p_parameters.transform, p_parameters.motion, aabb, space->intersection_query_results, space->intersection_query_subindex_results, amount, p_closest_safe, p_closest_unsafe, r_info);
 
 	return true;
 }
 
+void GodotPhysicsDirectSpaceState3D::_cull_shape_batch(const AABB *p_bounds, int p_count, LocalVector<GodotCollisionObject3D *> &r_objects, LocalVector<int> &r_shapes, LocalVector<uint32_t> &r_offsets) {
+	// All the buffers are local, so that batches can run concurrently.
+	LocalVector<GodotCollisionObject3D *> cull_objects;
+	LocalVector<int> cull_shapes;
+	cull_objects.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	cull_shapes.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	// Query i owns the candidates in [r_offsets[i], r_offsets[i + 1]).
+	r_offsets.resize(p_count + 1);
+	for (int i = 0; i < p_count; i++) {
+		r_offsets[i] = r_objects.size();
+		int amount = space->broadphase->cull_aabb(p_bounds[i], cull_objects.ptr(), GodotSpace3D::INTERSECTION_QUERY_MAX, cull_shapes.ptr());
+		for (int j = 0; j < amount; j++) {
+			r_objects.push_back(cull_objects[j]);
+			r_shapes.push_back(cull_shapes[j]);
+		}
+	}
+	r_offsets[p_count] = r_objects.size();
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shape_batch_task(uint32_t p_index, ShapeBatch *p_batch) {
+	const uint32_t first = p_batch->offsets[p_index];
+	p_batch->counts[p_index] = _intersect_shape_candidates(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], p_batch->objects + first, p_batch->shapes + first, p_batch->offsets[p_index + 1] - first, p_batch->results + p_index * p_batch->result_max, p_batch->result_max);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_counts) {
+	ERR_FAIL_COND(space->locked);
+	ERR_FAIL_COND(p_count < 0);
+	if (p_result_max <= 0) {
+		for (int i = 0; i < p_count; i++) {
+			r_counts[i] = 0;
+		}
+		return;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	LocalVector<AABB> bounds;
+	bounds.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		bounds[i] = p_transforms[i].xform(shape->get_aabb());
+	}
+
+	// The broadphase is culled serially, only the shape tests run in parallel.
+	LocalVector<GodotCollisionObject3D *> objects;
+	LocalVector<int> shapes;
+	LocalVector<uint32_t> offsets;
+	_cull_shape_batch(bounds.ptr(), p_count, objects, shapes, offsets);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.objects = objects.ptr();
+	batch.shapes = shapes.ptr();
+	batch.offsets = offsets.ptr();
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.counts = r_counts;
+
+	if (p_count < SHAPE_BATCH_PARALLEL_MIN_QUERIES) {
+		for (int i = 0; i < p_count; i++) {
+			_intersect_shape_batch_task(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shape_batch_task, &batch, p_count, -1, true, SNAME("Physics3DShapeBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState3D::_cast_motion_batch_task(uint32_t p_index, ShapeBatch *p_batch) {
+	const uint32_t first = p_batch->offsets[p_index];
+	_cast_motion_candidates(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], p_batch->motions[p_index], p_batch->bounds[p_index], p_batch->objects + first, p_batch->shapes + first, p_batch->offsets[p_index + 1] - first, p_batch->closest_safe[p_index], p_batch->closest_unsafe[p_index], nullptr);
+}
+
+void GodotPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ERR_FAIL_COND(space->locked);
+	ERR_FAIL_COND(p_count < 0);
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	LocalVector<AABB> bounds;
+	bounds.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		AABB aabb = p_transforms[i].xform(shape->get_aabb());
+		aabb = aabb.merge(AABB(aabb.position + p_motions[i], aabb.size)); //motion
+		bounds[i] = aabb.grow(p_parameters.margin);
+	}
+
+	// The broadphase is culled serially, only the shape tests run in parallel.
+	LocalVector<GodotCollisionObject3D *> objects;
+	LocalVector<int> shapes;
+	LocalVector<uint32_t> offsets;
+	_cull_shape_batch(bounds.ptr(), p_count, objects, shapes, offsets);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.bounds = bounds.ptr();
+	batch.objects = objects.ptr();
+	batch.shapes = shapes.ptr();
+	batch.offsets = offsets.ptr();
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	if (p_count < SHAPE_BATCH_PARALLEL_MIN_QUERIES) {
+		for (int i = 0; i < p_count; i++) {
+			_cast_motion_batch_task(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_cast_motion_batch_task, &batch, p_count, -1, true, SNAME("Physics3DMotionBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -46,13 +46,49 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *origins = nullptr;
+		const Vector3 *motions = nullptr;
+		GodotCollisionObject3D *const *objects = nullptr;
+		const int *shapes = nullptr;
+		const uint32_t *offsets = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	void _intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch);
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		const Vector3 *motions = nullptr;
+		const AABB *bounds = nullptr;
+		GodotCollisionObject3D *const *objects = nullptr;
+		const int *shapes = nullptr;
+		const uint32_t *offsets = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *counts = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	void _cull_shape_batch(const AABB *p_bounds, int p_count, LocalVector<GodotCollisionObject3D *> &r_objects, LocalVector<int> &r_shapes, LocalVector<uint32_t> &r_offsets);
+	void _intersect_shape_batch_task(uint32_t p_index, ShapeBatch *p_batch);
+	void _cast_motion_batch_task(uint32_t p_index, ShapeBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_counts) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
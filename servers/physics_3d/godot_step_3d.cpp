@@ -32,6 +32,7 @@
 
 #include "godot_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
@@ -41,6 +42,14 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+// Islands with fewer constraints are solved on a single thread.
+#define COLORED_ISLAND_MIN_CONSTRAINTS 256
+// Colors with fewer constraints aren't worth a group task.
+#define COLOR_BATCH_MIN_CONSTRAINTS 32
+// Colors are tracked as bits per body, constraints that don't fit share an
+// extra color which is solved on a single thread.
+#define COLOR_COUNT_MAX 64
+
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -158,6 +167,117 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+bool GodotStep3D::_can_solve_island_colored(const LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+	if (p_constraint_island.size() < COLORED_ISLAND_MIN_CONSTRAINTS) {
+		return false;
+	}
+	for (const GodotConstraint3D *constraint : p_constraint_island) {
+		if (constraint->get_soft_body_count() > 0) {
+			return false; // Soft body nodes aren't tracked by colors.
+		}
+	}
+	return true;
+}
+
+void GodotStep3D::_color_island(LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	// Greedy coloring in island order, so the result only depends on the order
+	// constraints were added in. Only rigid bodies receive impulses, so static
+	// and kinematic bodies can be shared by constraints of the same color.
+	uint32_t constraint_count = p_constraint_island.size();
+	body_colors.clear();
+	constraint_colors.resize(constraint_count);
+	color_offsets.resize(COLOR_COUNT_MAX + 2);
+	for (uint32_t color = 0; color < color_offsets.size(); ++color) {
+		color_offsets[color] = 0;
+	}
+
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
+		GodotBody3D **bodies = constraint->get_body_ptr();
+		int body_count = constraint->get_body_count();
+
+		uint64_t used_colors = 0;
+		for (int i = 0; i < body_count; i++) {
+			if (bodies[i]->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				const uint64_t *body_used_colors = body_colors.getptr(bodies[i]);
+				if (body_used_colors) {
+					used_colors |= *body_used_colors;
+				}
+			}
+		}
+
+		uint32_t color = 0;
+		while (color < COLOR_COUNT_MAX && (used_colors & (uint64_t(1) << color))) {
+			++color;
+		}
+		if (color < COLOR_COUNT_MAX) {
+			for (int i = 0; i < body_count; i++) {
+				if (bodies[i]->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+					body_colors[bodies[i]] |= uint64_t(1) << color;
+				}
+			}
+		}
+
+		constraint_colors[constraint_index] = color;
+		++color_offsets[color + 1];
+	}
+
+	// Sort constraints by color, keeping their order inside each color.
+	uint32_t color_cursors[COLOR_COUNT_MAX + 1];
+	for (uint32_t color = 0; color <= COLOR_COUNT_MAX; ++color) {
+		color_offsets[color + 1] += color_offsets[color];
+		color_cursors[color] = color_offsets[color];
+	}
+	colored_constraints.resize(constraint_count);
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		colored_constraints[color_cursors[constraint_colors[constraint_index]]++] = p_constraint_island[constraint_index];
+	}
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		p_constraint_island[constraint_index] = colored_constraints[constraint_index];
+	}
+}
+
+void GodotStep3D::_solve_island_colored(LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	int current_priority = 1;
+
+	while (!p_constraint_island.is_empty()) {
+		_color_island(p_constraint_island);
+		GodotConstraint3D **constraints = p_constraint_island.ptr();
+
+		for (int i = 0; i < iterations; i++) {
+			// Colors are solved in order, constraints of the same color in parallel.
+			for (uint32_t color = 0; color <= COLOR_COUNT_MAX; ++color) {
+				uint32_t color_begin = color_offsets[color];
+				uint32_t color_count = color_offsets[color + 1] - color_begin;
+				if (color == COLOR_COUNT_MAX || color_count < COLOR_BATCH_MIN_CONSTRAINTS) {
+					for (uint32_t constraint_index = 0; constraint_index < color_count; ++constraint_index) {
+						constraints[color_begin + constraint_index]->solve(delta);
+					}
+					continue;
+				}
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_constraint, constraints + color_begin, color_count, parallel_solver_task_count, true, SNAME("Physics3DConstraintSolveColor"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			}
+		}
+
+		// Check priority to keep only higher priority constraints.
+		uint32_t priority_constraint_count = 0;
+		++current_priority;
+		for (uint32_t constraint_index = 0; constraint_index < p_constraint_island.size(); ++constraint_index) {
+			GodotConstraint3D *constraint = p_constraint_island[constraint_index];
+			if (constraint->get_priority() >= current_priority) {
+				// Keep this constraint for the next iteration.
+				p_constraint_island[priority_constraint_count++] = constraint;
+			}
+		}
+		p_constraint_island.resize(priority_constraint_count);
+	}
+}
+
+void GodotStep3D::_solve_constraint(uint32_t p_constraint_index, GodotConstraint3D **p_constraints) {
+	p_constraints[p_constraint_index]->solve(delta);
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -362,6 +482,17 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	if (parallel_island_solving) {
+		// Large islands are solved one after the other, each spreading its
+		// constraints over the worker threads. This leaves them empty, so they
+		// are skipped by the group task below.
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			if (_can_solve_island_colored(constraint_islands[island_index])) {
+				_solve_island_colored(constraint_islands[island_index]);
+			}
+		}
+	}
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
@@ -412,6 +543,8 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+
+	parallel_island_solving = GLOBAL_GET("physics/3d/solver/parallel_island_solving");
 }
 
 GodotStep3D::~GodotStep3D() {
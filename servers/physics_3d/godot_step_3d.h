@@ -33,6 +33,7 @@
 
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -45,15 +46,37 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	bool parallel_island_solving = false;
+	int parallel_solver_task_count = -1;
+
+	// Scratch data to color the constraints of large islands.
+	HashMap<const GodotBody3D *, uint64_t> body_colors;
+	LocalVector<uint32_t> constraint_colors;
+	LocalVector<uint32_t> color_offsets;
+	LocalVector<GodotConstraint3D *> colored_constraints;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	bool _can_solve_island_colored(const LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _color_island(LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_island_colored(LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_constraint(uint32_t p_constraint_index, GodotConstraint3D **p_constraints);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
 	void step(GodotSpace3D *p_space, real_t p_delta);
+
+	// Large islands get their constraints split in batches that don't share
+	// any rigid body, each batch being solved on the worker threads.
+	void set_parallel_island_solving(bool p_enabled) { parallel_island_solving = p_enabled; }
+	bool is_parallel_island_solving() const { return parallel_island_solving; }
+	// Number of tasks a batch is split in, -1 for one per worker thread.
+	void set_parallel_solver_task_count(int p_count) { parallel_solver_task_count = p_count; }
+	int get_parallel_solver_task_count() const { return parallel_solver_task_count; }
+
 	GodotStep3D();
 	~GodotStep3D();
 };
@@ -118,9 +118,12 @@ class PhysicsDirectSpaceState2D : public Object {
 	GDCLASS(PhysicsDirectSpaceState2D, Object);
 
 	Dictionary _intersect_ray(const Ref<PhysicsRayQueryParameters2D> &p_ray_query);
+	Dictionary _intersect_rays(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions);
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters2D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
+	Dictionary _intersect_shapes(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const TypedArray<Transform2D> &p_transforms, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
+	Dictionary _cast_motions(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const TypedArray<Transform2D> &p_transforms, const PackedVector2Array &p_motions);
 	TypedArray<Vector2> _collide_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
 
@@ -150,6 +153,9 @@ public:
 	};
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
+	// Casts p_count rays filtered by p_parameters, from p_origins[i] to p_origins[i] + p_motions[i].
+	// r_hits[i] tells whether r_results[i] was set.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, RayResult *r_results, bool *r_hits);
 
 	struct ShapeResult {
 		RID rid;
@@ -194,7 +200,12 @@ public:
 	};
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
+	// Runs intersect_shape() with the shape of p_parameters placed at each of the p_count transforms.
+	// The results of query i are written from r_results[i * p_result_max], r_counts[i] tells how many.
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform2D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_counts);
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) = 0;
+	// Runs cast_motion() with the shape of p_parameters moved by p_motions[i] from p_transforms[i].
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
@@ -34,6 +34,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/typed_array.h"
 
 void PhysicsServer3DRenderingServerHandler::set_vertex(int p_vertex_id, const Vector3 &p_vertex) {
@@ -377,6 +378,62 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryPa
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Dictionary(), "The origins and motions arrays must have the same size.");
+
+	const int count = p_origins.size();
+	LocalVector<RayResult> results;
+	LocalVector<bool> hits;
+	results.resize(count);
+	hits.resize(count);
+	intersect_rays(p_ray_query->get_parameters(), p_origins.ptr(), p_motions.ptr(), count, results.ptr(), hits.ptr());
+
+	PackedVector3Array positions;
+	PackedVector3Array normals;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+	positions.resize(count);
+	normals.resize(count);
+	collider_ids.resize(count);
+	shapes.resize(count);
+	Vector3 *positions_ptr = positions.ptrw();
+	Vector3 *normals_ptr = normals.ptrw();
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		if (hits[i]) {
+			positions_ptr[i] = results[i].position;
+			normals_ptr[i] = results[i].normal;
+			collider_ids_ptr[i] = results[i].collider_id;
+			shapes_ptr[i] = results[i].shape;
+		} else {
+			positions_ptr[i] = Vector3();
+			normals_ptr[i] = Vector3();
+			collider_ids_ptr[i] = 0;
+			shapes_ptr[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["positions"] = positions;
+	d["normals"] = normals;
+	d["collider_ids"] = collider_ids;
+	d["shapes"] = shapes;
+
+	return d;
+}
+
+void PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_origins[i];
+		parameters.to = p_origins[i] + p_motions[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results) {
 	ERR_FAIL_COND_V(p_point_query.is_null(), TypedArray<Dictionary>());
 
@@ -422,6 +479,64 @@ TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_shape(const Ref<Phy
 	return ret;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_shapes(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const TypedArray<Transform3D> &p_transforms, int p_max_results) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(p_max_results < 0, Dictionary());
+
+	const int count = p_transforms.size();
+	LocalVector<Transform3D> transforms;
+	transforms.resize(count);
+	for (int i = 0; i < count; i++) {
+		transforms[i] = p_transforms[i];
+	}
+	LocalVector<ShapeResult> results;
+	LocalVector<int> result_counts;
+	results.resize(count * p_max_results);
+	result_counts.resize(count);
+	intersect_shapes(p_shape_query->get_parameters(), transforms.ptr(), count, results.ptr(), p_max_results, result_counts.ptr());
+
+	int total = 0;
+	for (int i = 0; i < count; i++) {
+		total += result_counts[i];
+	}
+
+	PackedInt32Array counts;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+	counts.resize(count);
+	collider_ids.resize(total);
+	shapes.resize(total);
+	int32_t *counts_ptr = counts.ptrw();
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	int index = 0;
+	for (int i = 0; i < count; i++) {
+		counts_ptr[i] = result_counts[i];
+		for (int j = 0; j < result_counts[i]; j++) {
+			const ShapeResult &result = results[i * p_max_results + j];
+			collider_ids_ptr[index] = result.collider_id;
+			shapes_ptr[index] = result.shape;
+			index++;
+		}
+	}
+
+	Dictionary d;
+	d["counts"] = counts;
+	d["collider_ids"] = collider_ids;
+	d["shapes"] = shapes;
+
+	return d;
+}
+
+void PhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_counts) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		r_counts[i] = intersect_shape(parameters, r_results + i * p_result_max, p_result_max);
+	}
+}
+
 Vector<real_t> PhysicsDirectSpaceState3D::_cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Vector<real_t>());
 
@@ -437,6 +552,41 @@ Vector<real_t> PhysicsDirectSpaceState3D::_cast_motion(const Ref<PhysicsShapeQue
 	return ret;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_cast_motions(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const TypedArray<Transform3D> &p_transforms, const PackedVector3Array &p_motions) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_transforms.size() != p_motions.size(), Dictionary(), "The transforms and motions arrays must have the same size.");
+
+	const int count = p_transforms.size();
+	LocalVector<Transform3D> transforms;
+	transforms.resize(count);
+	for (int i = 0; i < count; i++) {
+		transforms[i] = p_transforms[i];
+	}
+	Vector<real_t> safe_fractions;
+	Vector<real_t> unsafe_fractions;
+	safe_fractions.resize(count);
+	unsafe_fractions.resize(count);
+	cast_motions(p_shape_query->get_parameters(), transforms.ptr(), p_motions.ptr(), count, safe_fractions.ptrw(), unsafe_fractions.ptrw());
+
+	Dictionary d;
+	d["safe_fractions"] = safe_fractions;
+	d["unsafe_fractions"] = unsafe_fractions;
+
+	return d;
+}
+
+void PhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		parameters.motion = p_motions[i];
+		if (!cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i], nullptr)) {
+			r_closest_safe[i] = 1.0;
+			r_closest_unsafe[i] = 1.0;
+		}
+	}
+}
+
 TypedArray<Vector3> PhysicsDirectSpaceState3D::_collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), TypedArray<Vector3>());
 
@@ -482,8 +632,11 @@ PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "origins", "motions"), &PhysicsDirectSpaceState3D::_intersect_rays);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("intersect_shapes", "parameters", "transforms", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shapes, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
+	ClassDB::bind_method(D_METHOD("cast_motions", "parameters", "transforms", "motions"), &PhysicsDirectSpaceState3D::_cast_motions);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
 }
@@ -1139,6 +1292,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/parallel_island_solving", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
@@ -0,0 +1,565 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+
+// Below this many triangles, setting them up on threads costs more than it saves.
+#define SETUP_PARALLEL_MIN_TRIANGLES 512
+
+static const float pixel_offsets[RasterOcclusionCull::RasterHZBuffer::TILE_SIZE] = { 0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f };
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	raster_depth.clear();
+	tile_far_depth.clear();
+	thread_triangles.clear();
+	triangles.clear();
+	tile_row_triangles.clear();
+	tile_grid_size = Size2i();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	raster_depth.resize(tile_grid_size.x * tile_grid_size.y * TILE_SIZE * TILE_SIZE);
+	tile_far_depth.resize(tile_grid_size.x * tile_grid_size.y);
+	tile_row_triangles.resize(tile_grid_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_triangle(const SetupThreadData *p_data, const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c, LocalVector<Triangle> &r_triangles) const {
+	const float clip_z = -p_data->z_near;
+
+	// Clip against the near plane, which can turn the triangle into a quad.
+	const Vector3 input[3] = { p_a, p_b, p_c };
+	Vector3 clipped[4];
+	int clipped_count = 0;
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &current = input[i];
+		const Vector3 &next = input[(i + 1) % 3];
+		const bool current_inside = current.z <= clip_z;
+		const bool next_inside = next.z <= clip_z;
+		if (current_inside) {
+			clipped[clipped_count++] = current;
+		}
+		if (current_inside != next_inside) {
+			const float t = (clip_z - current.z) / (next.z - current.z);
+			clipped[clipped_count++] = current + (next - current) * t;
+		}
+	}
+
+	if (clipped_count < 3) {
+		return;
+	}
+
+	const Size2i &buffer_size = sizes[0];
+	float x[4];
+	float y[4];
+	float depth[4];
+	for (int i = 0; i < clipped_count; i++) {
+		const Plane projected = p_data->projection.xform4(Plane(clipped[i], 1.0));
+		x[i] = (projected.normal.x / projected.d * 0.5f + 0.5f) * buffer_size.x;
+		y[i] = (projected.normal.y / projected.d * 0.5f + 0.5f) * buffer_size.y;
+		depth[i] = p_data->orthogonal ? clipped[i].z : -1.0f / clipped[i].z;
+	}
+
+	for (int fan = 2; fan < clipped_count; fan++) {
+		int v[3] = { 0, fan - 1, fan };
+
+		float area = (x[v[1]] - x[v[0]]) * (y[v[2]] - y[v[0]]) - (x[v[2]] - x[v[0]]) * (y[v[1]] - y[v[0]]);
+		if (Math::abs(area) < CMP_EPSILON) {
+			continue;
+		}
+		if (area < 0.0f) {
+			// Occluders are double-sided, make the winding counter-clockwise so the edge functions are positive inside.
+			SWAP(v[1], v[2]);
+			area = -area;
+		}
+
+		Triangle triangle;
+		// Clamp before converting, vertices close to the near plane can be very far off-screen.
+		triangle.min_x = (int)CLAMP(Math::floor(MIN(x[v[0]], MIN(x[v[1]], x[v[2]]))), 0.0f, (float)buffer_size.x);
+		triangle.min_y = (int)CLAMP(Math::floor(MIN(y[v[0]], MIN(y[v[1]], y[v[2]]))), 0.0f, (float)buffer_size.y);
+		triangle.max_x = (int)CLAMP(Math::ceil(MAX(x[v[0]], MAX(x[v[1]], x[v[2]]))), -1.0f, (float)(buffer_size.x - 1));
+		triangle.max_y = (int)CLAMP(Math::ceil(MAX(y[v[0]], MAX(y[v[1]], y[v[2]]))), -1.0f, (float)(buffer_size.y - 1));
+		if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+			continue; // Off-screen.
+		}
+
+		for (int i = 0; i < 3; i++) {
+			const int from = v[i];
+			const int to = v[(i + 1) % 3];
+			triangle.edge_a[i] = y[from] - y[to];
+			triangle.edge_b[i] = x[to] - x[from];
+			triangle.edge_c[i] = x[from] * y[to] - y[from] * x[to];
+		}
+
+		const float depth_10 = depth[v[1]] - depth[v[0]];
+		const float depth_20 = depth[v[2]] - depth[v[0]];
+		triangle.depth_a = (depth_10 * (y[v[2]] - y[v[0]]) - depth_20 * (y[v[1]] - y[v[0]])) / area;
+		triangle.depth_b = (depth_20 * (x[v[1]] - x[v[0]]) - depth_10 * (x[v[2]] - x[v[0]])) / area;
+		triangle.depth_c = depth[v[0]] - triangle.depth_a * x[v[0]] - triangle.depth_b * y[v[0]];
+		triangle.max_depth = MAX(depth[v[0]], MAX(depth[v[1]], depth[v[2]]));
+
+		r_triangles.push_back(triangle);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_threaded(uint32_t p_thread, const SetupThreadData *p_data) {
+	uint32_t triangle_total = p_data->triangle_count;
+	uint32_t total_threads = p_data->thread_count;
+	uint32_t from = p_thread * triangle_total / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? triangle_total : ((p_thread + 1) * triangle_total / total_threads);
+
+	LocalVector<Triangle> &thread_result = thread_triangles[p_thread];
+	thread_result.clear();
+
+	uint32_t first_triangle = 0;
+	for (uint32_t i = 0; i < p_data->mesh_count && first_triangle < to; i++) {
+		const Mesh &mesh = p_data->meshes[i];
+		const uint32_t mesh_triangle_count = mesh.index_count / 3;
+		const uint32_t begin = MAX(from, first_triangle) - first_triangle;
+		const uint32_t end = MIN(to, first_triangle + mesh_triangle_count);
+
+		for (uint32_t j = begin; j + first_triangle < end; j++) {
+			const uint32_t *indices = &mesh.indices[j * 3];
+			if (indices[0] >= mesh.vertex_count || indices[1] >= mesh.vertex_count || indices[2] >= mesh.vertex_count) {
+				continue;
+			}
+
+			const Vector3 a = p_data->view_transform.xform(mesh.vertices[indices[0]]);
+			const Vector3 b = p_data->view_transform.xform(mesh.vertices[indices[1]]);
+			const Vector3 c = p_data->view_transform.xform(mesh.vertices[indices[2]]);
+			if (a.z > -p_data->z_near && b.z > -p_data->z_near && c.z > -p_data->z_near) {
+				continue; // Behind the camera.
+			}
+
+			_setup_triangle(p_data, a, b, c, thread_result);
+		}
+
+		first_triangle += mesh_triangle_count;
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_raster_triangle_tile(const Triangle &p_triangle, int p_tile_x, int p_tile_y) {
+	float &tile_far = tile_far_depth[p_tile_y * tile_grid_size.x + p_tile_x];
+	if (p_triangle.max_depth <= tile_far) {
+		return; // Everything in the tile is already closer than the triangle.
+	}
+
+	const float tile_min_x = p_tile_x * TILE_SIZE;
+	const float tile_min_y = p_tile_y * TILE_SIZE;
+	const float tile_max_x = tile_min_x + TILE_SIZE;
+	const float tile_max_y = tile_min_y + TILE_SIZE;
+
+	// Skip the tile if it's entirely outside one of the edges.
+	for (int i = 0; i < 3; i++) {
+		const float x = p_triangle.edge_a[i] > 0.0f ? tile_max_x : tile_min_x;
+		const float y = p_triangle.edge_b[i] > 0.0f ? tile_max_y : tile_min_y;
+		if (p_triangle.edge_a[i] * x + p_triangle.edge_b[i] * y + p_triangle.edge_c[i] < 0.0f) {
+			return;
+		}
+	}
+
+	const int row_stride = tile_grid_size.x * TILE_SIZE;
+	float *tile = &raster_depth[p_tile_y * TILE_SIZE * row_stride + p_tile_x * TILE_SIZE];
+	float new_tile_far = FLT_MAX;
+
+	for (int row = 0; row < TILE_SIZE; row++) {
+		const float y = tile_min_y + pixel_offsets[row];
+		const float edge_row_0 = p_triangle.edge_b[0] * y + p_triangle.edge_c[0];
+		const float edge_row_1 = p_triangle.edge_b[1] * y + p_triangle.edge_c[1];
+		const float edge_row_2 = p_triangle.edge_b[2] * y + p_triangle.edge_c[2];
+		const float depth_row = p_triangle.depth_b * y + p_triangle.depth_c;
+		float *pixels = &tile[row * row_stride];
+
+		// Branchless, so the compiler can run it over all the pixels of the row at once.
+		for (int i = 0; i < TILE_SIZE; i++) {
+			const float x = tile_min_x + pixel_offsets[i];
+			const bool inside = (p_triangle.edge_a[0] * x + edge_row_0 >= 0.0f) & (p_triangle.edge_a[1] * x + edge_row_1 >= 0.0f) & (p_triangle.edge_a[2] * x + edge_row_2 >= 0.0f);
+			const float depth = p_triangle.depth_a * x + depth_row;
+			pixels[i] = (inside & (depth > pixels[i])) ? depth : pixels[i];
+			new_tile_far = MIN(new_tile_far, pixels[i]);
+		}
+	}
+
+	tile_far = new_tile_far;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_raster_tile_row(uint32_t p_tile_row, void *p_userdata) {
+	for (const uint32_t &E : tile_row_triangles[p_tile_row]) {
+		const Triangle &triangle = triangles[E];
+		const int max_tile_x = triangle.max_x / TILE_SIZE;
+		for (int tile_x = triangle.min_x / TILE_SIZE; tile_x <= max_tile_x; tile_x++) {
+			_raster_triangle_tile(triangle, tile_x, p_tile_row);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const Mesh *p_meshes, uint32_t p_mesh_count, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	ERR_FAIL_COND(is_empty());
+
+	const float z_far = p_cam_projection.get_z_far() * 1.05f;
+	debug_tex_range = z_far;
+	clear_depth = p_cam_orthogonal ? -z_far : 1.0f / z_far;
+
+	for (float &depth : raster_depth) {
+		depth = clear_depth;
+	}
+	for (float &depth : tile_far_depth) {
+		depth = clear_depth;
+	}
+
+	SetupThreadData td;
+	td.meshes = p_meshes;
+	td.mesh_count = p_mesh_count;
+	td.triangle_count = 0;
+	for (uint32_t i = 0; i < p_mesh_count; i++) {
+		td.triangle_count += p_meshes[i].index_count / 3;
+	}
+	td.view_transform = p_cam_transform.affine_inverse();
+	td.projection = p_cam_projection;
+	td.z_near = p_cam_projection.get_z_near();
+	td.orthogonal = p_cam_orthogonal;
+
+	if (td.triangle_count >= SETUP_PARALLEL_MIN_TRIANGLES) {
+		td.thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+		thread_triangles.resize(td.thread_count);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_setup_threaded, &td, td.thread_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		td.thread_count = 1;
+		thread_triangles.resize(1);
+		_setup_threaded(0, &td);
+	}
+
+	triangles.clear();
+	for (uint32_t i = 0; i < td.thread_count; i++) {
+		const LocalVector<Triangle> &thread_result = thread_triangles[i];
+		const uint32_t offset = triangles.size();
+		triangles.resize(offset + thread_result.size());
+		memcpy(triangles.ptr() + offset, thread_result.ptr(), thread_result.size() * sizeof(Triangle));
+	}
+
+	for (LocalVector<uint32_t> &row_triangles : tile_row_triangles) {
+		row_triangles.clear();
+	}
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const int max_tile_y = triangles[i].max_y / TILE_SIZE;
+		for (int tile_y = triangles[i].min_y / TILE_SIZE; tile_y <= max_tile_y; tile_y++) {
+			tile_row_triangles[tile_y].push_back(i);
+		}
+	}
+
+	if (!triangles.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_raster_tile_row, (void *)nullptr, tile_grid_size.y, -1, true, SNAME("RasterOcclusionCullRaster"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	// Convert back to the distance along the camera direction the culling expects.
+	const Size2i &buffer_size = sizes[0];
+	const int row_stride = tile_grid_size.x * TILE_SIZE;
+	for (int y = 0; y < buffer_size.y; y++) {
+		const float *read = &raster_depth[y * row_stride];
+		float *write = &mips[0][y * buffer_size.x];
+		if (p_cam_orthogonal) {
+			for (int x = 0; x < buffer_size.x; x++) {
+				write[x] = -read[x];
+			}
+		} else {
+			for (int x = 0; x < buffer_size.x; x++) {
+				write[x] = 1.0f / read[x];
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		RID scenario_rid = E.scenario;
+		RID instance_rid = E.instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		scenario.dirty = true; // The mesh list needs a rebuild, but the instance doesn't need update
+	}
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+		scenario.dirty = true;
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::update(RID_PtrOwner<Occluder> &p_occluder_owner) {
+	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+		return;
+	}
+
+	for (const RID &E : removed_instances) {
+		instances.erase(E);
+	}
+
+	for (const RID &E : dirty_instances_array) {
+		OccluderInstance *occ_inst = instances.getptr(E);
+		if (!occ_inst) {
+			continue;
+		}
+
+		Occluder *occ = p_occluder_owner.get_or_null(occ_inst->occluder);
+		if (!occ) {
+			occ_inst->xformed_vertices.clear();
+			occ_inst->indices.clear();
+			continue;
+		}
+
+		const int vertex_count = occ->vertices.size();
+		const Vector3 *read = occ->vertices.ptr();
+		occ_inst->xformed_vertices.resize(vertex_count);
+		for (int i = 0; i < vertex_count; i++) {
+			occ_inst->xformed_vertices[i] = occ_inst->xform.xform(read[i]);
+		}
+
+		occ_inst->indices.resize(occ->indices.size());
+		memcpy(occ_inst->indices.ptr(), occ->indices.ptr(), occ->indices.size() * sizeof(int32_t));
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+
+	meshes.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : instances) {
+		const OccluderInstance &occ_inst = E.value;
+		if (!occ_inst.enabled || occ_inst.indices.size() < 3) {
+			continue;
+		}
+
+		RasterHZBuffer::Mesh mesh;
+		mesh.vertices = occ_inst.xformed_vertices.ptr();
+		mesh.vertex_count = occ_inst.xformed_vertices.size();
+		mesh.indices = occ_inst.indices.ptr();
+		mesh.index_count = occ_inst.indices.size();
+		meshes.push_back(mesh);
+	}
+
+	dirty = false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update(occluder_owner);
+
+	Projection projection = p_cam_projection;
+	const Size2i &viewport_size = buffer.get_occlusion_buffer_size();
+	// Prevent divide by zero when using NULL viewport.
+	if (_jitter_enabled && viewport_size.x > 0 && viewport_size.y > 0) {
+		projection = _get_jittered_projection(p_cam_projection, viewport_size);
+	}
+
+	buffer.rasterize(scenario.meshes.ptr(), scenario.meshes.size(), p_cam_transform, projection, p_cam_orthogonal);
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::set_build_quality(RS::ViewportOcclusionCullingBuildQuality p_quality) {
+	// Occluders are rasterized directly every frame, there is no acceleration structure to build.
+}
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
+}
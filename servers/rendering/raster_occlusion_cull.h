@@ -0,0 +1,188 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/projection.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling that rasterizes the occluders into the depth buffer on the CPU.
+// Used when the raycast module (Embree) isn't available.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	class RasterHZBuffer : public HZBuffer {
+	public:
+		struct Mesh {
+			// World space vertices, every 3 indices form a triangle.
+			const Vector3 *vertices = nullptr;
+			uint32_t vertex_count = 0;
+			const uint32_t *indices = nullptr;
+			uint32_t index_count = 0;
+		};
+
+		static const int TILE_SIZE = 8;
+
+	private:
+		// Screen space triangle, ready to be rasterized.
+		// Depth is interpolated as 1 / z for perspective projections and as -z for orthogonal ones,
+		// so larger values are closer in both cases and linear in screen space.
+		struct Triangle {
+			// Edge functions, a * x + b * y + c >= 0 inside the triangle.
+			float edge_a[3];
+			float edge_b[3];
+			float edge_c[3];
+			float depth_a;
+			float depth_b;
+			float depth_c;
+			float max_depth;
+			int min_x;
+			int min_y;
+			int max_x;
+			int max_y;
+		};
+
+		struct SetupThreadData {
+			uint32_t thread_count;
+			const Mesh *meshes;
+			uint32_t mesh_count;
+			uint32_t triangle_count;
+			Transform3D view_transform;
+			Projection projection;
+			float z_near;
+			bool orthogonal;
+		};
+
+		Size2i tile_grid_size;
+		// Raster target padded to whole tiles, in the interpolated depth format.
+		LocalVector<float> raster_depth;
+		// Farthest value of every tile, tiles are skipped by triangles entirely behind it.
+		LocalVector<float> tile_far_depth;
+		LocalVector<LocalVector<Triangle>> thread_triangles;
+		LocalVector<Triangle> triangles;
+		LocalVector<LocalVector<uint32_t>> tile_row_triangles;
+		float clear_depth = 0.0f;
+
+		void _setup_triangle(const SetupThreadData *p_data, const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c, LocalVector<Triangle> &r_triangles) const;
+		void _setup_threaded(uint32_t p_thread, const SetupThreadData *p_data);
+		void _raster_tile_row(uint32_t p_tile_row, void *p_userdata);
+		void _raster_triangle_tile(const Triangle &p_triangle, int p_tile_x, int p_tile_y);
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+		void rasterize(const Mesh *p_meshes, uint32_t p_mesh_count, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal);
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<uint32_t> indices;
+		LocalVector<Vector3> xformed_vertices;
+		Transform3D xform;
+		bool enabled = true;
+		bool removed = false;
+	};
+
+	struct Scenario {
+		bool dirty = false;
+
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array; // To iterate
+		LocalVector<RID> removed_instances;
+
+		// Enabled instances, rebuilt when the scenario is dirty.
+		LocalVector<RasterHZBuffer::Mesh> meshes;
+
+		void update(RID_PtrOwner<Occluder> &p_occluder_owner);
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+	bool _jitter_enabled = false;
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	virtual void set_build_quality(RS::ViewportOcclusionCullingBuildQuality p_quality) override;
+
+	RasterOcclusionCull();
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -2315,7 +2316,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
+	// The casters are culled later with the ones of the other lights, see _cull_shadow_casters().
+	// The light culler planes are only stored once the shadow passes are known to fit.
+	int32_t light_culler_id = -1;
 
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
@@ -2327,6 +2330,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				if (max_shadows_used + 2 > MAX_UPDATE_SHADOWS) {
 					return true;
 				}
+				light_culler_id = _store_shadow_cull_light(light);
 				for (int i = 0; i < 2; i++) {
 					//using this one ensures that raster deferred will have it
 					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
@@ -2343,49 +2347,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
+					_add_shadow_cull_job(p_instance, planes, max_shadows_used, light_culler_id);
 					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
 
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
-
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, i, 0);
 					shadow_data.light = light->instance;
 					shadow_data.pass = i;
@@ -2395,6 +2359,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				if (max_shadows_used + 6 > MAX_UPDATE_SHADOWS) {
 					return true;
 				}
+				light_culler_id = _store_shadow_cull_light(light);
 
 				real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 				Projection cm;
@@ -2425,47 +2390,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
+					_add_shadow_cull_job(p_instance, planes, max_shadows_used, light_culler_id);
 					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
 
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
 
 					shadow_data.light = light->instance;
@@ -2483,6 +2410,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
 				return true;
 			}
+			light_culler_id = _store_shadow_cull_light(light);
 
 			real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 			real_t angle = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_SPOT_ANGLE);
@@ -2492,56 +2420,136 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
 
-			instance_shadow_cull_result.clear();
+			_add_shadow_cull_job(p_instance, planes, max_shadows_used, light_culler_id);
+			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
+			shadow_data.light = light->instance;
+			shadow_data.pass = 0;
 
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
+		} break;
+	}
 
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
+	return false;
+}
 
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+int32_t RendererSceneCull::_store_shadow_cull_light(const InstanceLightData *p_light) {
+	// Lights updated in full don't go through the light culler.
+	if (p_light->is_shadow_update_full()) {
+		return -1;
+	}
 
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+	int32_t light_culler_id = shadow_cull_light_count++;
+	light_culler->store_regular_light(light_culler_id);
+	return light_culler_id;
+}
 
-			if (!light->is_shadow_update_full()) {
-				light_culler->cull_regular_light(instance_shadow_cull_result);
-			}
+void RendererSceneCull::_add_shadow_cull_job(Instance *p_light, const Vector<Plane> &p_planes, uint32_t p_shadow_index, int32_t p_light_culler_id) {
+	ERR_FAIL_COND(p_planes.size() != 6);
 
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
+	ShadowCullJob job;
+	job.light = p_light;
+	for (int i = 0; i < 6; i++) {
+		job.planes[i] = p_planes[i];
+	}
+	job.shadow_index = p_shadow_index;
+	job.light_culler_id = p_light_culler_id;
+	shadow_cull_jobs.push_back(job);
+}
 
-					if (instance->mesh_instance.is_valid()) {
-						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-					}
+void RendererSceneCull::_shadow_cull_threaded(uint32_t p_thread, ShadowCullData *p_cull_data) {
+	uint32_t cull_total = shadow_cull_jobs.size();
+	uint32_t total_threads = shadow_cull_threads.size();
+	uint32_t cull_from = p_thread * cull_total / total_threads;
+	uint32_t cull_to = (p_thread + 1 == total_threads) ? cull_total : ((p_thread + 1) * cull_total / total_threads);
+
+	_shadow_cull(*p_cull_data, shadow_cull_threads[p_thread], cull_from, cull_to);
+}
+
+void RendererSceneCull::_shadow_cull(const ShadowCullData &p_cull_data, ShadowCullThread &r_thread, uint32_t p_from, uint32_t p_to) {
+	struct CullConvex {
+		PagedArray<Instance *> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			result->push_back(p_instance);
+			return false;
+		}
+	};
+
+	CullConvex cull_convex;
+	cull_convex.result = &r_thread.cull_result;
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		ShadowCullJob &job = shadow_cull_jobs[i];
+
+		r_thread.cull_result.clear();
+
+		Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(job.planes, 6);
+
+		p_cull_data.scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(job.planes, 6, points.ptr(), points.size(), cull_convex);
+
+		if (job.light_culler_id >= 0) {
+			light_culler->cull_regular_light(r_thread.cull_result, job.light_culler_id);
+		}
+
+		// Each job owns its shadow pass, so the instances can be written without locking.
+		PagedArray<RenderGeometryInstance *> &shadow_instances = render_shadow_data[job.shadow_index].instances;
+
+		for (int j = 0; j < (int)r_thread.cull_result.size(); j++) {
+			Instance *instance = r_thread.cull_result[j];
+			if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_cull_data.visible_layers & instance->layer_mask)) {
+				continue;
+			} else {
+				if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+					job.animated_material_found = true;
+				}
+
+				if (instance->mesh_instance.is_valid()) {
+					r_thread.mesh_instances.push_back(instance);
 				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
 			}
 
-			RSG::mesh_storage->update_mesh_instances();
+			shadow_instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
+		}
+	}
+}
 
-			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
+void RendererSceneCull::_cull_shadow_casters(Scenario *p_scenario, uint32_t p_visible_layers) {
+	if (shadow_cull_jobs.is_empty()) {
+		shadow_cull_light_count = 0;
+		return;
+	}
 
-		} break;
+	RENDER_TIMESTAMP("Cull Light3D Shadow Casters");
+
+	ShadowCullData cull_data;
+	cull_data.scenario = p_scenario;
+	cull_data.visible_layers = p_visible_layers;
+
+	if (shadow_cull_jobs.size() > 1 && shadow_cull_threads.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_shadow_cull_threaded, &cull_data, shadow_cull_threads.size(), -1, true, SNAME("RenderCullShadowCasters"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_shadow_cull(cull_data, shadow_cull_threads[0], 0, shadow_cull_jobs.size());
+	}
+
+	// Mesh storage isn't thread safe, merge the mesh instances found by each thread.
+	for (ShadowCullThread &thread : shadow_cull_threads) {
+		for (uint32_t i = 0; i < thread.mesh_instances.size(); i++) {
+			RSG::mesh_storage->mesh_instance_check_for_update(thread.mesh_instances[i]->mesh_instance);
+		}
+		thread.mesh_instances.clear();
 	}
+	RSG::mesh_storage->update_mesh_instances();
 
-	return animated_material_found;
+	for (const ShadowCullJob &job : shadow_cull_jobs) {
+		if (job.animated_material_found) {
+			static_cast<InstanceLightData *>(job.light->base_data)->make_shadow_dirty();
+		}
+	}
+
+	shadow_cull_jobs.clear();
+	shadow_cull_light_count = 0;
 }
 
 void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -3350,6 +3358,8 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 	}
 
+	_cull_shadow_casters(scenario, p_visible_layers);
+
 	//render SDFGI
 
 	{
@@ -4245,7 +4255,6 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -4259,13 +4268,18 @@ RendererSceneCull::RendererSceneCull() {
 	for (InstanceCullResult &thread : scene_cull_result_threads) {
 		thread.init(&rid_cull_page_pool, &geometry_instance_cull_page_pool, &instance_cull_page_pool);
 	}
+	shadow_cull_threads.resize(WorkerThreadPool::get_singleton()->get_thread_count());
+	for (ShadowCullThread &thread : shadow_cull_threads) {
+		thread.cull_result.set_page_pool(&instance_cull_page_pool);
+		thread.mesh_instances.set_page_pool(&instance_cull_page_pool);
+	}
 
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	fallback_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4276,7 +4290,6 @@ RendererSceneCull::RendererSceneCull() {
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
@@ -4290,9 +4303,14 @@ RendererSceneCull::~RendererSceneCull() {
 		thread.reset();
 	}
 	scene_cull_result_threads.clear();
+	for (ShadowCullThread &thread : shadow_cull_threads) {
+		thread.cull_result.reset();
+		thread.mesh_instances.reset();
+	}
+	shadow_cull_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (fallback_occlusion_culling) {
+		memdelete(fallback_occlusion_culling);
 	}
 
 	if (light_culler) {
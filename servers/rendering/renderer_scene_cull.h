@@ -123,7 +123,8 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	// Used unless a module (such as raycast) registers its own occlusion culling.
+	RendererSceneOcclusionCull *fallback_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -879,7 +880,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
@@ -1148,6 +1148,36 @@ public:
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
 
+	// Shadow passes of positional lights. Their casters are culled for all lights at once.
+	struct ShadowCullJob {
+		Instance *light = nullptr;
+		Plane planes[6];
+		uint32_t shadow_index = 0;
+		int32_t light_culler_id = -1;
+		bool animated_material_found = false;
+	};
+
+	struct ShadowCullThread {
+		PagedArray<Instance *> cull_result;
+		// Casters with a mesh instance, checked for updates once every thread is done.
+		PagedArray<Instance *> mesh_instances;
+	};
+
+	struct ShadowCullData {
+		Scenario *scenario = nullptr;
+		uint32_t visible_layers = 0;
+	};
+
+	LocalVector<ShadowCullJob> shadow_cull_jobs;
+	LocalVector<ShadowCullThread> shadow_cull_threads;
+	uint32_t shadow_cull_light_count = 0;
+
+	int32_t _store_shadow_cull_light(const InstanceLightData *p_light);
+	void _add_shadow_cull_job(Instance *p_light, const Vector<Plane> &p_planes, uint32_t p_shadow_index, int32_t p_light_culler_id);
+	void _shadow_cull_threaded(uint32_t p_thread, ShadowCullData *p_cull_data);
+	void _shadow_cull(const ShadowCullData &p_cull_data, ShadowCullThread &r_thread, uint32_t p_from, uint32_t p_to);
+	void _cull_shadow_casters(Scenario *p_scenario, uint32_t p_visible_layers);
+
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
 	void _render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows = true, RenderInfo *r_render_info = nullptr);
 	void render_empty_scene(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_scenario, RID p_shadow_atlas);
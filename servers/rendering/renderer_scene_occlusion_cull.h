@@ -39,6 +39,9 @@ class RendererSceneOcclusionCull {
 protected:
 	static RendererSceneOcclusionCull *singleton;
 
+	// Offsets the projection by a fraction of a pixel, following a pattern that repeats every 9 frames.
+	static Projection _get_jittered_projection(const Projection &p_cam_projection, const Size2i &p_viewport_size);
+
 public:
 	class HZBuffer {
 	protected:
@@ -233,7 +236,9 @@ public:
 	};
 
 	virtual ~RendererSceneOcclusionCull() {
-		singleton = nullptr;
+		if (singleton == this) {
+			singleton = nullptr;
+		}
 	};
 };
 
@@ -154,9 +154,20 @@ int32_t RenderingDeviceGraph::_add_to_command_list(int32_t p_command_index, int3
 }
 
 void RenderingDeviceGraph::_add_adjacent_command(int32_t p_previous_command_index, int32_t p_command_index, RecordedCommand *r_command) {
+	DEV_ASSERT(p_previous_command_index < p_command_index && "Commands can only depend on commands recorded before them.");
+
 	const uint32_t previous_command_data_offset = command_data_offsets[p_previous_command_index];
 	RecordedCommand &previous_command = *reinterpret_cast<RecordedCommand *>(&command_data[previous_command_data_offset]);
-	previous_command.adjacent_command_list_index = _add_to_command_list(p_command_index, previous_command.adjacent_command_list_index);
+	if (previous_command.last_adjacent_command_index != p_command_index) {
+		// The same command is often reached through several resources, only store it once.
+		previous_command.last_adjacent_command_index = p_command_index;
+
+		RecordedCommandAdjacency adjacency;
+		adjacency.previous_command_index = p_previous_command_index;
+		adjacency.command_index = p_command_index;
+		command_adjacencies.push_back(adjacency);
+	}
+
 	previous_command.next_stages = previous_command.next_stages | r_command->self_stages;
 	r_command->previous_stages = r_command->previous_stages | previous_command.self_stages;
 }
@@ -1310,6 +1321,7 @@ void RenderingDeviceGraph::begin() {
 	command_label_colors.clear();
 	command_label_offsets.clear();
 	command_list_nodes.clear();
+	command_adjacencies.clear();
 	read_slice_list_nodes.clear();
 	write_slice_list_nodes.clear();
 	command_count = 0;
@@ -1896,60 +1908,6 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 
 	thread_local LocalVector<RecordedCommandSort> commands_sorted;
 	if (p_reorder_commands) {
-		thread_local LocalVector<int64_t> command_stack;
-		thread_local LocalVector<int32_t> sorted_command_indices;
-		thread_local LocalVector<uint32_t> command_degrees;
-		int32_t adjacency_list_index = 0;
-		int32_t command_index;
-
-		// Count all the incoming connections to every node by traversing their adjacency list.
-		command_degrees.resize(command_count);
-		memset(command_degrees.ptr(), 0, sizeof(uint32_t) * command_degrees.size());
-		for (uint32_t i = 0; i < command_count; i++) {
-			const RecordedCommand &recorded_command = *reinterpret_cast<const RecordedCommand *>(&command_data[command_data_offsets[i]]);
-			adjacency_list_index = recorded_command.adjacent_command_list_index;
-			while (adjacency_list_index >= 0) {
-				const RecordedCommandListNode &command_list_node = command_list_nodes[adjacency_list_index];
-				DEV_ASSERT((command_list_node.command_index != int32_t(i)) && "Command can't have itself as a dependency.");
-				command_degrees[command_list_node.command_index] += 1;
-				adjacency_list_index = command_list_node.next_list_index;
-			}
-		}
-
-		// Push to the stack all nodes that have no incoming connections.
-		command_stack.clear();
-		for (uint32_t i = 0; i < command_count; i++) {
-			if (command_degrees[i] == 0) {
-				command_stack.push_back(i);
-			}
-		}
-
-		sorted_command_indices.clear();
-		while (!command_stack.is_empty()) {
-			// Pop command from the stack.
-			command_index = command_stack[command_stack.size() - 1];
-			command_stack.resize(command_stack.size() - 1);
-
-			// Add it to the sorted commands.
-			sorted_command_indices.push_back(command_index);
-
-			// Search for its adjacents and lower their degree for every visit. If the degree reaches zero, we push the command to the stack.
-			const uint32_t command_data_offset = command_data_offsets[command_index];
-			const RecordedCommand &recorded_command = *reinterpret_cast<const RecordedCommand *>(&command_data[command_data_offset]);
-			adjacency_list_index = recorded_command.adjacent_command_list_index;
-			while (adjacency_list_index >= 0) {
-				const RecordedCommandListNode &command_list_node = command_list_nodes[adjacency_list_index];
-				uint32_t &command_degree = command_degrees[command_list_node.command_index];
-				DEV_ASSERT(command_degree > 0);
-				command_degree--;
-				if (command_degree == 0) {
-					command_stack.push_back(command_list_node.command_index);
-				}
-
-				adjacency_list_index = command_list_node.next_list_index;
-			}
-		}
-
 		// Batch buffer, texture, draw lists and compute operations together.
 		const uint32_t PriorityTable[RecordedCommand::TYPE_MAX] = {
 			0, // TYPE_NONE
@@ -1970,23 +1928,20 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 		commands_sorted.resize(command_count);
 
 		for (uint32_t i = 0; i < command_count; i++) {
-			const int32_t sorted_command_index = sorted_command_indices[i];
-			const uint32_t command_data_offset = command_data_offsets[sorted_command_index];
-			const RecordedCommand recorded_command = *reinterpret_cast<const RecordedCommand *>(&command_data[command_data_offset]);
-			const uint32_t next_command_level = commands_sorted[sorted_command_index].level + 1;
-			adjacency_list_index = recorded_command.adjacent_command_list_index;
-			while (adjacency_list_index >= 0) {
-				const RecordedCommandListNode &command_list_node = command_list_nodes[adjacency_list_index];
-				uint32_t &adjacent_command_level = commands_sorted[command_list_node.command_index].level;
-				if (adjacent_command_level < next_command_level) {
-					adjacent_command_level = next_command_level;
-				}
+			const RecordedCommand &recorded_command = *reinterpret_cast<const RecordedCommand *>(&command_data[command_data_offsets[i]]);
+			commands_sorted[i].index = i;
+			commands_sorted[i].priority = PriorityTable[recorded_command.type];
+		}
 
-				adjacency_list_index = command_list_node.next_list_index;
+		// The level of a command is the length of the longest chain of commands it depends on. The recording order is
+		// already a valid topological order and the adjacencies are stored in it, so by the time the adjacencies of a
+		// command are visited, the levels of the commands it depends on are final.
+		for (const RecordedCommandAdjacency &adjacency : command_adjacencies) {
+			const uint32_t next_command_level = commands_sorted[adjacency.previous_command_index].level + 1;
+			uint32_t &command_level = commands_sorted[adjacency.command_index].level;
+			if (command_level < next_command_level) {
+				command_level = next_command_level;
 			}
-
-			commands_sorted[sorted_command_index].index = sorted_command_index;
-			commands_sorted[sorted_command_index].priority = PriorityTable[recorded_command.type];
 		}
 	} else {
 		commands_sorted.clear();
@@ -101,7 +101,7 @@ public:
 		};
 
 		Type type = TYPE_NONE;
-		int32_t adjacent_command_list_index = -1;
+		int32_t last_adjacent_command_index = -1;
 		RDD::MemoryBarrier memory_barrier;
 		int32_t normalization_barrier_index = -1;
 		int normalization_barrier_count = 0;
@@ -257,6 +257,13 @@ private:
 		int32_t next_list_index = -1;
 	};
 
+	// Commands are only ever made adjacent to the command being recorded, so these are stored in
+	// recording order and the previous command always has a lower index.
+	struct RecordedCommandAdjacency {
+		int32_t previous_command_index = -1;
+		int32_t command_index = -1;
+	};
+
 	struct RecordedSliceListNode {
 		int32_t command_index = -1;
 		int32_t next_list_index = -1;
@@ -601,6 +608,7 @@ private:
 	uint32_t command_count = 0;
 	uint32_t command_label_count = 0;
 	LocalVector<RecordedCommandListNode> command_list_nodes;
+	LocalVector<RecordedCommandAdjacency> command_adjacencies;
 	LocalVector<RecordedSliceListNode> read_slice_list_nodes;
 	LocalVector<RecordedSliceListNode> write_slice_list_nodes;
 	int32_t command_timestamp_index = -1;
@@ -151,13 +151,34 @@ bool RenderingLightCuller::cull_directional_light(const RendererSceneCull::Insta
 }
 
 void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result) {
+	_cull_regular_light(r_instance_shadow_cull_result, data.regular_cull_planes, data.out_of_range);
+}
+
+void RenderingLightCuller::store_regular_light(uint32_t p_regular_light_id) {
+	if (p_regular_light_id >= data.stored_regular_lights.size()) {
+		data.stored_regular_lights.resize(p_regular_light_id + 1);
+	}
+
+	Data::StoredRegularLight &stored = data.stored_regular_lights[p_regular_light_id];
+	stored.cull_planes = data.regular_cull_planes;
+	stored.out_of_range = data.out_of_range;
+}
+
+void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result, uint32_t p_regular_light_id) {
+	ERR_FAIL_UNSIGNED_INDEX(p_regular_light_id, data.stored_regular_lights.size());
+
+	const Data::StoredRegularLight &stored = data.stored_regular_lights[p_regular_light_id];
+	_cull_regular_light(r_instance_shadow_cull_result, stored.cull_planes, stored.out_of_range);
+}
+
+void RenderingLightCuller::_cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result, const LightCullPlanes &p_cull_planes, bool p_out_of_range) {
 	if (!data.is_active() || !is_caster_culling_active()) {
 		return;
 	}
 
 	// If the light is out of range, no need to check anything, just return 0 casters.
 	// Ideally an out of range light should not even be drawn AT ALL (no shadow map, no PCF etc).
-	if (data.out_of_range) {
+	if (p_out_of_range) {
 		return;
 	}
 
@@ -182,13 +203,13 @@ void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Inst
 		real_t r_min, r_max;
 		bool show = true;
 
-		for (int p = 0; p < data.regular_cull_planes.num_cull_planes; p++) {
+		for (int p = 0; p < p_cull_planes.num_cull_planes; p++) {
 			// As we only need r_min, could this be optimized?
-			bb.project_range_in_plane(data.regular_cull_planes.cull_planes[p], r_min, r_max);
+			bb.project_range_in_plane(p_cull_planes.cull_planes[p], r_min, r_max);
 
 #ifdef LIGHT_CULLER_DEBUG_LOGGING
 			if (is_logging()) {
-				print_line("\tplane " + itos(p) + " : " + String(data.regular_cull_planes.cull_planes[p]) + " r_min " + String(Variant(r_min)) + " r_max " + String(Variant(r_max)));
+				print_line("\tplane " + itos(p) + " : " + String(p_cull_planes.cull_planes[p]) + " r_min " + String(Variant(r_min)) + " r_max " + String(Variant(r_max)));
 			}
 #endif
 
@@ -140,6 +140,11 @@ public:
 	// Cull according to the regular light planes that were setup in the previous call to prepare_regular_light.
 	void cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result);
 
+	// Keeps a copy of the planes setup in the previous call to prepare_regular_light, so several
+	// regular lights can be culled multithreaded later on, each using its own regular_light_id.
+	void store_regular_light(uint32_t p_regular_light_id);
+	void cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result, uint32_t p_regular_light_id);
+
 	// Directional lights are prepared in advance, and can be culled multithreaded chopping and changing between
 	// different directional_light_id.
 	void prepare_directional_light(const RendererSceneCull::Instance *p_instance, int32_t p_directional_light_id);
@@ -162,6 +167,7 @@ private:
 	};
 
 	bool _prepare_light(const RendererSceneCull::Instance &p_instance, int32_t p_directional_light_id = -1);
+	void _cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result, const LightCullPlanes &p_cull_planes, bool p_out_of_range);
 
 	// Avoid adding extra culling planes derived from near colinear triangles.
 	// The normals derived from these will be inaccurate, and can lead to false
@@ -227,6 +233,13 @@ private:
 		// (OMNI, SPOT). These lights reuse the same set of cull plane data.
 		LightCullPlanes regular_cull_planes;
 
+		// Copies of the regular light cull planes made by store_regular_light.
+		struct StoredRegularLight {
+			LightCullPlanes cull_planes;
+			bool out_of_range = false;
+		};
+		LocalVector<StoredRegularLight> stored_regular_lights;
+
 #ifdef LIGHT_CULLER_DEBUG_REGULAR_LIGHT
 		uint32_t regular_rejected_count = 0;
 #endif
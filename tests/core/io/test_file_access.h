@@ -107,6 +107,54 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Mapped spans") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	const uint64_t length = f->get_length();
+	CHECK(f->get_8() == 'H');
+
+	const uint8_t *span = f->get_mapped_span(0, length);
+	if (span == nullptr) {
+		MESSAGE("Memory mapping is unavailable for this file, skipping.");
+		return;
+	}
+	CHECK(memcmp(span, "Hello darkness\n", 15) == 0);
+	CHECK(f->get_mapped_span(length, 1) == nullptr);
+
+	// Regular reads keep working from the same position once the file is mapped.
+	CHECK(f->get_position() == 1);
+	CHECK(f->get_8() == 'e');
+
+	const uint8_t *buffer = f->get_mapped_buffer(4);
+	REQUIRE(buffer != nullptr);
+	CHECK(memcmp(buffer, "llo ", 4) == 0);
+	CHECK(f->get_position() == 6);
+
+	f->seek_end();
+	CHECK(f->get_position() == length);
+	f->get_8();
+	CHECK(f->eof_reached());
+}
+
+TEST_CASE("[FileAccess] Mapping clears the end of file reached before") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	const uint64_t length = f->get_length();
+	f->seek_end();
+	f->get_8();
+	CHECK(f->eof_reached());
+
+	if (f->get_mapped_span(0, length) == nullptr) {
+		MESSAGE("Memory mapping is unavailable for this file, skipping.");
+		return;
+	}
+	f->seek(0);
+	uint8_t buffer[5];
+	CHECK(f->get_buffer(buffer, 5) == 5);
+	CHECK(memcmp(buffer, "Hello", 5) == 0);
+	CHECK_FALSE(f->eof_reached());
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
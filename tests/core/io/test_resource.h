@@ -32,9 +32,11 @@
 #define TEST_RESOURCE_H
 
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
+#include "scene/resources/animation.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -166,6 +168,103 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Batch loading with shared dependencies") {
+	const String save_path_leaf = TestUtils::get_temp_path("batch_leaf.res");
+	const String save_path_root_a = TestUtils::get_temp_path("batch_root_a.res");
+	const String save_path_root_b = TestUtils::get_temp_path("batch_root_b.tres");
+	{
+		Ref<Resource> leaf = memnew(Resource);
+		leaf->set_name("Leaf");
+		ResourceSaver::save(leaf, save_path_leaf, ResourceSaver::FLAG_CHANGE_PATH);
+
+		Ref<Resource> root_a = memnew(Resource);
+		root_a->set_name("A");
+		root_a->set_meta("leaf", leaf);
+		ResourceSaver::save(root_a, save_path_root_a);
+
+		Ref<Resource> root_b = memnew(Resource);
+		root_b->set_name("B");
+		root_b->set_meta("leaf", leaf);
+		ResourceSaver::save(root_b, save_path_root_b);
+	}
+
+	Vector<String> paths;
+	paths.push_back(save_path_root_a);
+	paths.push_back(save_path_root_b);
+	Vector<Ref<Resource>> resources;
+	Vector<ResourceLoader::BatchLoadInfo> info;
+	CHECK(ResourceLoader::load_batch(paths, resources, &info) == OK);
+
+	REQUIRE(resources.size() == 2);
+	REQUIRE(resources[0].is_valid());
+	REQUIRE(resources[1].is_valid());
+	CHECK(resources[0]->get_name() == "A");
+	CHECK(resources[1]->get_name() == "B");
+	const Ref<Resource> leaf_a = resources[0]->get_meta("leaf");
+	const Ref<Resource> leaf_b = resources[1]->get_meta("leaf");
+	REQUIRE(leaf_a.is_valid());
+	CHECK_MESSAGE(
+			leaf_a == leaf_b,
+			"The shared dependency should be loaded once for both roots.");
+
+	// The leaf comes first and is loaded in the first wave, the roots depend on it.
+	REQUIRE(info.size() == 3);
+	for (const ResourceLoader::BatchLoadInfo &E : info) {
+		CHECK(E.error == OK);
+		CHECK(E.bytes > 0);
+		CHECK(E.critical_path_usec >= E.load_usec);
+		if (E.dependencies.is_empty()) {
+			CHECK(E.depth == 0);
+		} else {
+			CHECK(E.depth == 1);
+			CHECK(E.dependencies.size() == 1);
+		}
+	}
+}
+
+TEST_CASE("[Resource] Streaming large subresources") {
+	const String save_path = TestUtils::get_temp_path("streamed.res");
+	{
+		Ref<Animation> animation;
+		animation.instantiate();
+		const int track = animation->add_track(Animation::TYPE_VALUE);
+		animation->track_set_path(track, NodePath("Node:position"));
+		for (int i = 0; i < 1000; i++) {
+			animation->track_insert_key(track, i * 0.1, Vector3(i, -i, i * 2));
+		}
+
+		Ref<Resource> root = memnew(Resource);
+		root->set_name("Root");
+		root->set_meta("animation", animation);
+		ResourceSaver::save(root, save_path);
+	}
+
+	const uint64_t threshold = ResourceFormatLoaderBinary::get_stream_threshold();
+	ResourceFormatLoaderBinary::set_stream_threshold(1024);
+	const Ref<Resource> root = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ResourceFormatLoaderBinary::set_stream_threshold(threshold);
+
+	REQUIRE(root.is_valid());
+	CHECK(root->get_name() == "Root");
+	const Ref<Animation> animation = root->get_meta("animation");
+	REQUIRE(animation.is_valid());
+
+	// Data is only applied on the main thread, so nothing has arrived yet.
+	CHECK(ResourceFormatLoaderBinary::is_streaming(animation));
+	CHECK(animation->get_track_count() == 0);
+
+	ResourceFormatLoaderBinary::finish_streaming(animation);
+	CHECK_FALSE(ResourceFormatLoaderBinary::is_streaming(animation));
+	REQUIRE(animation->get_track_count() == 1);
+	CHECK(animation->track_get_path(0) == NodePath("Node:position"));
+	REQUIRE(animation->track_get_key_count(0) == 1000);
+	CHECK(animation->track_get_key_value(0, 999) == Variant(Vector3(999, -999, 1998)));
+
+	// The root itself is never streamed.
+	CHECK_FALSE(ResourceFormatLoaderBinary::is_streaming(root));
+}
+
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
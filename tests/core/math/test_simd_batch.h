@@ -0,0 +1,391 @@
+/**************************************************************************/
+/*  test_simd_batch.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SIMD_BATCH_H
+#define TEST_SIMD_BATCH_H
+
+#include "core/math/random_number_generator.h"
+#include "core/math/simd_batch.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+#include <cstring>
+
+namespace TestSIMDBatch {
+
+static Vector3 random_vector(Ref<RandomNumberGenerator> &p_rng) {
+	Vector3 v;
+	for (int i = 0; i < 3; i++) {
+		// Include signed zeros, they are the easiest way to break bit-exactness.
+		switch (p_rng->randi() % 16) {
+			case 0:
+				v[i] = 0.0;
+				break;
+			case 1:
+				v[i] = -0.0;
+				break;
+			default:
+				v[i] = p_rng->randf_range(-1000.0, 1000.0);
+		}
+	}
+	return v;
+}
+
+static Transform3D random_transform(Ref<RandomNumberGenerator> &p_rng) {
+	Transform3D t;
+	t.basis.rows[0] = random_vector(p_rng);
+	t.basis.rows[1] = random_vector(p_rng);
+	t.basis.rows[2] = random_vector(p_rng);
+	t.origin = random_vector(p_rng);
+	return t;
+}
+
+// Every supported implementation, scalar included.
+static LocalVector<SIMDBatch::Level> supported_levels() {
+	LocalVector<SIMDBatch::Level> levels;
+	levels.push_back(SIMDBatch::LEVEL_SCALAR);
+	if (SIMDBatch::get_supported_level() == SIMDBatch::LEVEL_AVX2) {
+		levels.push_back(SIMDBatch::LEVEL_SSE4);
+	}
+	if (SIMDBatch::get_supported_level() != SIMDBatch::LEVEL_SCALAR) {
+		levels.push_back(SIMDBatch::get_supported_level());
+	}
+	return levels;
+}
+
+TEST_CASE("[SIMDBatch] Results are bit-identical to the scalar operators") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	const SIMDBatch::Level default_level = SIMDBatch::get_level();
+	for (const SIMDBatch::Level level : supported_levels()) {
+		SIMDBatch::set_level(level);
+		CHECK(SIMDBatch::get_level() == level);
+
+		// Odd sizes exercise the remainder loops of every kernel.
+		for (uint32_t count = 0; count < 40; count++) {
+			LocalVector<Vector3> points;
+			LocalVector<Transform3D> a;
+			LocalVector<Transform3D> b;
+			for (uint32_t i = 0; i < count; i++) {
+				points.push_back(random_vector(rng));
+				a.push_back(random_transform(rng));
+				b.push_back(random_transform(rng));
+			}
+			const Transform3D xform = random_transform(rng);
+
+			LocalVector<Vector3> points_out;
+			LocalVector<Vector3> points_expected;
+			points_out.resize(count);
+			points_expected.resize(count);
+			LocalVector<Transform3D> xforms_out;
+			LocalVector<Transform3D> xforms_expected;
+			xforms_out.resize(count);
+			xforms_expected.resize(count);
+
+			SIMDBatch::xform_points(xform, points.ptr(), points_out.ptr(), count);
+			for (uint32_t i = 0; i < count; i++) {
+				points_expected[i] = xform.xform(points[i]);
+			}
+			CHECK_MESSAGE(memcmp(points_out.ptr(), points_expected.ptr(), sizeof(Vector3) * count) == 0,
+					vformat("xform_points mismatch at level %d with %d points.", level, count));
+
+			SIMDBatch::xform_vectors(xform.basis, points.ptr(), points_out.ptr(), count);
+			for (uint32_t i = 0; i < count; i++) {
+				points_expected[i] = xform.basis.xform(points[i]);
+			}
+			CHECK_MESSAGE(memcmp(points_out.ptr(), points_expected.ptr(), sizeof(Vector3) * count) == 0,
+					vformat("xform_vectors mismatch at level %d with %d points.", level, count));
+
+			SIMDBatch::multiply_transforms(a.ptr(), b.ptr(), xforms_out.ptr(), count);
+			for (uint32_t i = 0; i < count; i++) {
+				xforms_expected[i] = a[i] * b[i];
+			}
+			CHECK_MESSAGE(memcmp(xforms_out.ptr(), xforms_expected.ptr(), sizeof(Transform3D) * count) == 0,
+					vformat("multiply_transforms mismatch at level %d with %d transforms.", level, count));
+
+			SIMDBatch::multiply_transforms(xform, b.ptr(), xforms_out.ptr(), count);
+			for (uint32_t i = 0; i < count; i++) {
+				xforms_expected[i] = xform * b[i];
+			}
+			CHECK_MESSAGE(memcmp(xforms_out.ptr(), xforms_expected.ptr(), sizeof(Transform3D) * count) == 0,
+					vformat("multiply_transforms with a single transform mismatch at level %d with %d transforms.", level, count));
+
+			LocalVector<float> from;
+			LocalVector<float> to;
+			LocalVector<float> weights;
+			LocalVector<float> scales;
+			LocalVector<float> offsets;
+			for (uint32_t i = 0; i < count; i++) {
+				from.push_back(rng->randf());
+				to.push_back(rng->randf());
+				weights.push_back(rng->randf());
+				scales.push_back(rng->randf_range(-10.0, 10.0));
+				offsets.push_back(rng->randf_range(-10.0, 10.0));
+			}
+			LocalVector<float> rescaled_out;
+			LocalVector<float> rescaled_expected;
+			rescaled_out.resize(count);
+			rescaled_expected.resize(count);
+			SIMDBatch::lerp_rescale(from.ptr(), to.ptr(), weights.ptr(), scales.ptr(), offsets.ptr(), rescaled_out.ptr(), count);
+			for (uint32_t i = 0; i < count; i++) {
+				rescaled_expected[i] = offsets[i] + Math::lerp(from[i], to[i], weights[i]) * scales[i];
+			}
+			CHECK_MESSAGE(memcmp(rescaled_out.ptr(), rescaled_expected.ptr(), sizeof(float) * count) == 0,
+					vformat("lerp_rescale mismatch at level %d with %d values.", level, count));
+
+			LocalVector<real_t> min_out;
+			LocalVector<real_t> max_out;
+			min_out.resize(count);
+			max_out.resize(count);
+			const Vector3 half_extents = random_vector(rng).abs();
+			SIMDBatch::project_box(xform, half_extents, points.ptr(), min_out.ptr(), max_out.ptr(), count);
+			bool box_match = true;
+			for (uint32_t i = 0; i < count; i++) {
+				const real_t length = xform.basis.xform_inv(points[i]).abs().dot(half_extents);
+				const real_t distance = points[i].dot(xform.origin);
+				const real_t expected_min = distance - length;
+				const real_t expected_max = distance + length;
+				box_match = box_match && memcmp(&min_out[i], &expected_min, sizeof(real_t)) == 0 && memcmp(&max_out[i], &expected_max, sizeof(real_t)) == 0;
+			}
+			CHECK_MESSAGE(box_match, vformat("project_box mismatch at level %d with %d axes.", level, count));
+
+			if (count > 0) {
+				const Vector3 axis = random_vector(rng);
+				real_t expected_min = 0.0;
+				real_t expected_max = 0.0;
+				real_t expected_support = 0.0;
+				uint32_t expected_index = 0;
+				for (uint32_t i = 0; i < count; i++) {
+					const real_t d = axis.dot(xform.xform(points[i]));
+					if (i == 0 || d > expected_max) {
+						expected_max = d;
+					}
+					if (i == 0 || d < expected_min) {
+						expected_min = d;
+					}
+					const real_t support = axis.dot(points[i]);
+					if (i == 0 || support > expected_support) {
+						expected_support = support;
+						expected_index = i;
+					}
+				}
+				real_t range_min = 0.0;
+				real_t range_max = 0.0;
+				SIMDBatch::project_points(xform, axis, points.ptr(), count, range_min, range_max);
+				CHECK_MESSAGE(memcmp(&range_min, &expected_min, sizeof(real_t)) == 0, vformat("project_points minimum mismatch at level %d with %d points.", level, count));
+				CHECK_MESSAGE(memcmp(&range_max, &expected_max, sizeof(real_t)) == 0, vformat("project_points maximum mismatch at level %d with %d points.", level, count));
+				CHECK_MESSAGE(SIMDBatch::get_support_index(axis, points.ptr(), count) == expected_index, vformat("get_support_index mismatch at level %d with %d points.", level, count));
+			}
+
+			if (count > 0) {
+				AABB expected(points[0], Vector3());
+				for (uint32_t i = 1; i < count; i++) {
+					expected.expand_to(points[i]);
+				}
+				CHECK_MESSAGE(SIMDBatch::compute_aabb(points.ptr(), count).is_equal_approx(expected),
+						vformat("compute_aabb mismatch at level %d with %d points.", level, count));
+			}
+		}
+	}
+	SIMDBatch::set_level(default_level);
+}
+
+TEST_CASE("[SIMDBatch] In-place operation and edge cases") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(7);
+
+	const SIMDBatch::Level default_level = SIMDBatch::get_level();
+	for (const SIMDBatch::Level level : supported_levels()) {
+		SIMDBatch::set_level(level);
+
+		LocalVector<Vector3> points;
+		LocalVector<Transform3D> xforms;
+		for (uint32_t i = 0; i < 19; i++) {
+			points.push_back(random_vector(rng));
+			xforms.push_back(random_transform(rng));
+		}
+		const Transform3D xform = random_transform(rng);
+
+		LocalVector<Vector3> points_in_place = points;
+		SIMDBatch::xform_points(xform, points_in_place.ptr(), points_in_place.ptr(), points.size());
+		bool points_match = true;
+		for (uint32_t i = 0; i < points.size(); i++) {
+			points_match = points_match && points_in_place[i] == xform.xform(points[i]);
+		}
+		CHECK_MESSAGE(points_match, vformat("In-place xform_points mismatch at level %d.", level));
+
+		LocalVector<Transform3D> xforms_in_place = xforms;
+		SIMDBatch::multiply_transforms(xform, xforms_in_place.ptr(), xforms_in_place.ptr(), xforms.size());
+		bool xforms_match = true;
+		for (uint32_t i = 0; i < xforms.size(); i++) {
+			xforms_match = xforms_match && xforms_in_place[i] == xform * xforms[i];
+		}
+		CHECK_MESSAGE(xforms_match, vformat("In-place multiply_transforms mismatch at level %d.", level));
+
+		// Ties go to the first point.
+		LocalVector<Vector3> repeated;
+		for (uint32_t i = 0; i < 11; i++) {
+			repeated.push_back(i % 3 ? Vector3(0, 0, 0) : Vector3(1, 2, 3));
+		}
+		CHECK(SIMDBatch::get_support_index(Vector3(0, 1, 0), repeated.ptr(), repeated.size()) == 0);
+		CHECK(SIMDBatch::get_support_index(Vector3(0, -1, 0), repeated.ptr(), repeated.size()) == 1);
+		CHECK(SIMDBatch::get_support_index(Vector3(0, 1, 0), repeated.ptr(), 0) == 0);
+
+		CHECK(SIMDBatch::compute_aabb(points.ptr(), 0) == AABB());
+		CHECK(SIMDBatch::compute_aabb(points.ptr(), 1) == AABB(points[0], Vector3()));
+	}
+	SIMDBatch::set_level(default_level);
+
+	// Unsupported levels fall back to the scalar implementation.
+	if (SIMDBatch::get_supported_level() != SIMDBatch::LEVEL_NEON) {
+		SIMDBatch::set_level(SIMDBatch::LEVEL_NEON);
+		CHECK(SIMDBatch::get_level() == SIMDBatch::LEVEL_SCALAR);
+		SIMDBatch::set_level(default_level);
+	}
+
+	const Transform3D xform = random_transform(rng);
+	const Vector<Vector3> array = { Vector3(1, 2, 3), Vector3(-4, 5, -6), Vector3(7, -8, 9), Vector3(0, 0, 0), Vector3(1, 1, 1) };
+	const Vector<Vector3> transformed = xform.xform(array);
+	REQUIRE(transformed.size() == array.size());
+	for (int i = 0; i < array.size(); i++) {
+		CHECK(transformed[i] == xform.xform(array[i]));
+	}
+}
+
+TEST_CASE("[SIMDBatch] Support index matches the scalar extreme vertex loop") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(11);
+
+	const SIMDBatch::Level default_level = SIMDBatch::get_level();
+	for (const SIMDBatch::Level level : supported_levels()) {
+		SIMDBatch::set_level(level);
+
+		for (uint32_t count = 1; count <= 26; count++) {
+			// Points on a small grid, visited in a shuffled order like the
+			// extreme vertices of a convex hull, so that ties are common.
+			LocalVector<int> order;
+			LocalVector<Vector3> positions;
+			for (uint32_t i = 0; i < count; i++) {
+				order.push_back(i);
+			}
+			for (uint32_t i = count - 1; i > 0; i--) {
+				SWAP(order[i], order[rng->randi() % (i + 1)]);
+			}
+			LocalVector<Vector3> vertices;
+			for (uint32_t i = 0; i < count; i++) {
+				vertices.push_back(Vector3(rng->randi_range(-1, 1), rng->randi_range(-1, 1), rng->randi_range(-1, 1)));
+			}
+			for (const int vertex : order) {
+				positions.push_back(vertices[vertex]);
+			}
+
+			bool support_match = true;
+			for (int x = -1; x < 2; x++) {
+				for (int y = -1; y < 2; y++) {
+					for (int z = -1; z < 2; z++) {
+						const Vector3 direction(x, y, z);
+
+						// The loop GodotConvexPolygonShape3D::get_support() used before.
+						int best_vertex = order[0];
+						real_t max_support = direction.dot(vertices[best_vertex]);
+						for (const int &vert : order) {
+							real_t s = direction.dot(vertices[vert]);
+							if (s > max_support) {
+								best_vertex = vert;
+								max_support = s;
+							}
+						}
+
+						const uint32_t index = SIMDBatch::get_support_index(direction, positions.ptr(), count);
+						support_match = support_match && order[index] == best_vertex;
+					}
+				}
+			}
+			CHECK_MESSAGE(support_match, vformat("get_support_index tie-break mismatch at level %d with %d points.", level, count));
+		}
+	}
+	SIMDBatch::set_level(default_level);
+}
+
+TEST_CASE("[SIMDBatch][Benchmark] Compare with scalar loops" * doctest::skip()) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1);
+
+	const uint32_t count = 1 << 20;
+	LocalVector<Vector3> points;
+	LocalVector<Transform3D> xforms;
+	points.resize(count);
+	xforms.resize(count / 4);
+	for (uint32_t i = 0; i < count; i++) {
+		points[i] = random_vector(rng);
+	}
+	for (uint32_t i = 0; i < count / 4; i++) {
+		xforms[i] = random_transform(rng);
+	}
+	const Transform3D xform = random_transform(rng);
+
+	LocalVector<Vector3> points_out;
+	LocalVector<Transform3D> xforms_out;
+	points_out.resize(count);
+	xforms_out.resize(count / 4);
+
+	const SIMDBatch::Level default_level = SIMDBatch::get_level();
+	for (const SIMDBatch::Level level : supported_levels()) {
+		SIMDBatch::set_level(level);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < 20; i++) {
+			SIMDBatch::xform_points(xform, points.ptr(), points_out.ptr(), count);
+		}
+		uint64_t points_done = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < 20; i++) {
+			SIMDBatch::multiply_transforms(xform, xforms.ptr(), xforms_out.ptr(), count / 4);
+		}
+		uint64_t xforms_done = OS::get_singleton()->get_ticks_usec();
+		AABB bounds;
+		for (int i = 0; i < 20; i++) {
+			bounds.merge_with(SIMDBatch::compute_aabb(points.ptr(), count));
+		}
+		uint64_t aabb_done = OS::get_singleton()->get_ticks_usec();
+		MESSAGE("Level ", level, ": xform_points ", points_done - begin, " usec, multiply_transforms ", xforms_done - points_done, " usec, compute_aabb ", aabb_done - xforms_done, " usec.");
+	}
+	SIMDBatch::set_level(default_level);
+	CHECK(points_out.size() == count);
+}
+
+} // namespace TestSIMDBatch
+
+#endif // TEST_SIMD_BATCH_H
@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = StringName("test_string_name_interning");
+	const StringName b = StringName(String("test_string_name_interning"));
+	const StringName c = SNAME("test_string_name_interning");
+
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(String(a) == "test_string_name_interning");
+	CHECK(StringName::search("test_string_name_interning") == a);
+	CHECK(StringName::search(String("test_string_name_never_interned")) == StringName());
+}
+
+TEST_CASE("[StringName] Released names can be interned again") {
+	const void *ptr = nullptr;
+	{
+		StringName name = StringName(String("test_string_name_released"));
+		ptr = name.data_unique_pointer();
+		CHECK(ptr != nullptr);
+	}
+	CHECK(StringName::search(String("test_string_name_released")) == StringName());
+
+	StringName name = StringName(String("test_string_name_released"));
+	CHECK(name == StringName::search(String("test_string_name_released")));
+	CHECK(String(name) == "test_string_name_released");
+}
+
+struct InternThreadData {
+	const Vector<String> *names = nullptr;
+	Vector<const void *> results;
+	uint32_t rounds = 1;
+};
+
+static void intern_thread(void *p_user) {
+	InternThreadData *data = (InternThreadData *)p_user;
+	const Vector<String> &names = *data->names;
+	data->results.resize(names.size());
+	data->results.fill(nullptr);
+	for (uint32_t round = 0; round < data->rounds; round++) {
+		for (int i = 0; i < names.size(); i++) {
+			// Keep a reference to half of them, let the rest be created and freed over and over.
+			StringName sn = StringName(names[i]);
+			if (round == 0 && (i % 2) == 0) {
+				data->results.write[i] = sn.data_unique_pointer();
+			}
+		}
+	}
+}
+
+static uint64_t intern_with_threads(const Vector<String> &p_names, int p_thread_count, uint32_t p_rounds, bool &r_consistent) {
+	// Names interned by every thread should be the same entry.
+	LocalVector<StringName> keep_alive;
+	for (int i = 0; i < p_names.size(); i += 2) {
+		keep_alive.push_back(StringName(p_names[i]));
+	}
+
+	LocalVector<InternThreadData> data;
+	data.resize(p_thread_count);
+	LocalVector<Thread> threads;
+	threads.resize(p_thread_count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_thread_count; i++) {
+		data[i].names = &p_names;
+		data[i].rounds = p_rounds;
+		threads[i].start(intern_thread, &data[i]);
+	}
+	for (int i = 0; i < p_thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	r_consistent = true;
+	for (int i = 0; i < p_thread_count; i++) {
+		for (uint32_t j = 0; j < keep_alive.size(); j++) {
+			r_consistent &= data[i].results[j * 2] == keep_alive[j].data_unique_pointer();
+		}
+	}
+	return elapsed;
+}
+
+static Vector<String> make_names(int p_count) {
+	Vector<String> names;
+	names.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		names.write[i] = "test_string_name_concurrent_" + itos(i);
+	}
+	return names;
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	const Vector<String> names = make_names(1000);
+	bool consistent = false;
+	intern_with_threads(names, 8, 10, consistent);
+	CHECK_MESSAGE(consistent, "All threads should have got the same entry for each name.");
+}
+
+TEST_CASE("[StringName][Benchmark] Interning throughput" * doctest::skip()) {
+	const Vector<String> names = make_names(10000);
+	const uint32_t rounds = 100;
+	const int thread_counts[] = { 1, 8, 32 };
+	for (int thread_count : thread_counts) {
+		bool consistent = false;
+		uint64_t usec = intern_with_threads(names, thread_count, rounds, consistent);
+		CHECK(consistent);
+		const double interns = double(names.size()) * rounds * thread_count;
+		MESSAGE(thread_count, " threads: ", usec, " usec, ", interns / MAX(usec, (uint64_t)1), " interns/usec.");
+	}
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
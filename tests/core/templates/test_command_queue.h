@@ -446,6 +446,79 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+class MultiProducerState {
+public:
+	static const int PRODUCER_COUNT = 4;
+	static const int COMMANDS_PER_PRODUCER = 10000;
+
+	CommandQueueMT command_queue;
+	SafeFlag producers_done;
+	SafeNumeric<int> sum;
+	SafeNumeric<int> count;
+	SafeNumeric<int> bad_returns;
+
+	void add(int p_value, Transform3D p_transform) {
+		sum.add(p_value);
+		count.increment();
+	}
+	int add_and_ret(int p_value) {
+		sum.add(p_value);
+		count.increment();
+		return p_value * 2;
+	}
+
+	static void producer_loop(void *p_state) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_state);
+		for (int i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+			if (i % 500 == 0) {
+				// Mix in some syncing commands, which must wait for the consumer.
+				int ret = 0;
+				state->command_queue.push_and_ret(state, &MultiProducerState::add_and_ret, i, &ret);
+				if (ret != i * 2) {
+					state->bad_returns.increment();
+				}
+			} else {
+				state->command_queue.push(state, &MultiProducerState::add, i, Transform3D());
+			}
+		}
+	}
+
+	static void consumer_loop(void *p_state) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_state);
+		while (!state->producers_done.is_set()) {
+			state->command_queue.flush_all();
+		}
+		state->command_queue.flush_all();
+	}
+};
+
+TEST_CASE("[CommandQueue] Test multiple producers") {
+	MultiProducerState state;
+	CommandQueueMT::Stats stats_before = CommandQueueMT::get_total_stats();
+
+	Thread consumer;
+	consumer.start(&MultiProducerState::consumer_loop, &state);
+	Thread producers[MultiProducerState::PRODUCER_COUNT];
+	for (int i = 0; i < MultiProducerState::PRODUCER_COUNT; i++) {
+		producers[i].start(&MultiProducerState::producer_loop, &state);
+	}
+	for (int i = 0; i < MultiProducerState::PRODUCER_COUNT; i++) {
+		producers[i].wait_to_finish();
+	}
+	state.producers_done.set();
+	consumer.wait_to_finish();
+
+	const int total = MultiProducerState::PRODUCER_COUNT * MultiProducerState::COMMANDS_PER_PRODUCER;
+	const int expected_sum = MultiProducerState::PRODUCER_COUNT * (MultiProducerState::COMMANDS_PER_PRODUCER * (MultiProducerState::COMMANDS_PER_PRODUCER - 1) / 2);
+	CHECK_MESSAGE(state.count.get() == total, "All commands from all producers should have been run once.");
+	CHECK_MESSAGE(state.sum.get() == expected_sum, "All commands should have been run with their own arguments.");
+	CHECK_MESSAGE(state.bad_returns.get() == 0, "Returning commands should have returned their own results.");
+
+	CommandQueueMT::Stats stats_after = CommandQueueMT::get_total_stats();
+	CHECK_MESSAGE(stats_after.commands - stats_before.commands >= (uint64_t)total, "Flushed commands should be counted.");
+	CHECK_MESSAGE(stats_after.producer_stalls > stats_before.producer_stalls, "Filling more than one chunk should count producer stalls.");
+}
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
@@ -0,0 +1,288 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLAT_HASH_MAP_H
+#define TEST_FLAT_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/string/ustring.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/flat_hash_set.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/oa_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] Insert element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+	CHECK(map.get_capacity() == FlatHashMap<int, int>::MIN_CAPACITY);
+}
+
+TEST_CASE("[FlatHashMap] Overwrite element") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[FlatHashMap] Erase via element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[FlatHashMap] Erase via key") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	CHECK(map.erase(42));
+	CHECK(!map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Missing keys") {
+	FlatHashMap<int, int> map;
+	CHECK(!map.has(1));
+	CHECK(map.getptr(1) == nullptr);
+	CHECK(map.begin() == map.end());
+
+	map.insert(1, 2);
+	CHECK(map.getptr(2) == nullptr);
+	CHECK(*map.getptr(1) == 2);
+}
+
+TEST_CASE("[FlatHashMap] Grow, erase and reinsert many elements") {
+	FlatHashMap<int, int> map;
+	const int count = 10000;
+	for (int i = 0; i < count; i++) {
+		map[i * 7] = i;
+	}
+	CHECK(map.size() == count);
+	CHECK(map.get_capacity() >= (uint32_t)count);
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		const int *value = map.getptr(i * 7);
+		all_found = all_found && value != nullptr && *value == i;
+	}
+	CHECK(all_found);
+	CHECK(!map.has(1));
+
+	// Leave tombstones behind, then fill them again.
+	for (int i = 0; i < count; i += 2) {
+		CHECK(map.erase(i * 7));
+	}
+	CHECK(map.size() == count / 2);
+
+	bool odd_found = true;
+	bool even_gone = true;
+	for (int i = 0; i < count; i++) {
+		if (i % 2) {
+			odd_found = odd_found && map.has(i * 7);
+		} else {
+			even_gone = even_gone && !map.has(i * 7);
+		}
+	}
+	CHECK(odd_found);
+	CHECK(even_gone);
+
+	const uint32_t capacity = map.get_capacity();
+	for (int round = 0; round < 8; round++) {
+		for (int i = 0; i < count; i += 2) {
+			map.insert(-(i * 7 + round + 1), i);
+		}
+		for (int i = 0; i < count; i += 2) {
+			map.erase(-(i * 7 + round + 1));
+		}
+	}
+	// Churn must be absorbed by reclaiming tombstones, not by growing.
+	CHECK(map.get_capacity() == capacity);
+	CHECK(map.size() == count / 2);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(7));
+}
+
+TEST_CASE("[FlatHashMap] Iteration visits every element once") {
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+	map.erase(500);
+
+	int visited = 0;
+	int64_t key_sum = 0;
+	bool values_match = true;
+	for (const KeyValue<int, int> &E : map) {
+		visited++;
+		key_sum += E.key;
+		values_match = values_match && E.value == E.key * 2;
+	}
+	CHECK(visited == 999);
+	CHECK(key_sum == 999 * 1000 / 2 - 500);
+	CHECK(values_match);
+
+	// Removing during iteration doesn't move the remaining elements.
+	for (FlatHashMap<int, int>::Iterator E = map.begin(); E;) {
+		FlatHashMap<int, int>::Iterator current = E;
+		++E;
+		if (current->key % 2) {
+			map.remove(current);
+		}
+	}
+	CHECK(map.size() == 499);
+	CHECK(!map.has(1));
+	CHECK(map.has(2));
+}
+
+TEST_CASE("[FlatHashMap] Copy and non-trivial types") {
+	FlatHashMap<String, String> map;
+	for (int i = 0; i < 200; i++) {
+		map.insert(itos(i), "value" + itos(i));
+	}
+
+	const FlatHashMap<String, String> copy = map;
+	map.clear();
+	CHECK(copy.size() == 200);
+	CHECK(copy["42"] == "value42");
+	CHECK(copy.find("199"));
+	CHECK(!copy.find("200"));
+
+	FlatHashMap<String, String> assigned;
+	assigned.insert("gone", "gone");
+	assigned = copy;
+	CHECK(assigned.size() == 200);
+	CHECK(!assigned.has("gone"));
+	CHECK(assigned.get("7") == "value7");
+}
+
+TEST_CASE("[FlatHashSet] Insert, erase and iterate") {
+	FlatHashSet<int> set;
+	for (int i = 0; i < 1000; i++) {
+		set.insert(i);
+	}
+	set.insert(10);
+	CHECK(set.size() == 1000);
+
+	for (int i = 0; i < 1000; i += 3) {
+		CHECK(set.erase(i));
+	}
+	CHECK(!set.has(0));
+	CHECK(set.has(1));
+
+	int visited = 0;
+	bool none_erased = true;
+	for (const int &E : set) {
+		visited++;
+		none_erased = none_erased && (E % 3) != 0;
+	}
+	CHECK(visited == (int)set.size());
+	CHECK(none_erased);
+
+	FlatHashSet<int> copy = set;
+	set.reset();
+	CHECK(set.is_empty());
+	CHECK(set.get_capacity() == 0);
+	CHECK(copy.has(998));
+	CHECK(!copy.has(999));
+}
+
+TEST_CASE("[FlatHashMap][Benchmark] Compare with HashMap and OAHashMap" * doctest::skip()) {
+	const uint32_t count = 1000000;
+	LocalVector<uint32_t> keys;
+	keys.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		keys[i] = hash_murmur3_one_32(i);
+	}
+
+	uint64_t found = 0;
+	auto report = [&](const char *p_name, uint64_t p_insert, uint64_t p_lookup) {
+		MESSAGE(p_name, ": insert ", p_insert, " usec, lookup ", p_lookup, " usec.");
+	};
+
+	{
+		FlatHashMap<uint32_t, uint32_t> map;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			map.insert(keys[i], i);
+		}
+		uint64_t inserted = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count * 2; i++) {
+			found += map.has(keys[i % count] + (i >= count));
+		}
+		report("FlatHashMap", inserted - begin, OS::get_singleton()->get_ticks_usec() - inserted);
+	}
+	{
+		HashMap<uint32_t, uint32_t> map;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			map.insert(keys[i], i);
+		}
+		uint64_t inserted = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count * 2; i++) {
+			found += map.has(keys[i % count] + (i >= count));
+		}
+		report("HashMap", inserted - begin, OS::get_singleton()->get_ticks_usec() - inserted);
+	}
+	{
+		OAHashMap<uint32_t, uint32_t> map;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			map.insert(keys[i], i);
+		}
+		uint64_t inserted = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count * 2; i++) {
+			found += map.has(keys[i % count] + (i >= count));
+		}
+		report("OAHashMap", inserted - begin, OS::get_singleton()->get_ticks_usec() - inserted);
+	}
+	CHECK(found >= count * 3);
+}
+
+} // namespace TestFlatHashMap
+
+#endif // TEST_FLAT_HASH_MAP_H
@@ -173,6 +173,93 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_nested_child(void *p_arg) {
+	counter[(uintptr_t)p_arg].increment();
+}
+
+static void static_nested_parent(void *p_arg) {
+	// Posted from a pool thread, so these go to its local deque and may get stolen.
+	const uint32_t base = (uintptr_t)p_arg;
+	WorkerThreadPool::TaskID children[8];
+	for (uint32_t i = 0; i < 8; i++) {
+		children[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_child, (void *)(uintptr_t)(base + i), i % 2);
+	}
+	for (uint32_t i = 0; i < 8; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(children[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int parents = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+
+		counter.clear();
+		counter.resize(parents * 8);
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		tasks.resize(parents);
+		for (int i = 0; i < parents; i++) {
+			tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_parent, (void *)(uintptr_t)(i * 8), true);
+		}
+		for (int i = 0; i < parents; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+		}
+
+		bool all_run_once = true;
+		for (int i = 0; i < parents * 8; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static void static_contention_child(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_contention_parent(void *p_arg, uint32_t p_index) {
+	const uint32_t children = (uintptr_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(children);
+	for (uint32_t i = 0; i < children; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_contention_child, nullptr, true);
+	}
+	for (uint32_t i = 0; i < children; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Contention with many small tasks" * doctest::skip()) {
+	const uint32_t parents = 1024;
+	const uint32_t children = 64;
+	const uint32_t tiny_tasks = 100000;
+
+	counter.clear();
+	counter.resize(1);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(tiny_tasks);
+	for (uint32_t i = 0; i < tiny_tasks; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)(uintptr_t)0, true);
+	}
+	for (uint32_t i = 0; i < tiny_tasks; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+	uint64_t tiny_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	counter[0].set(0);
+	begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_contention_parent, (void *)(uintptr_t)children, parents, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	uint64_t nested_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(counter[0].get() == (int)(parents * children));
+	MESSAGE("Threads: ", WorkerThreadPool::get_singleton()->get_thread_count());
+	MESSAGE(tiny_tasks, " tiny tasks from the main thread: ", tiny_usec, " usec.");
+	MESSAGE(parents, " group elements each posting ", children, " tasks: ", nested_usec, " usec.");
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -33,6 +33,7 @@
 
 #include "scene/resources/animation.h"
 
+#include "core/os/os.h"
 #include "tests/test_macros.h"
 
 namespace TestAnimation {
@@ -309,6 +310,148 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+// Position, rotation and scale tracks for every bone and a blend shape track, compressed.
+static Ref<Animation> make_compressed_animation(int p_bone_count) {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(2.0);
+	for (int i = 0; i < p_bone_count; i++) {
+		const NodePath path(vformat("Skeleton:bone_%d", i));
+		const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(position_track, path);
+		const int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(rotation_track, path);
+		const int scale_track = animation->add_track(Animation::TYPE_SCALE_3D);
+		animation->track_set_path(scale_track, path);
+		for (int j = 0; j <= 60; j++) {
+			const double time = j / 30.0;
+			animation->position_track_insert_key(position_track, time, Vector3(Math::sin(time + i), time * 0.5, Math::cos(time * 2.0)));
+			animation->rotation_track_insert_key(rotation_track, time, Quaternion::from_euler(Vector3(time, 0.3 * i, -time * 0.5)));
+			animation->scale_track_insert_key(scale_track, time, Vector3(1.0 + 0.2 * Math::sin(time * 3.0), 1.0, 1.0 + 0.1 * i));
+		}
+	}
+	const int blend_shape_track = animation->add_track(Animation::TYPE_BLEND_SHAPE);
+	animation->track_set_path(blend_shape_track, NodePath("Mesh:smile"));
+	for (int j = 0; j <= 20; j++) {
+		animation->blend_shape_track_insert_key(blend_shape_track, j * 0.1, Math::sin(j * 0.3));
+	}
+	animation->compress();
+	return animation;
+}
+
+TEST_CASE("[Animation] Sampling a compressed pose matches sampling every track") {
+	Ref<Animation> animation = make_compressed_animation(8);
+	for (int i = 0; i < animation->get_track_count(); i++) {
+		REQUIRE(animation->track_is_compressed(i));
+	}
+
+	Animation::CompressedPose pose;
+	bool values_match = true;
+	for (int frame = 0; frame <= 50; frame++) {
+		const double time = frame * 0.043;
+		REQUIRE(animation->sample_compressed_pose(time, pose));
+		CHECK(pose.tracks.size() == (uint32_t)animation->get_track_count());
+
+		for (uint32_t i = 0; i < pose.tracks.size(); i++) {
+			const int track = pose.tracks[i];
+			switch (pose.types[i]) {
+				case Animation::TYPE_POSITION_3D:
+				case Animation::TYPE_SCALE_3D: {
+					Vector3 expected;
+					if (pose.types[i] == Animation::TYPE_POSITION_3D) {
+						animation->try_position_track_interpolate(track, time, &expected);
+					} else {
+						animation->try_scale_track_interpolate(track, time, &expected);
+					}
+					values_match = values_match && (expected - Vector3(pose.x[i], pose.y[i], pose.z[i])).length() < 1e-4;
+				} break;
+				case Animation::TYPE_ROTATION_3D: {
+					Quaternion expected;
+					animation->try_rotation_track_interpolate(track, time, &expected);
+					const Quaternion sampled(pose.x[i], pose.y[i], pose.z[i], pose.w[i]);
+					values_match = values_match && sampled.is_normalized() && Math::abs(expected.dot(sampled)) > 1.0 - 1e-5;
+				} break;
+				case Animation::TYPE_BLEND_SHAPE: {
+					float expected = 0.0;
+					animation->try_blend_shape_track_interpolate(track, time, &expected);
+					values_match = values_match && Math::abs(expected - pose.x[i]) < 1e-4;
+				} break;
+				default: {
+					values_match = false;
+				} break;
+			}
+		}
+	}
+	CHECK(values_match);
+}
+
+TEST_CASE("[Animation] Compressed pose rotations with sparse keys match the rotation track") {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(2.0);
+	const int track = animation->add_track(Animation::TYPE_ROTATION_3D);
+	animation->track_set_path(track, NodePath("Skeleton:bone"));
+	// Keys far apart with large rotations between them, where a normalized linear interpolation drifts from a slerp.
+	animation->rotation_track_insert_key(track, 0.0, Quaternion());
+	animation->rotation_track_insert_key(track, 1.0, Quaternion(Vector3(0, 1, 0), Math::deg_to_rad(170.0)));
+	animation->rotation_track_insert_key(track, 2.0, Quaternion(Vector3(1, 0, 0), Math::deg_to_rad(-120.0)));
+	animation->compress();
+	REQUIRE(animation->track_is_compressed(track));
+
+	Animation::CompressedPose pose;
+	bool values_match = true;
+	for (int frame = 0; frame <= 80; frame++) {
+		const double time = frame * 0.025;
+		REQUIRE(animation->sample_compressed_pose(time, pose));
+		REQUIRE(pose.tracks.size() == 1);
+
+		Quaternion expected;
+		animation->try_rotation_track_interpolate(track, time, &expected);
+		const Quaternion sampled(pose.x[0], pose.y[0], pose.z[0], pose.w[0]);
+		values_match = values_match && sampled.is_normalized() && Math::abs(expected.dot(sampled)) > 1.0 - 1e-5;
+	}
+	CHECK(values_match);
+}
+
+TEST_CASE("[Animation][Benchmark] Sampling compressed poses" * doctest::skip()) {
+	const int bone_count = 100;
+	const int frame_count = 1000;
+	Ref<Animation> animation = make_compressed_animation(bone_count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		const double time = frame * 0.002;
+		for (int i = 0; i < animation->get_track_count(); i++) {
+			switch (animation->track_get_type(i)) {
+				case Animation::TYPE_POSITION_3D: {
+					Vector3 position;
+					animation->try_position_track_interpolate(i, time, &position);
+				} break;
+				case Animation::TYPE_ROTATION_3D: {
+					Quaternion rotation;
+					animation->try_rotation_track_interpolate(i, time, &rotation);
+				} break;
+				case Animation::TYPE_SCALE_3D: {
+					Vector3 scale;
+					animation->try_scale_track_interpolate(i, time, &scale);
+				} break;
+				default: {
+					float value;
+					animation->try_blend_shape_track_interpolate(i, time, &value);
+				} break;
+			}
+		}
+	}
+	const uint64_t per_track_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Animation::CompressedPose pose;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		animation->sample_compressed_pose(frame * 0.002, pose);
+	}
+	const uint64_t pose_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(animation->get_track_count(), " compressed tracks sampled ", frame_count, " times: per track ", per_track_usec, " usec, as a pose ", pose_usec, " usec.");
+}
+
 } // namespace TestAnimation
 
 #endif // TEST_ANIMATION_H
@@ -0,0 +1,483 @@
+/**************************************************************************/
+/*  test_animation_mixer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ANIMATION_MIXER_H
+#define TEST_ANIMATION_MIXER_H
+
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+#include "scene/3d/camera_3d.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#include "scene/animation/animation_blend_tree.h"
+#include "scene/animation/animation_player.h"
+#include "scene/animation/animation_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationMixer {
+
+// A character made of a skeleton and a mixer playing a looping animation that rotates every bone.
+// The mixer is added to the tree with the given parallel blending setting.
+static Node *make_character(int p_bone_count, bool p_use_tree, bool p_parallel_blending, Skeleton3D *&r_skeleton) {
+	Node *character = memnew(Node3D);
+	r_skeleton = memnew(Skeleton3D);
+	r_skeleton->set_name("Skeleton");
+	for (int i = 0; i < p_bone_count; i++) {
+		r_skeleton->add_bone(vformat("bone_%d", i));
+		if (i > 0) {
+			r_skeleton->set_bone_parent(i, i - 1);
+		}
+	}
+	character->add_child(r_skeleton);
+
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	animation->set_loop_mode(Animation::LOOP_LINEAR);
+	for (int i = 0; i < p_bone_count; i++) {
+		const int track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(track, NodePath(vformat("Skeleton:bone_%d", i)));
+		for (int j = 0; j <= 4; j++) {
+			animation->rotation_track_insert_key(track, j * 0.25, Quaternion(Vector3(0, 1, 0), 0.1 * (i % 7) * j));
+		}
+	}
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(position_track, NodePath("Skeleton:bone_0"));
+	animation->position_track_insert_key(position_track, 0.0, Vector3());
+	animation->position_track_insert_key(position_track, 1.0, Vector3(4, 0, 0));
+
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("move", animation);
+
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_blending", p_parallel_blending);
+	if (p_use_tree) {
+		AnimationTree *tree = memnew(AnimationTree);
+		tree->add_animation_library("", library);
+		Ref<AnimationNodeAnimation> node;
+		node.instantiate();
+		node->set_animation("move");
+		tree->set_root_animation_node(node);
+		character->add_child(tree);
+	} else {
+		AnimationPlayer *player = memnew(AnimationPlayer);
+		player->add_animation_library("", library);
+		character->add_child(player);
+	}
+	SceneTree::get_singleton()->get_root()->add_child(character);
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_blending", false);
+
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_child(1));
+	if (player) {
+		player->play("move");
+	}
+	return character;
+}
+
+static bool are_poses_equal(const Skeleton3D *p_a, const Skeleton3D *p_b) {
+	bool equal = true;
+	for (int i = 0; i < p_a->get_bone_count(); i++) {
+		equal = equal && p_a->get_bone_pose_rotation(i).is_equal_approx(p_b->get_bone_pose_rotation(i));
+		equal = equal && p_a->get_bone_pose_position(i).is_equal_approx(p_b->get_bone_pose_position(i));
+	}
+	return equal;
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Parallel blending matches serial blending") {
+	const int character_count = 6;
+
+	for (int use_tree = 0; use_tree < 2; use_tree++) {
+		LocalVector<Node *> characters;
+		LocalVector<Skeleton3D *> serial_skeletons;
+		LocalVector<Skeleton3D *> parallel_skeletons;
+		for (int i = 0; i < character_count; i++) {
+			Skeleton3D *skeleton = nullptr;
+			characters.push_back(make_character(16, use_tree, false, skeleton));
+			serial_skeletons.push_back(skeleton);
+			characters.push_back(make_character(16, use_tree, true, skeleton));
+			parallel_skeletons.push_back(skeleton);
+		}
+
+		bool poses_match = true;
+		for (int frame = 0; frame < 10; frame++) {
+			// The blended values are applied before the frame ends.
+			SceneTree::get_singleton()->process(0.07);
+			for (int i = 0; i < character_count; i++) {
+				poses_match = poses_match && are_poses_equal(serial_skeletons[i], parallel_skeletons[i]);
+			}
+		}
+		CHECK(poses_match);
+		CHECK_FALSE(parallel_skeletons[0]->get_bone_pose_position(0).is_zero_approx());
+
+		for (Node *character : characters) {
+			memdelete(character);
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Mixers in threaded process groups are blended right away") {
+	const int character_count = 4;
+
+	LocalVector<Node *> characters;
+	LocalVector<Skeleton3D *> serial_skeletons;
+	LocalVector<Skeleton3D *> threaded_skeletons;
+	for (int i = 0; i < character_count; i++) {
+		Skeleton3D *skeleton = nullptr;
+		characters.push_back(make_character(16, false, false, skeleton));
+		serial_skeletons.push_back(skeleton);
+		Node *character = make_character(16, false, true, skeleton);
+		character->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		characters.push_back(character);
+		threaded_skeletons.push_back(skeleton);
+	}
+
+	bool poses_match = true;
+	for (int frame = 0; frame < 10; frame++) {
+		SceneTree::get_singleton()->process(0.07);
+		for (int i = 0; i < character_count; i++) {
+			poses_match = poses_match && are_poses_equal(serial_skeletons[i], threaded_skeletons[i]);
+		}
+	}
+	CHECK(poses_match);
+	CHECK_FALSE(threaded_skeletons[0]->get_bone_pose_position(0).is_zero_approx());
+
+	for (Node *character : characters) {
+		memdelete(character);
+	}
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Processing a mixer again applies its queued blend") {
+	Skeleton3D *skeleton = nullptr;
+	Node *character = make_character(4, false, true, skeleton);
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_child(1));
+	REQUIRE(player);
+
+	SIGNAL_WATCH(player, "mixer_applied");
+	Array applied_twice;
+	applied_twice.push_back(Array());
+	applied_twice.push_back(Array());
+
+	// Queue a blend without letting the tree apply it, seeking applies it before its own.
+	player->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+	SIGNAL_CHECK_FALSE("mixer_applied");
+	player->seek(0.5, true);
+	SIGNAL_CHECK("mixer_applied", applied_twice);
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(2, 0, 0)));
+
+	// Only the blend queued by this frame is left for the tree to apply.
+	SceneTree::get_singleton()->process(0.0);
+	Array applied_once;
+	applied_once.push_back(Array());
+	SIGNAL_CHECK("mixer_applied", applied_once);
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(2, 0, 0)));
+
+	SIGNAL_UNWATCH(player, "mixer_applied");
+	memdelete(character);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Tracks sharing a cache are weighted once per animation") {
+	Node *character = memnew(Node);
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton");
+	skeleton->add_bone("bone");
+	character->add_child(skeleton);
+
+	// The position and rotation tracks of a bone share the same cache.
+	Ref<Animation> animation_a;
+	animation_a.instantiate();
+	int track = animation_a->add_track(Animation::TYPE_POSITION_3D);
+	animation_a->track_set_path(track, NodePath("Skeleton:bone"));
+	animation_a->position_track_insert_key(track, 0.0, Vector3(2, 0, 0));
+	track = animation_a->add_track(Animation::TYPE_ROTATION_3D);
+	animation_a->track_set_path(track, NodePath("Skeleton:bone"));
+	animation_a->rotation_track_insert_key(track, 0.0, Quaternion(Vector3(0, 1, 0), 0.5));
+
+	Ref<Animation> animation_b;
+	animation_b.instantiate();
+	track = animation_b->add_track(Animation::TYPE_POSITION_3D);
+	animation_b->track_set_path(track, NodePath("Skeleton:bone"));
+	animation_b->position_track_insert_key(track, 0.0, Vector3(4, 0, 0));
+
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("a", animation_a);
+	library->add_animation("b", animation_b);
+
+	Ref<AnimationNodeBlendTree> blend_tree;
+	blend_tree.instantiate();
+	Ref<AnimationNodeAnimation> node_a;
+	node_a.instantiate();
+	node_a->set_animation("a");
+	Ref<AnimationNodeAnimation> node_b;
+	node_b.instantiate();
+	node_b->set_animation("b");
+	Ref<AnimationNodeBlend2> blend;
+	blend.instantiate();
+	blend_tree->add_node("a", node_a);
+	blend_tree->add_node("b", node_b);
+	blend_tree->add_node("blend", blend);
+	blend_tree->connect_node("blend", 0, "a");
+	blend_tree->connect_node("blend", 1, "b");
+	blend_tree->connect_node("output", 0, "blend");
+
+	AnimationTree *tree = memnew(AnimationTree);
+	tree->add_animation_library("", library);
+	tree->set_root_animation_node(blend_tree);
+	character->add_child(tree);
+	SceneTree::get_singleton()->get_root()->add_child(character);
+
+	tree->set("parameters/blend/blend_amount", 0.5);
+	tree->advance(0.0);
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(3, 0, 0)));
+
+	memdelete(character);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Compressed animations are blended from their sampled pose") {
+	Skeleton3D *skeleton = nullptr;
+	Node *character = make_character(6, false, false, skeleton);
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_child(1));
+	REQUIRE(player);
+	Ref<Animation> animation = player->get_animation("move");
+	animation->compress();
+	REQUIRE(animation->is_compressed());
+
+	bool poses_match = true;
+	for (int frame = 0; frame < 12; frame++) {
+		SceneTree::get_singleton()->process(0.07);
+		const double time = player->get_current_animation_position();
+		for (int i = 0; i < animation->get_track_count(); i++) {
+			const int bone = skeleton->find_bone(animation->track_get_path(i).get_concatenated_subnames());
+			if (animation->track_get_type(i) == Animation::TYPE_ROTATION_3D) {
+				Quaternion expected;
+				animation->try_rotation_track_interpolate(i, time, &expected);
+				poses_match = poses_match && Math::abs(expected.dot(skeleton->get_bone_pose_rotation(bone))) > 1.0 - 1e-5;
+			} else {
+				Vector3 expected;
+				animation->try_position_track_interpolate(i, time, &expected);
+				poses_match = poses_match && (expected - skeleton->get_bone_pose_position(bone)).length() < 1e-3;
+			}
+		}
+	}
+	CHECK(poses_match);
+
+	memdelete(character);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Distant mixers are updated less often") {
+	Camera3D *camera = memnew(Camera3D);
+	SceneTree::get_singleton()->get_root()->add_child(camera);
+	camera->make_current();
+
+	Skeleton3D *skeleton = nullptr;
+	Node3D *character = Object::cast_to<Node3D>(make_character(4, false, false, skeleton));
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_child(1));
+	REQUIRE(player);
+	player->set_lod_enabled(true);
+	player->set_lod_distance(10.0);
+	player->set_lod_max_interval(4);
+	character->set_position(Vector3(0, 0, -100));
+	player->advance(0.0);
+
+	// Every 4th frame is blended, with the time elapsed since the last update.
+	// The applied pose moves a step of the interval towards it.
+	for (int frame = 0; frame < 3; frame++) {
+		SceneTree::get_singleton()->process(0.1);
+	}
+	CHECK(skeleton->get_bone_pose_position(0).is_zero_approx());
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(0.4, 0, 0)));
+
+	// Frames in between keep moving towards the last blended pose.
+	for (int frame = 0; frame < 4; frame++) {
+		SceneTree::get_singleton()->process(0.1);
+	}
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(2.0, 0, 0)));
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(2.4, 0, 0)));
+
+	memdelete(character);
+	memdelete(camera);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Seeking a distant mixer applies the exact pose") {
+	Camera3D *camera = memnew(Camera3D);
+	SceneTree::get_singleton()->get_root()->add_child(camera);
+	camera->make_current();
+
+	Skeleton3D *skeleton = nullptr;
+	Node3D *character = Object::cast_to<Node3D>(make_character(4, false, false, skeleton));
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_child(1));
+	REQUIRE(player);
+	player->set_lod_enabled(true);
+	player->set_lod_distance(10.0);
+	player->set_lod_max_interval(4);
+	player->set_lod_max_bone_depth(1);
+	character->set_position(Vector3(0, 0, -100));
+	player->advance(0.0);
+
+	for (int frame = 0; frame < 4; frame++) {
+		SceneTree::get_singleton()->process(0.1);
+	}
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(0.4, 0, 0)));
+	CHECK(skeleton->get_bone_pose_rotation(3).is_equal_approx(Quaternion()));
+
+	// Seeking between two updates isn't interpolated, and the frames after it keep the seeked pose.
+	// Bones deeper than the LOD bone depth are seeked too.
+	player->seek(0.5, true);
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(2.0, 0, 0)));
+	CHECK(skeleton->get_bone_pose_rotation(3).is_equal_approx(Quaternion(Vector3(0, 1, 0), 0.6)));
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(2.0, 0, 0)));
+
+	memdelete(character);
+	memdelete(camera);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Mixers hidden from the screen are not updated") {
+	Skeleton3D *skeleton = nullptr;
+	Node *character = make_character(4, false, false, skeleton);
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_child(1));
+	REQUIRE(player);
+
+	// Nothing is rendered by the tests, so the notifier is never on screen.
+	VisibleOnScreenNotifier3D *notifier = memnew(VisibleOnScreenNotifier3D);
+	notifier->set_name("Notifier");
+	character->add_child(notifier);
+	player->set_lod_enabled(true);
+	player->set_lod_visibility_notifier(NodePath("../Notifier"));
+	player->advance(0.0);
+
+	for (int frame = 0; frame < 6; frame++) {
+		SceneTree::get_singleton()->process(0.05);
+	}
+	CHECK(skeleton->get_bone_pose_position(0).is_zero_approx());
+
+	// The hidden time is caught up with by the next update.
+	player->set_lod_visibility_notifier(NodePath());
+	SceneTree::get_singleton()->process(0.05);
+	CHECK(skeleton->get_bone_pose_position(0).is_equal_approx(Vector3(1.4, 0, 0)));
+
+	memdelete(character);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer][Benchmark] Blending a 100 bone rig" * doctest::skip()) {
+	const int frame_count = 1000;
+	Skeleton3D *skeleton = nullptr;
+	Node *character = make_character(100, false, false, skeleton);
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_child(1));
+
+	player->advance(0.0);
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		player->advance(1.0 / 60.0);
+	}
+	// Fractions of a microsecond matter when comparing two builds.
+	const double blend_usec = double(OS::get_singleton()->get_ticks_usec() - begin) / frame_count;
+
+	const Ref<Animation> animation = player->get_animation("move");
+	MESSAGE(animation->get_track_count(), " tracks on ", skeleton->get_bone_count(), " bones: ", String::num(blend_usec, 3), " usec per blend.");
+	memdelete(character);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer][Benchmark] Parallel blending with many AnimationTrees" * doctest::skip()) {
+	const int character_counts[] = { 50, 150, 300 };
+	const int bone_count = 60;
+	const int frame_count = 60;
+
+	for (int character_count : character_counts) {
+		uint64_t frame_usec[2] = {};
+		for (int parallel = 0; parallel < 2; parallel++) {
+			LocalVector<Node *> characters;
+			for (int i = 0; i < character_count; i++) {
+				Skeleton3D *skeleton = nullptr;
+				characters.push_back(make_character(bone_count, true, parallel, skeleton));
+			}
+
+			SceneTree::get_singleton()->process(0.0);
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int frame = 0; frame < frame_count; frame++) {
+				SceneTree::get_singleton()->process(1.0 / 60.0);
+			}
+			frame_usec[parallel] = (OS::get_singleton()->get_ticks_usec() - begin) / frame_count;
+
+			for (Node *character : characters) {
+				memdelete(character);
+			}
+		}
+
+		MESSAGE(character_count, " AnimationTrees with ", bone_count, " bones: serial ", frame_usec[0], " usec, parallel ", frame_usec[1], " usec per frame.");
+	}
+}
+
+TEST_CASE("[SceneTree][AnimationMixer][Benchmark] Crowd with animation LOD" * doctest::skip()) {
+	const int character_count = 200;
+	const int bone_count = 60;
+	const int frame_count = 60;
+
+	Camera3D *camera = memnew(Camera3D);
+	SceneTree::get_singleton()->get_root()->add_child(camera);
+	camera->make_current();
+
+	uint64_t frame_usec[2] = {};
+	for (int lod = 0; lod < 2; lod++) {
+		LocalVector<Node *> characters;
+		for (int i = 0; i < character_count; i++) {
+			Skeleton3D *skeleton = nullptr;
+			Node3D *character = Object::cast_to<Node3D>(make_character(bone_count, false, false, skeleton));
+			// Spread the crowd up to 100 meters away from the camera.
+			character->set_position(Vector3(0, 0, -0.5 * i));
+			AnimationMixer *mixer = Object::cast_to<AnimationMixer>(character->get_child(1));
+			mixer->set_lod_enabled(lod);
+			mixer->set_lod_max_bone_depth(8);
+			characters.push_back(character);
+		}
+
+		SceneTree::get_singleton()->process(0.0);
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < frame_count; frame++) {
+			SceneTree::get_singleton()->process(1.0 / 60.0);
+		}
+		frame_usec[lod] = (OS::get_singleton()->get_ticks_usec() - begin) / frame_count;
+
+		for (Node *character : characters) {
+			memdelete(character);
+		}
+	}
+
+	MESSAGE(character_count, " characters with ", bone_count, " bones: ", frame_usec[0], " usec without LOD, ", frame_usec[1], " usec with LOD per frame.");
+	memdelete(camera);
+}
+
+} // namespace TestAnimationMixer
+
+#endif // TEST_ANIMATION_MIXER_H
@@ -0,0 +1,151 @@
+/**************************************************************************/
+/*  test_node_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NODE_3D_H
+#define TEST_NODE_3D_H
+
+#include "scene/3d/node_3d.h"
+
+#include "core/os/thread.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNode3D {
+
+struct GlobalPositionRead {
+	const Node3D *node = nullptr;
+	Vector3 position;
+};
+
+static void read_global_position(void *p_userdata) {
+	GlobalPositionRead *read = static_cast<GlobalPositionRead *>(p_userdata);
+	read->position = read->node->get_global_position();
+}
+
+TEST_CASE("[SceneTree][Node3D] Transform store") {
+	SceneTree *tree = SceneTree::get_singleton();
+	tree->set_use_transform_store_3d(true);
+	REQUIRE(tree->get_transform_store_3d() != nullptr);
+
+	Node3D *main = memnew(Node3D);
+	Node3D *a = memnew(Node3D);
+	Node3D *b = memnew(Node3D);
+	Node3D *top = memnew(Node3D);
+	main->set_position(Vector3(1, 0, 0));
+	a->set_position(Vector3(0, 2, 0));
+	b->set_position(Vector3(0, 0, 3));
+	top->set_as_top_level(true);
+	top->set_position(Vector3(5, 5, 5));
+	main->add_child(a);
+	a->add_child(b);
+	a->add_child(top);
+	tree->get_root()->add_child(main);
+	CHECK(tree->get_transform_store_3d()->get_node_count() == 4);
+
+	SUBCASE("Global transforms follow parents") {
+		CHECK(b->get_global_position().is_equal_approx(Vector3(1, 2, 3)));
+		CHECK(top->get_global_position().is_equal_approx(Vector3(5, 5, 5)));
+
+		main->set_position(Vector3(10, 0, 0));
+		CHECK(b->get_global_position().is_equal_approx(Vector3(10, 2, 3)));
+		CHECK(top->get_global_position().is_equal_approx(Vector3(5, 5, 5)));
+
+		// Same result through the batched update.
+		a->set_position(Vector3(0, 4, 0));
+		tree->flush_transform_notifications();
+		CHECK(b->get_global_position().is_equal_approx(Vector3(10, 4, 3)));
+		CHECK(b->get_position().is_equal_approx(Vector3(0, 0, 3)));
+	}
+
+	SUBCASE("Rotation and scale are applied") {
+		a->set_rotation(Vector3(0, Math_PI / 2, 0));
+		a->set_scale(Vector3(2, 2, 2));
+		CHECK(b->get_global_position().is_equal_approx(Vector3(7, 2, 0)));
+		CHECK(a->get_rotation().is_equal_approx(Vector3(0, Math_PI / 2, 0)));
+
+		b->set_disable_scale(true);
+		a->set_scale(Vector3(3, 3, 3));
+		CHECK(b->get_global_transform().basis.get_scale().is_equal_approx(Vector3(1, 1, 1)));
+	}
+
+	SUBCASE("Adding and removing nodes") {
+		// Added after other subtrees, so the store falls back to walking the hierarchy until it's reordered.
+		Node3D *late = memnew(Node3D);
+		Node3D *late_child = memnew(Node3D);
+		late_child->set_position(Vector3(0, 1, 0));
+		late->add_child(late_child);
+		a->add_child(late);
+		main->set_position(Vector3(0, 0, 0));
+		CHECK(late_child->get_global_position().is_equal_approx(Vector3(0, 3, 0)));
+
+		tree->flush_transform_notifications();
+		main->set_position(Vector3(0, 0, 1));
+		CHECK(late_child->get_global_position().is_equal_approx(Vector3(0, 3, 1)));
+		CHECK(b->get_global_position().is_equal_approx(Vector3(0, 2, 4)));
+
+		// Transforms are kept when leaving the tree.
+		a->remove_child(late);
+		CHECK(tree->get_transform_store_3d()->get_node_count() == 4);
+		CHECK(late_child->get_position().is_equal_approx(Vector3(0, 1, 0)));
+		main->add_child(late);
+		CHECK(late_child->get_global_position().is_equal_approx(Vector3(0, 1, 1)));
+		memdelete(late);
+	}
+
+	SUBCASE("Reading from other threads") {
+		main->set_position(Vector3(0, 0, 7));
+
+		// Other threads compute dirty transforms without writing them to the store.
+		GlobalPositionRead read;
+		read.node = b;
+		Thread thread;
+		thread.start(read_global_position, &read);
+		thread.wait_to_finish();
+		CHECK(read.position.is_equal_approx(Vector3(0, 2, 10)));
+		CHECK(b->get_global_position().is_equal_approx(Vector3(0, 2, 10)));
+	}
+
+	SUBCASE("Top level toggles") {
+		top->set_as_top_level(false);
+		CHECK(top->get_global_position().is_equal_approx(Vector3(5, 5, 5)));
+		main->set_position(Vector3(0, 0, 0));
+		CHECK(top->get_global_position().is_equal_approx(Vector3(4, 5, 5)));
+	}
+
+	memdelete(main);
+	CHECK(tree->get_transform_store_3d()->get_node_count() == 0);
+	tree->set_use_transform_store_3d(false);
+	CHECK(tree->get_transform_store_3d() == nullptr);
+}
+
+} // namespace TestNode3D
+
+#endif // TEST_NODE_3D_H
@@ -0,0 +1,181 @@
+/**************************************************************************/
+/*  test_skeleton_3d.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SKELETON_3D_H
+#define TEST_SKELETON_3D_H
+
+#include "scene/3d/skeleton_3d.h"
+
+#include "core/os/os.h"
+#include "scene/main/window.h"
+#include "tests/test_macros.h"
+
+namespace TestSkeleton3D {
+
+// A skeleton where every bone has two children, so bones aren't stored in their update order.
+static Skeleton3D *make_skeleton(int p_bone_count) {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	for (int i = 0; i < p_bone_count; i++) {
+		skeleton->add_bone(vformat("bone_%d", i));
+		skeleton->set_bone_rest(i, Transform3D(Basis(), Vector3(0, 1, 0)));
+	}
+	for (int i = p_bone_count - 1; i > 0; i--) {
+		skeleton->set_bone_parent(i, (i - 1) / 2);
+	}
+	return skeleton;
+}
+
+static void pose_skeleton(Skeleton3D *p_skeleton, real_t p_angle) {
+	for (int i = 0; i < p_skeleton->get_bone_count(); i++) {
+		p_skeleton->set_bone_pose_rotation(i, Quaternion(Vector3(0, 0, 1), p_angle * (i % 5)));
+		p_skeleton->set_bone_pose_position(i, Vector3(0, 1 + 0.1 * (i % 3), 0));
+	}
+}
+
+static Transform3D get_expected_global_pose(const Skeleton3D *p_skeleton, int p_bone) {
+	const Transform3D pose(Basis(p_skeleton->get_bone_pose_rotation(p_bone)), p_skeleton->get_bone_pose_position(p_bone));
+	const int parent = p_skeleton->get_bone_parent(p_bone);
+	return parent >= 0 ? get_expected_global_pose(p_skeleton, parent) * pose : pose;
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Dirty skeletons are updated together at the end of the frame") {
+	const int skeleton_count = 8;
+	LocalVector<Skeleton3D *> skeletons;
+	for (int i = 0; i < skeleton_count; i++) {
+		skeletons.push_back(make_skeleton(20));
+		SceneTree::get_singleton()->get_root()->add_child(skeletons[i]);
+	}
+	SceneTree::get_singleton()->process(0.0);
+
+	SIGNAL_WATCH(skeletons[0], "skeleton_updated");
+	for (int i = 0; i < skeleton_count; i++) {
+		pose_skeleton(skeletons[i], 0.1 * (i + 1));
+	}
+	SIGNAL_CHECK_FALSE("skeleton_updated");
+
+	SceneTree::get_singleton()->process(0.0);
+	Array updated_once;
+	updated_once.push_back(Array());
+	SIGNAL_CHECK("skeleton_updated", updated_once);
+
+	bool poses_match = true;
+	for (Skeleton3D *skeleton : skeletons) {
+		for (int i = 0; i < skeleton->get_bone_count(); i++) {
+			poses_match = poses_match && skeleton->get_bone_global_pose(i).is_equal_approx(get_expected_global_pose(skeleton, i));
+		}
+	}
+	CHECK(poses_match);
+
+	SIGNAL_UNWATCH(skeletons[0], "skeleton_updated");
+	for (Skeleton3D *skeleton : skeletons) {
+		memdelete(skeleton);
+	}
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Skeletons freed before the end of the frame are not updated") {
+	Skeleton3D *kept = make_skeleton(4);
+	Skeleton3D *freed = make_skeleton(4);
+	SceneTree::get_singleton()->get_root()->add_child(kept);
+	SceneTree::get_singleton()->get_root()->add_child(freed);
+	SceneTree::get_singleton()->process(0.0);
+
+	pose_skeleton(freed, 0.5);
+	pose_skeleton(kept, 0.5);
+	memdelete(freed);
+	SceneTree::get_singleton()->process(0.0);
+	CHECK(kept->get_bone_global_pose(3).is_equal_approx(get_expected_global_pose(kept, 3)));
+
+	memdelete(kept);
+}
+
+TEST_CASE("[SceneTree][Skeleton3D][Benchmark] Updating many skinned skeletons" * doctest::skip()) {
+	const int skeleton_counts[] = { 100, 500, 1000 };
+	const int bone_count = 60;
+	const int frame_count = 30;
+
+	for (int skeleton_count : skeleton_counts) {
+		LocalVector<Skeleton3D *> skeletons;
+		LocalVector<Ref<SkinReference>> skins;
+		for (int i = 0; i < skeleton_count; i++) {
+			Skeleton3D *skeleton = make_skeleton(bone_count);
+			SceneTree::get_singleton()->get_root()->add_child(skeleton);
+			skins.push_back(skeleton->register_skin(skeleton->create_skin_from_rest_transforms()));
+			skeletons.push_back(skeleton);
+		}
+		SceneTree::get_singleton()->process(0.0);
+
+		// Before batching, the global poses of every skeleton were updated one by one, breadth first from each root.
+		// It doesn't include the skins, which the batched update also computes.
+		uint64_t frame_usec[2] = {};
+		LocalVector<Transform3D> serial_poses;
+		bool poses_match = true;
+		for (int batched = 0; batched < 2; batched++) {
+			uint64_t total_usec = 0;
+			for (int frame = 0; frame < frame_count; frame++) {
+				for (int i = 0; i < skeleton_count; i++) {
+					pose_skeleton(skeletons[i], 0.01 * (frame + i));
+				}
+				const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				if (batched) {
+					SceneTree::get_singleton()->process(0.0);
+				} else {
+					for (Skeleton3D *skeleton : skeletons) {
+						for (const int root : skeleton->get_parentless_bones()) {
+							skeleton->force_update_bone_children_transforms(root);
+						}
+					}
+				}
+				total_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			}
+			frame_usec[batched] = total_usec / frame_count;
+
+			for (int i = 0; i < skeleton_count; i++) {
+				for (int j = 0; j < bone_count; j++) {
+					if (batched) {
+						poses_match = poses_match && skeletons[i]->get_bone_global_pose(j).is_equal_approx(serial_poses[i * bone_count + j]);
+					} else {
+						serial_poses.push_back(skeletons[i]->get_bone_global_pose(j));
+					}
+				}
+			}
+		}
+		CHECK(poses_match);
+
+		MESSAGE(skeleton_count, " skeletons with ", bone_count, " bones: poses one by one ", frame_usec[0], " usec, batched poses and skins ", frame_usec[1], " usec per frame.");
+		skins.clear();
+		for (Skeleton3D *skeleton : skeletons) {
+			memdelete(skeleton);
+		}
+	}
+}
+
+} // namespace TestSkeleton3D
+
+#endif // TEST_SKELETON_3D_H
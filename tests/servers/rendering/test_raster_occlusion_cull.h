@@ -0,0 +1,220 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// A square facing the camera at the given depth, split into a grid of quads.
+static void make_wall(real_t p_half_size, real_t p_z, int p_subdivisions, LocalVector<Vector3> &r_vertices, LocalVector<uint32_t> &r_indices) {
+	r_vertices.clear();
+	r_indices.clear();
+	for (int y = 0; y <= p_subdivisions; y++) {
+		for (int x = 0; x <= p_subdivisions; x++) {
+			r_vertices.push_back(Vector3(-p_half_size + 2.0 * p_half_size * x / p_subdivisions, -p_half_size + 2.0 * p_half_size * y / p_subdivisions, p_z));
+		}
+	}
+	for (int y = 0; y < p_subdivisions; y++) {
+		for (int x = 0; x < p_subdivisions; x++) {
+			const uint32_t corner = y * (p_subdivisions + 1) + x;
+			const uint32_t quad[6] = { corner, corner + 1, corner + p_subdivisions + 2, corner, corner + p_subdivisions + 2, corner + p_subdivisions + 1 };
+			for (int i = 0; i < 6; i++) {
+				r_indices.push_back(quad[i]);
+			}
+		}
+	}
+}
+
+static bool is_box_occluded(const RendererSceneOcclusionCull::HZBuffer &p_buffer, const Vector3 &p_center, real_t p_half_size, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	const real_t bounds[6] = { p_center.x - p_half_size, p_center.y - p_half_size, p_center.z - p_half_size, p_center.x + p_half_size, p_center.y + p_half_size, p_center.z + p_half_size };
+	uint64_t timeout = 0;
+	return p_buffer.is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near(), timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Boxes behind a wall are occluded") {
+	LocalVector<Vector3> vertices;
+	LocalVector<uint32_t> indices;
+	make_wall(2.0, -10.0, 1, vertices, indices);
+
+	RasterOcclusionCull::RasterHZBuffer::Mesh mesh;
+	mesh.vertices = vertices.ptr();
+	mesh.vertex_count = vertices.size();
+	mesh.indices = indices.ptr();
+	mesh.index_count = indices.size();
+
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 48));
+	const Transform3D cam_transform;
+
+	SUBCASE("Perspective") {
+		const Projection projection = Projection::create_perspective(90.0, 64.0 / 48.0, 0.1, 100.0);
+		buffer.rasterize(&mesh, 1, cam_transform, projection, false);
+		buffer.update_mips();
+
+		CHECK(is_box_occluded(buffer, Vector3(0, 0, -20), 0.5, cam_transform, projection));
+		CHECK_FALSE(is_box_occluded(buffer, Vector3(0, 0, -5), 0.5, cam_transform, projection));
+		CHECK_FALSE(is_box_occluded(buffer, Vector3(6, 0, -20), 0.5, cam_transform, projection));
+		CHECK_FALSE(is_box_occluded(buffer, Vector3(0, 0, -20), 5.0, cam_transform, projection));
+
+		// The winding of the occluder doesn't matter.
+		for (uint32_t i = 0; i < indices.size(); i += 3) {
+			SWAP(indices[i + 1], indices[i + 2]);
+		}
+		buffer.rasterize(&mesh, 1, cam_transform, projection, false);
+		buffer.update_mips();
+		CHECK(is_box_occluded(buffer, Vector3(0, 0, -20), 0.5, cam_transform, projection));
+	}
+
+	SUBCASE("Orthogonal") {
+		const Projection projection = Projection::create_orthogonal_aspect(10.0, 64.0 / 48.0, 0.1, 100.0);
+		buffer.rasterize(&mesh, 1, cam_transform, projection, true);
+		buffer.update_mips();
+
+		CHECK(is_box_occluded(buffer, Vector3(0, 0, -20), 0.5, cam_transform, projection));
+		CHECK_FALSE(is_box_occluded(buffer, Vector3(0, 0, -5), 0.5, cam_transform, projection));
+		CHECK_FALSE(is_box_occluded(buffer, Vector3(3.5, 0, -20), 0.5, cam_transform, projection));
+	}
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluders crossing the near plane are clipped") {
+	// A floor under the camera, starting behind it.
+	const Vector3 vertices[4] = { Vector3(-20, -1, 5), Vector3(20, -1, 5), Vector3(20, -1, -60), Vector3(-20, -1, -60) };
+	const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+	RasterOcclusionCull::RasterHZBuffer::Mesh mesh;
+	mesh.vertices = vertices;
+	mesh.vertex_count = 4;
+	mesh.indices = indices;
+	mesh.index_count = 6;
+
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+	const Transform3D cam_transform;
+	const Projection projection = Projection::create_perspective(90.0, 1.0, 0.1, 100.0);
+	buffer.rasterize(&mesh, 1, cam_transform, projection, false);
+	buffer.update_mips();
+
+	CHECK(is_box_occluded(buffer, Vector3(0, -4, -20), 0.5, cam_transform, projection));
+	CHECK_FALSE(is_box_occluded(buffer, Vector3(0, 1, -20), 0.5, cam_transform, projection));
+}
+
+TEST_CASE("[RasterOcclusionCull] Large occluders set up on threads match small ones") {
+	RasterOcclusionCull::RasterHZBuffer buffers[2];
+	LocalVector<Vector3> vertices[2];
+	LocalVector<uint32_t> indices[2];
+	// 2 triangles, then 3200 triangles covering the same area.
+	make_wall(3.0, -10.0, 1, vertices[0], indices[0]);
+	make_wall(3.0, -10.0, 40, vertices[1], indices[1]);
+
+	const Transform3D cam_transform(Basis(Vector3(0, 1, 0), 0.3), Vector3(1, 0.5, 0));
+	const Projection projection = Projection::create_perspective(70.0, 1.0, 0.1, 100.0);
+	for (int i = 0; i < 2; i++) {
+		RasterOcclusionCull::RasterHZBuffer::Mesh mesh;
+		mesh.vertices = vertices[i].ptr();
+		mesh.vertex_count = vertices[i].size();
+		mesh.indices = indices[i].ptr();
+		mesh.index_count = indices[i].size();
+		buffers[i].resize(Size2i(100, 100));
+		buffers[i].rasterize(&mesh, 1, cam_transform, projection, false);
+		buffers[i].update_mips();
+	}
+
+	int occluded_count = 0;
+	bool results_match = true;
+	for (int y = -10; y <= 10; y++) {
+		for (int x = -10; x <= 10; x++) {
+			const Vector3 center(x * 0.5, y * 0.5, -15);
+			const bool occluded = is_box_occluded(buffers[0], center, 0.2, cam_transform, projection);
+			occluded_count += occluded;
+			results_match = results_match && occluded == is_box_occluded(buffers[1], center, 0.2, cam_transform, projection);
+		}
+	}
+	CHECK(occluded_count > 100);
+	CHECK(occluded_count < 21 * 21);
+	CHECK(results_match);
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluder instances are culled through the scenario") {
+	RasterOcclusionCull occlusion_cull;
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID viewport = RID::from_uint64(3);
+
+	const RID occluder = occlusion_cull.occluder_allocate();
+	occlusion_cull.occluder_initialize(occluder);
+	CHECK(occlusion_cull.is_occluder(occluder));
+
+	PackedVector3Array vertices;
+	vertices.push_back(Vector3(-2, -2, 0));
+	vertices.push_back(Vector3(2, -2, 0));
+	vertices.push_back(Vector3(2, 2, 0));
+	vertices.push_back(Vector3(-2, 2, 0));
+	PackedInt32Array indices;
+	const int32_t quad[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int i = 0; i < 6; i++) {
+		indices.push_back(quad[i]);
+	}
+	occlusion_cull.occluder_set_mesh(occluder, vertices, indices);
+
+	occlusion_cull.add_scenario(scenario);
+	occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), true);
+	occlusion_cull.add_buffer(viewport);
+	occlusion_cull.buffer_set_scenario(viewport, scenario);
+	occlusion_cull.buffer_set_size(viewport, Vector2i(64, 64));
+
+	const Transform3D cam_transform;
+	const Projection projection = Projection::create_perspective(90.0, 1.0, 0.1, 100.0);
+	occlusion_cull.buffer_update(viewport, cam_transform, projection, false);
+	CHECK(is_box_occluded(*occlusion_cull.buffer_get_ptr(viewport), Vector3(0, 0, -20), 0.5, cam_transform, projection));
+
+	// Moving the instance away reveals the box.
+	occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(10, 0, -10)), true);
+	occlusion_cull.buffer_update(viewport, cam_transform, projection, false);
+	CHECK_FALSE(is_box_occluded(*occlusion_cull.buffer_get_ptr(viewport), Vector3(0, 0, -20), 0.5, cam_transform, projection));
+
+	occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), false);
+	occlusion_cull.buffer_update(viewport, cam_transform, projection, false);
+	CHECK_FALSE(is_box_occluded(*occlusion_cull.buffer_get_ptr(viewport), Vector3(0, 0, -20), 0.5, cam_transform, projection));
+
+	occlusion_cull.scenario_remove_instance(scenario, instance);
+	occlusion_cull.remove_buffer(viewport);
+	occlusion_cull.remove_scenario(scenario);
+	occlusion_cull.free_occluder(occluder);
+	CHECK_FALSE(occlusion_cull.is_occluder(occluder));
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,262 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_light_culler.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+// A scenario filled with a grid of mesh instances and some omni lights. The
+// dummy rasterizer never requests shadow updates, so the shadow passes are
+// queued directly on the scene cull.
+struct ShadowScene {
+	RID scenario;
+	RID mesh;
+	LocalVector<RID> instances;
+	LocalVector<RID> lights;
+	LocalVector<RID> light_instances;
+
+	ShadowScene(int p_instance_count, int p_light_count) {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		scenario = rs->scenario_create();
+		mesh = rs->mesh_create();
+
+		const int side = MAX(1, (int)Math::sqrt((double)p_instance_count));
+		for (int i = 0; i < p_instance_count; i++) {
+			RID instance = rs->instance_create2(mesh, scenario);
+			rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+			rs->instance_set_transform(instance, Transform3D(Basis(), Vector3((i % side) * 2.0, (i * 7 % 5) * 0.5, (i / side) * 2.0)));
+			instances.push_back(instance);
+		}
+		for (int i = 0; i < p_light_count; i++) {
+			RID light = rs->omni_light_create();
+			lights.push_back(light);
+			light_instances.push_back(rs->instance_create2(light, scenario));
+		}
+
+		RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+		scene_cull->update_dirty_instances();
+	}
+
+	~ShadowScene() {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		for (const RID &instance : instances) {
+			rs->free(instance);
+		}
+		for (uint32_t i = 0; i < lights.size(); i++) {
+			rs->free(light_instances[i]);
+			rs->free(lights[i]);
+		}
+		rs->free(mesh);
+		rs->free(scenario);
+	}
+
+	Transform3D get_light_transform(uint32_t p_light) const {
+		const real_t extent = Math::sqrt((real_t)instances.size()) * 2.0;
+		const Vector3 position((p_light * 37 % 101) / 101.0 * extent, 12, (p_light * 59 % 103) / 103.0 * extent);
+		return Transform3D().looking_at(Vector3(0, -1, 0.2), Vector3(0, 1, 0)).translated(position);
+	}
+
+	// Moves the light instances where their shadow passes look from.
+	void place_lights() {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		for (uint32_t i = 0; i < light_instances.size(); i++) {
+			rs->instance_set_transform(light_instances[i], get_light_transform(i));
+		}
+		RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+		scene_cull->update_dirty_instances();
+	}
+
+	// A spot-like shadow pass looking down on the grid.
+	void queue_shadow_pass(uint32_t p_light, int32_t p_light_culler_id) {
+		RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+		Projection projection;
+		projection.set_perspective(60, 1, 0.1, 30);
+		scene_cull->_add_shadow_cull_job(scene_cull->instance_owner.get_or_null(light_instances[p_light]), projection.get_projection_planes(get_light_transform(p_light)), p_light, p_light_culler_id);
+	}
+
+	// One shadow pass per light.
+	void queue_shadow_passes() {
+		for (uint32_t i = 0; i < light_instances.size(); i++) {
+			queue_shadow_pass(i, -1);
+		}
+	}
+
+	// Prepares the light culler for a light and stores its planes, like
+	// _light_instance_update_shadow() does.
+	int32_t store_light_culler_planes(uint32_t p_light) {
+		RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+		RendererSceneCull::Instance *light_instance = scene_cull->instance_owner.get_or_null(light_instances[p_light]);
+		scene_cull->light_culler->prepare_regular_light(*light_instance);
+		return scene_cull->_store_shadow_cull_light(static_cast<RendererSceneCull::InstanceLightData *>(light_instance->base_data));
+	}
+
+	// Culls the queued passes on the calling thread only.
+	void cull_shadow_passes_serial() {
+		RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+		RendererSceneCull::ShadowCullData cull_data;
+		cull_data.scenario = scene_cull->scenario_owner.get_or_null(scenario);
+		cull_data.visible_layers = 0xFFFFFFFF;
+		scene_cull->_shadow_cull(cull_data, scene_cull->shadow_cull_threads[0], 0, scene_cull->shadow_cull_jobs.size());
+		scene_cull->shadow_cull_threads[0].mesh_instances.clear();
+		scene_cull->shadow_cull_jobs.clear();
+	}
+
+	void cull_shadow_passes() {
+		RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+		scene_cull->_cull_shadow_casters(scene_cull->scenario_owner.get_or_null(scenario), 0xFFFFFFFF);
+	}
+
+	void take_shadow_instances(LocalVector<Vector<RenderGeometryInstance *>> &r_instances) {
+		RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+		r_instances.resize(light_instances.size());
+		for (uint32_t i = 0; i < light_instances.size(); i++) {
+			PagedArray<RenderGeometryInstance *> &shadow_instances = scene_cull->render_shadow_data[i].instances;
+			r_instances[i].clear();
+			for (uint64_t j = 0; j < shadow_instances.size(); j++) {
+				r_instances[i].push_back(shadow_instances[j]);
+			}
+			shadow_instances.clear();
+		}
+	}
+};
+
+TEST_CASE("[SceneTree][RendererSceneCull] Shadow casters culled on threads match the serial cull") {
+	ShadowScene scene(2500, 24);
+
+	LocalVector<Vector<RenderGeometryInstance *>> threaded_instances;
+	scene.queue_shadow_passes();
+	scene.cull_shadow_passes();
+	scene.take_shadow_instances(threaded_instances);
+
+	LocalVector<Vector<RenderGeometryInstance *>> serial_instances;
+	scene.queue_shadow_passes();
+	scene.cull_shadow_passes_serial();
+	scene.take_shadow_instances(serial_instances);
+
+	uint32_t total = 0;
+	bool passes_match = true;
+	for (uint32_t i = 0; i < serial_instances.size(); i++) {
+		total += serial_instances[i].size();
+		passes_match = passes_match && threaded_instances[i] == serial_instances[i];
+	}
+	CHECK(passes_match);
+	CHECK(total > 0);
+	CHECK(total < 2500 * 24);
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Stored light culler planes match culling each light on its own") {
+	ShadowScene scene(2500, 24);
+	scene.place_lights();
+
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	Projection camera_projection;
+	camera_projection.set_perspective(50, 1, 0.1, 40);
+	scene_cull->light_culler->prepare_camera(Transform3D().looking_at(Vector3(1, -1, 1), Vector3(0, 1, 0)).translated(Vector3(0, 10, 0)), camera_projection);
+
+	// Each light culled right after its planes were prepared.
+	LocalVector<Vector<RenderGeometryInstance *>> single_instances;
+	single_instances.resize(scene.light_instances.size());
+	for (uint32_t i = 0; i < scene.light_instances.size(); i++) {
+		const int32_t light_culler_id = scene.store_light_culler_planes(i);
+		CHECK(light_culler_id == 0);
+		scene.queue_shadow_pass(i, light_culler_id);
+		scene.cull_shadow_passes();
+		CHECK(scene_cull->shadow_cull_light_count == 0);
+
+		PagedArray<RenderGeometryInstance *> &shadow_instances = scene_cull->render_shadow_data[i].instances;
+		for (uint64_t j = 0; j < shadow_instances.size(); j++) {
+			single_instances[i].push_back(shadow_instances[j]);
+		}
+		shadow_instances.clear();
+	}
+
+	// Every light prepared first, then all of them culled at once with their stored planes.
+	for (uint32_t i = 0; i < scene.light_instances.size(); i++) {
+		const int32_t light_culler_id = scene.store_light_culler_planes(i);
+		CHECK(light_culler_id == int32_t(i));
+		scene.queue_shadow_pass(i, light_culler_id);
+	}
+	scene.cull_shadow_passes();
+	CHECK(scene_cull->shadow_cull_light_count == 0);
+	LocalVector<Vector<RenderGeometryInstance *>> stored_instances;
+	scene.take_shadow_instances(stored_instances);
+
+	uint32_t total = 0;
+	bool passes_match = true;
+	for (uint32_t i = 0; i < single_instances.size(); i++) {
+		total += single_instances[i].size();
+		passes_match = passes_match && stored_instances[i] == single_instances[i];
+	}
+	CHECK(passes_match);
+	CHECK(total > 0);
+
+	// Lights that never queue a pass don't leave their ids behind.
+	scene.store_light_culler_planes(0);
+	scene.cull_shadow_passes();
+	CHECK(scene_cull->shadow_cull_light_count == 0);
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull][Benchmark] Shadow caster cull time versus instance and light count" * doctest::skip()) {
+	const int instance_counts[] = { 1000, 10000, 50000 };
+	const int light_counts[] = { 8, 40, 160 };
+
+	for (int instance_count : instance_counts) {
+		for (int light_count : light_counts) {
+			ShadowScene scene(instance_count, light_count);
+			LocalVector<Vector<RenderGeometryInstance *>> instances;
+
+			scene.queue_shadow_passes();
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			scene.cull_shadow_passes_serial();
+			const uint64_t serial_time = OS::get_singleton()->get_ticks_usec() - begin;
+			scene.take_shadow_instances(instances);
+
+			scene.queue_shadow_passes();
+			begin = OS::get_singleton()->get_ticks_usec();
+			scene.cull_shadow_passes();
+			const uint64_t threaded_time = OS::get_singleton()->get_ticks_usec() - begin;
+			scene.take_shadow_instances(instances);
+
+			MESSAGE(instance_count, " instances, ", light_count, " lights: serial ", serial_time, " usec, threaded ", threaded_time, " usec.");
+		}
+	}
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
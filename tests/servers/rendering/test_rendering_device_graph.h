@@ -0,0 +1,250 @@
+/**************************************************************************/
+/*  test_rendering_device_graph.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_DEVICE_GRAPH_H
+#define TEST_RENDERING_DEVICE_GRAPH_H
+
+#include "servers/rendering/rendering_device_graph.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "tests/servers/rendering/rendering_device_driver_mock.h"
+#include "tests/test_macros.h"
+
+namespace TestRenderingDeviceGraph {
+
+// A buffer command recorded into the graph. Every command is tagged with its index in the
+// destination offset, so it can be found again in the stream emitted to the driver.
+struct BufferCommand {
+	int32_t src = -1;
+	int32_t dst = -1;
+};
+
+class GraphHarness {
+public:
+	RenderingDeviceDriverMock driver;
+	RenderingDeviceGraph graph;
+	LocalVector<RDD::BufferID> buffers;
+	LocalVector<RDG::ResourceTracker *> trackers;
+
+	void record(const BufferCommand &p_command, uint32_t p_index) {
+		if (p_command.src >= 0) {
+			RDD::BufferCopyRegion region;
+			region.dst_offset = p_index;
+			region.size = 1;
+			graph.add_buffer_copy(buffers[p_command.src], trackers[p_command.src], buffers[p_command.dst], trackers[p_command.dst], region);
+		} else {
+			graph.add_buffer_clear(buffers[p_command.dst], trackers[p_command.dst], p_index, 1);
+		}
+	}
+
+	void end(bool p_reorder_commands) {
+		driver.calls.clear();
+		RDD::CommandBufferID command_buffer(1);
+		RDG::CommandBufferPool command_buffer_pool;
+		graph.end(p_reorder_commands, false, command_buffer, command_buffer_pool);
+	}
+
+	GraphHarness(uint32_t p_buffer_count) {
+		graph.initialize(&driver, RenderingContextDriver::Device(), 1, RDD::CommandQueueFamilyID(), 0);
+		for (uint32_t i = 0; i < p_buffer_count; i++) {
+			buffers.push_back(driver.buffer_create(1024, RDD::BUFFER_USAGE_TRANSFER_TO_BIT, RDD::MEMORY_ALLOCATION_TYPE_GPU));
+			trackers.push_back(RDG::resource_tracker_create());
+			trackers[i]->buffer_driver_id = buffers[i];
+		}
+	}
+
+	~GraphHarness() {
+		for (RDG::ResourceTracker *tracker : trackers) {
+			RDG::resource_tracker_free(tracker);
+		}
+		graph.finalize();
+	}
+};
+
+static void make_random_commands(uint32_t p_command_count, uint32_t p_buffer_count, uint64_t p_seed, LocalVector<BufferCommand> &r_commands) {
+	RandomPCG rng(p_seed);
+	r_commands.resize(p_command_count);
+	for (BufferCommand &command : r_commands) {
+		command.dst = rng.rand(p_buffer_count);
+		command.src = -1;
+		if (rng.rand(2) == 0) {
+			command.src = (command.dst + 1 + rng.rand(p_buffer_count - 1)) % p_buffer_count;
+		}
+	}
+}
+
+// Checks every pair of commands that touch the same buffer and write to it at least once are
+// emitted in the order they were recorded in. Commands that write to a buffer after it was
+// used must also be separated from the previous command by a barrier.
+static bool is_emitted_stream_valid(const LocalVector<BufferCommand> &p_commands, const LocalVector<RenderingDeviceDriverMock::Call> &p_calls, uint32_t &r_barrier_count) {
+	LocalVector<int32_t> positions;
+	LocalVector<uint32_t> barriers_before;
+	positions.resize(p_commands.size());
+	barriers_before.resize(p_commands.size());
+	for (uint32_t i = 0; i < p_commands.size(); i++) {
+		positions[i] = -1;
+	}
+
+	r_barrier_count = 0;
+	for (uint32_t i = 0; i < p_calls.size(); i++) {
+		const RenderingDeviceDriverMock::Call &call = p_calls[i];
+		if (call.type == RenderingDeviceDriverMock::CALL_PIPELINE_BARRIER) {
+			r_barrier_count++;
+			continue;
+		}
+
+		const uint64_t command_index = call.dst_offset;
+		if (command_index >= p_commands.size() || positions[command_index] >= 0) {
+			// Unknown or duplicated command.
+			return false;
+		}
+		positions[command_index] = i;
+		barriers_before[command_index] = r_barrier_count;
+	}
+
+	for (uint32_t i = 0; i < p_commands.size(); i++) {
+		if (positions[i] < 0) {
+			// Missing command.
+			return false;
+		}
+	}
+
+	for (uint32_t j = 0; j < p_commands.size(); j++) {
+		for (uint32_t i = 0; i < j; i++) {
+			const BufferCommand &a = p_commands[i];
+			const BufferCommand &b = p_commands[j];
+			const bool write_after_use = a.dst == b.dst || a.src == b.dst;
+			const bool read_after_write = a.dst == b.src;
+			if ((write_after_use || read_after_write) && positions[i] > positions[j]) {
+				return false;
+			}
+			if (write_after_use && barriers_before[i] == barriers_before[j]) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+TEST_CASE("[RenderingDeviceGraph] Reordering keeps dependent buffer commands in order") {
+	const uint32_t buffer_count = 8;
+	LocalVector<BufferCommand> commands;
+	make_random_commands(400, buffer_count, 1234, commands);
+
+	GraphHarness harness(buffer_count);
+	uint32_t barrier_counts[2] = {};
+	for (int reorder = 0; reorder < 2; reorder++) {
+		harness.graph.begin();
+		for (uint32_t i = 0; i < commands.size(); i++) {
+			harness.record(commands[i], i);
+		}
+		harness.end(reorder);
+		CHECK(is_emitted_stream_valid(commands, harness.driver.calls, barrier_counts[reorder]));
+	}
+
+	// Grouping commands into levels never needs more barriers than recording order.
+	CHECK(barrier_counts[1] <= barrier_counts[0]);
+}
+
+TEST_CASE("[RenderingDeviceGraph] Independent commands share a barrier") {
+	GraphHarness harness(16);
+	harness.graph.begin();
+
+	LocalVector<BufferCommand> commands;
+	for (int32_t i = 0; i < 16; i++) {
+		BufferCommand command;
+		command.dst = i;
+		commands.push_back(command);
+	}
+	for (int32_t i = 0; i < 8; i++) {
+		BufferCommand command;
+		command.src = i;
+		command.dst = i + 8;
+		commands.push_back(command);
+	}
+
+	// Interleave the clears and copies, reordering should still batch them into two levels.
+	const uint32_t recording_order[24] = { 0, 8, 16, 1, 9, 17, 2, 10, 18, 3, 11, 19, 4, 12, 20, 5, 13, 21, 6, 14, 22, 7, 15, 23 };
+	for (uint32_t i = 0; i < 24; i++) {
+		harness.record(commands[recording_order[i]], recording_order[i]);
+	}
+	harness.end(true);
+
+	const LocalVector<RenderingDeviceDriverMock::Call> &calls = harness.driver.calls;
+	REQUIRE(calls.size() == 26);
+	CHECK(calls[0].type == RenderingDeviceDriverMock::CALL_PIPELINE_BARRIER);
+	CHECK(calls[17].type == RenderingDeviceDriverMock::CALL_PIPELINE_BARRIER);
+
+	bool clears_first = true;
+	for (uint32_t i = 1; i < 17; i++) {
+		clears_first = clears_first && calls[i].type == RenderingDeviceDriverMock::CALL_CLEAR_BUFFER;
+	}
+	CHECK(clears_first);
+
+	bool copies_last = true;
+	for (uint32_t i = 18; i < 26; i++) {
+		copies_last = copies_last && calls[i].type == RenderingDeviceDriverMock::CALL_COPY_BUFFER;
+	}
+	CHECK(copies_last);
+}
+
+TEST_CASE("[RenderingDeviceGraph][Benchmark] Record and reorder large command streams" * doctest::skip()) {
+	const uint32_t buffer_count = 256;
+	const uint32_t command_counts[3] = { 10000, 50000, 100000 };
+	for (uint32_t command_count : command_counts) {
+		LocalVector<BufferCommand> commands;
+		make_random_commands(command_count, buffer_count, command_count, commands);
+
+		GraphHarness harness(buffer_count);
+		uint64_t record_usec = 0;
+		uint64_t end_usec = 0;
+		const int iterations = 10;
+		for (int i = 0; i < iterations; i++) {
+			uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			harness.graph.begin();
+			for (uint32_t j = 0; j < command_count; j++) {
+				harness.record(commands[j], j);
+			}
+			record_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+			begin_usec = OS::get_singleton()->get_ticks_usec();
+			harness.end(true);
+			end_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+		}
+
+		MESSAGE(command_count, " commands: recording ", record_usec / iterations, " usec, reordering and submitting ", end_usec / iterations, " usec, ", harness.driver.calls.size(), " driver calls.");
+	}
+}
+
+} // namespace TestRenderingDeviceGraph
+
+#endif // TEST_RENDERING_DEVICE_GRAPH_H
@@ -31,6 +31,8 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -749,6 +751,67 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same results as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(-4.5 + i * 0.5, 0, -4));
+				query_parameters->set_target_position(Vector3(4, 0, 4.5 - i * 0.5));
+				query_parameters->set_path_postprocessing(i % 2 ? NavigationPathQueryParameters3D::PATH_POSTPROCESSING_EDGECENTERED : NavigationPathQueryParameters3D::PATH_POSTPROCESSING_CORRIDORFUNNEL);
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+
+			CallableMock callback_mock;
+			const int64_t batch_id = navigation_server->query_path_batch(batch_parameters, batch_results, callable_mp(&callback_mock, &CallableMock::function1).bind(42));
+			CHECK_GT(batch_id, 0);
+			navigation_server->wait_for_path_query_batch_completion(batch_id);
+			CHECK(navigation_server->is_path_query_batch_completed(batch_id));
+
+			bool all_match = true;
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> single_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(batch_parameters[i], single_result);
+				const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				all_match = all_match && single_result->get_path().size() > 0;
+				all_match = all_match && batch_result->get_path() == single_result->get_path();
+				all_match = all_match && batch_result->get_path_types() == single_result->get_path_types();
+				all_match = all_match && batch_result->get_path_owner_ids() == single_result->get_path_owner_ids();
+			}
+			CHECK(all_match);
+
+			// The callback is deferred to the main thread.
+			CHECK_EQ(callback_mock.function1_calls, 0);
+			MessageQueue::get_singleton()->flush();
+			CHECK_EQ(callback_mock.function1_calls, 1);
+			CHECK_EQ(callback_mock.function1_latest_arg0, Variant(42));
+		}
+
+		SUBCASE("Batched queries should be pollable") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(0, 0, 0));
+			query_parameters->set_target_position(Vector3(4, 0, 4));
+			batch_parameters.push_back(query_parameters);
+			batch_results.push_back(memnew(NavigationPathQueryResult3D));
+
+			const int64_t batch_id = navigation_server->query_path_batch(batch_parameters, batch_results);
+			while (!navigation_server->is_path_query_batch_completed(batch_id)) {
+				OS::get_singleton()->delay_usec(100);
+			}
+			CHECK_NE(Ref<NavigationPathQueryResult3D>(batch_results[0])->get_path().size(), 0);
+
+			// Mismatched arrays are rejected.
+			batch_results.clear();
+			ERR_PRINT_OFF;
+			CHECK_EQ(navigation_server->query_path_batch(batch_parameters, batch_results), -1);
+			ERR_PRINT_ON;
+		}
+
 		SUBCASE("Elaborate query without metadata flags should yield path only") {
 			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
 			query_parameters->set_map(map);
@@ -768,6 +831,68 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D][Benchmark] Batched path query throughput" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A grid of quads gives the search a lot of polygons to visit.
+		const int grid_size = 64;
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				const int corner = z * (grid_size + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(corner);
+				polygon.push_back(corner + 1);
+				polygon.push_back(corner + grid_size + 2);
+				polygon.push_back(corner + grid_size + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const int query_count = 1024;
+		TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+		TypedArray<NavigationPathQueryResult3D> batch_results;
+		for (int i = 0; i < query_count; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(0.5 + (i % grid_size), 0, 0.5));
+			query_parameters->set_target_position(Vector3(grid_size - 0.5, 0, grid_size - 0.5 - (i % grid_size)));
+			batch_parameters.push_back(query_parameters);
+			batch_results.push_back(memnew(NavigationPathQueryResult3D));
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			navigation_server->query_path(batch_parameters[i], batch_results[i]);
+		}
+		const uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->wait_for_path_query_batch_completion(navigation_server->query_path_batch(batch_parameters, batch_results));
+		const uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(query_count, " queries: single ", single_usec, " usec, batched ", batch_usec, " usec.");
+		CHECK_NE(Ref<NavigationPathQueryResult3D>(batch_results[query_count - 1])->get_path().size(), 0);
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -0,0 +1,229 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/math/random_number_generator.h"
+#include "servers/physics_2d/godot_physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+TEST_CASE("[PhysicsServer2D] Batched ray queries match single ray queries") {
+	GodotPhysicsServer2D *server = memnew(GodotPhysicsServer2D);
+	server->init();
+
+	LocalVector<RID> rids;
+	RID space = server->space_create();
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(0.5, 0.5));
+	rids.push_back(space);
+	rids.push_back(box_shape);
+
+	// A grid of static boxes with gaps between them.
+	LocalVector<RID> bodies;
+	for (int y = 0; y < 8; y++) {
+		for (int x = 0; x < 8; x++) {
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+			server->body_add_shape(body, box_shape);
+			server->body_set_space(body, space);
+			server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(x * 2 - 8, y * 2 - 8)));
+			bodies.push_back(body);
+		}
+	}
+
+	// Applies the pending shape updates.
+	server->step(0.0);
+	PhysicsDirectSpaceState2D *direct_state = server->space_get_direct_state(space);
+	REQUIRE(direct_state);
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(23);
+
+	// Enough rays to go through the worker threads, some of them missing every box.
+	const int count = 1000;
+	LocalVector<Vector2> origins;
+	LocalVector<Vector2> motions;
+	for (int i = 0; i < count; i++) {
+		origins.push_back(Vector2(rng->randf_range(-10, 10), rng->randf_range(-10, 10)));
+		motions.push_back(Vector2(rng->randf_range(-4, 4), rng->randf_range(-4, 4)));
+	}
+	// Rays of one packet spread over the whole grid.
+	origins[0] = Vector2(-12, -12);
+	motions[0] = Vector2(24, 24);
+
+	PhysicsDirectSpaceState2D::RayParameters parameters;
+	parameters.exclude.insert(bodies[0]);
+	LocalVector<PhysicsDirectSpaceState2D::RayResult> results;
+	LocalVector<bool> hits;
+	results.resize(count);
+	hits.resize(count);
+	direct_state->intersect_rays(parameters, origins.ptr(), motions.ptr(), count, results.ptr(), hits.ptr());
+
+	int hit_count = 0;
+	bool results_match = true;
+	for (int i = 0; i < count; i++) {
+		parameters.from = origins[i];
+		parameters.to = origins[i] + motions[i];
+		PhysicsDirectSpaceState2D::RayResult result;
+		const bool hit = direct_state->intersect_ray(parameters, result);
+		results_match = results_match && hit == hits[i];
+		if (hit && hits[i]) {
+			hit_count++;
+			results_match = results_match && result.position == results[i].position && result.normal == results[i].normal && result.rid == results[i].rid && result.shape == results[i].shape;
+		}
+	}
+	CHECK(hits[0]);
+	CHECK(results[0].rid != bodies[0]);
+	CHECK(hit_count > count / 4);
+	CHECK(hit_count < count);
+	CHECK(results_match);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	for (int64_t i = rids.size() - 1; i >= 0; i--) {
+		server->free(rids[i]);
+	}
+	server->finish();
+	memdelete(server);
+}
+
+TEST_CASE("[PhysicsServer2D] Batched shape queries match single shape queries") {
+	GodotPhysicsServer2D *server = memnew(GodotPhysicsServer2D);
+	server->init();
+
+	LocalVector<RID> rids;
+	RID space = server->space_create();
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(0.5, 0.5));
+	RID circle_shape = server->circle_shape_create();
+	server->shape_set_data(circle_shape, 0.4);
+	rids.push_back(space);
+	rids.push_back(box_shape);
+	rids.push_back(circle_shape);
+
+	// A grid of static boxes with gaps between them.
+	LocalVector<RID> bodies;
+	for (int y = 0; y < 8; y++) {
+		for (int x = 0; x < 8; x++) {
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+			server->body_add_shape(body, box_shape);
+			server->body_set_space(body, space);
+			server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(x * 2 - 8, y * 2 - 8)));
+			bodies.push_back(body);
+		}
+	}
+
+	// Applies the pending shape updates.
+	server->step(0.0);
+	PhysicsDirectSpaceState2D *direct_state = server->space_get_direct_state(space);
+	REQUIRE(direct_state);
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(29);
+
+	// Enough queries to go through the worker threads, some of them missing every box.
+	const int count = 200;
+	LocalVector<Transform2D> transforms;
+	LocalVector<Vector2> motions;
+	for (int i = 0; i < count; i++) {
+		transforms.push_back(Transform2D(0.0, Vector2(rng->randf_range(-10, 10), rng->randf_range(-10, 10))));
+		motions.push_back(Vector2(rng->randf_range(-4, 4), rng->randf_range(-4, 4)));
+	}
+
+	PhysicsDirectSpaceState2D::ShapeParameters parameters;
+	parameters.shape_rid = circle_shape;
+	parameters.exclude.insert(bodies[0]);
+
+	const int result_max = 8;
+	LocalVector<PhysicsDirectSpaceState2D::ShapeResult> results;
+	LocalVector<int> result_counts;
+	results.resize(count * result_max);
+	result_counts.resize(count);
+	direct_state->intersect_shapes(parameters, transforms.ptr(), count, results.ptr(), result_max, result_counts.ptr());
+
+	int hit_count = 0;
+	bool results_match = true;
+	for (int i = 0; i < count; i++) {
+		parameters.transform = transforms[i];
+		PhysicsDirectSpaceState2D::ShapeResult single_results[result_max];
+		const int single_count = direct_state->intersect_shape(parameters, single_results, result_max);
+		results_match = results_match && single_count == result_counts[i];
+		for (int j = 0; j < MIN(single_count, result_counts[i]); j++) {
+			const PhysicsDirectSpaceState2D::ShapeResult &result = results[i * result_max + j];
+			results_match = results_match && single_results[j].rid == result.rid && single_results[j].shape == result.shape;
+		}
+		hit_count += single_count > 0 ? 1 : 0;
+	}
+	CHECK(hit_count > 0);
+	CHECK(hit_count < count);
+	CHECK(results_match);
+
+	LocalVector<real_t> closest_safe;
+	LocalVector<real_t> closest_unsafe;
+	closest_safe.resize(count);
+	closest_unsafe.resize(count);
+	direct_state->cast_motions(parameters, transforms.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+	int blocked_count = 0;
+	bool motions_match = true;
+	for (int i = 0; i < count; i++) {
+		parameters.transform = transforms[i];
+		parameters.motion = motions[i];
+		real_t safe = 1.0;
+		real_t unsafe = 1.0;
+		direct_state->cast_motion(parameters, safe, unsafe);
+		motions_match = motions_match && safe == closest_safe[i] && unsafe == closest_unsafe[i];
+		blocked_count += safe < 1.0 ? 1 : 0;
+	}
+	CHECK(blocked_count > 0);
+	CHECK(blocked_count < count);
+	CHECK(motions_match);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	for (int64_t i = rids.size() - 1; i >= 0; i--) {
+		server->free(rids[i]);
+	}
+	server->finish();
+	memdelete(server);
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
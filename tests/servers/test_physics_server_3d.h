@@ -0,0 +1,543 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/math/random_number_generator.h"
+#include "core/math/simd_batch.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/godot_body_pair_3d.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+#include "servers/physics_3d/godot_space_3d.h"
+#include "servers/physics_3d/godot_step_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// Boxes stacked in columns on a floor and touching their neighbors, so they
+// all end up in a single island. The space isn't active, so the server only
+// updates its shapes and it can be stepped by a custom GodotStep3D.
+static GodotSpace3D *create_box_pile(PhysicsServer3D *p_server, int p_side, int p_height, LocalVector<RID> &r_rids, LocalVector<RID> &r_bodies) {
+	RID space = p_server->space_create();
+	RID floor_shape = p_server->box_shape_create();
+	p_server->shape_set_data(floor_shape, Vector3(p_side, 0.5, p_side));
+	RID box_shape = p_server->box_shape_create();
+	p_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	r_rids.push_back(space);
+	r_rids.push_back(floor_shape);
+	r_rids.push_back(box_shape);
+
+	RID floor = p_server->body_create();
+	p_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_add_shape(floor, floor_shape);
+	p_server->body_set_space(floor, space);
+	p_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+	r_rids.push_back(floor);
+
+	for (int y = 0; y < p_height; y++) {
+		for (int z = 0; z < p_side; z++) {
+			for (int x = 0; x < p_side; x++) {
+				RID body = p_server->body_create();
+				p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+				p_server->body_add_shape(body, box_shape);
+				p_server->body_set_space(body, space);
+				p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x - p_side * 0.5, y + 0.5, z - p_side * 0.5)));
+				r_bodies.push_back(body);
+			}
+		}
+	}
+
+	// Applies the pending shape updates.
+	p_server->step(0.0);
+
+	GodotPhysicsDirectSpaceState3D *direct_state = Object::cast_to<GodotPhysicsDirectSpaceState3D>(p_server->space_get_direct_state(space));
+	return direct_state ? direct_state->space : nullptr;
+}
+
+static void free_box_pile(PhysicsServer3D *p_server, LocalVector<RID> &r_rids, LocalVector<RID> &r_bodies) {
+	for (const RID &body : r_bodies) {
+		p_server->free(body);
+	}
+	for (int64_t i = r_rids.size() - 1; i >= 0; i--) {
+		p_server->free(r_rids[i]);
+	}
+	r_rids.clear();
+	r_bodies.clear();
+}
+
+static void simulate_box_pile(PhysicsServer3D *p_server, GodotStep3D &p_stepper, int p_steps, LocalVector<Transform3D> &r_transforms) {
+	LocalVector<RID> rids;
+	LocalVector<RID> bodies;
+	GodotSpace3D *space = create_box_pile(p_server, 8, 4, rids, bodies);
+	REQUIRE(space);
+
+	for (int i = 0; i < p_steps; i++) {
+		p_stepper.step(space, 1.0 / 60.0);
+	}
+	CHECK(space->get_island_count() == 1);
+
+	r_transforms.clear();
+	for (const RID &body : bodies) {
+		r_transforms.push_back(p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+	}
+	free_box_pile(p_server, rids, bodies);
+}
+
+TEST_CASE("[PhysicsServer3D] Parallel island solving is deterministic") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+
+	GodotStep3D stepper;
+	stepper.set_parallel_island_solving(true);
+
+	LocalVector<Transform3D> single_task_transforms;
+	stepper.set_parallel_solver_task_count(1);
+	simulate_box_pile(server, stepper, 30, single_task_transforms);
+
+	LocalVector<Transform3D> transforms;
+	stepper.set_parallel_solver_task_count(-1);
+	simulate_box_pile(server, stepper, 30, transforms);
+
+	REQUIRE(transforms.size() == single_task_transforms.size());
+	bool transforms_match = true;
+	bool pile_stands = true;
+	for (uint32_t i = 0; i < transforms.size(); i++) {
+		transforms_match = transforms_match && transforms[i] == single_task_transforms[i];
+		pile_stands = pile_stands && transforms[i].origin.y > 0.25;
+	}
+	CHECK(transforms_match);
+	CHECK(pile_stands);
+
+	server->finish();
+	memdelete(server);
+}
+
+TEST_CASE("[PhysicsServer3D] Resting contacts are reused without destabilizing the pile") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+
+	GodotStep3D stepper;
+	LocalVector<Transform3D> transforms[2];
+	for (int pass = 0; pass < 2; pass++) {
+		LocalVector<RID> rids;
+		LocalVector<RID> bodies;
+		GodotSpace3D *space = create_box_pile(server, 4, 4, rids, bodies);
+		REQUIRE(space);
+		// A zero recycle radius recomputes every contact on each step.
+		if (pass == 1) {
+			space->set_param(PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS, 0.0);
+		}
+
+		for (int i = 0; i < 120; i++) {
+			stepper.step(space, 1.0 / 60.0);
+		}
+		for (const RID &body : bodies) {
+			transforms[pass].push_back(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		}
+		free_box_pile(server, rids, bodies);
+	}
+
+	REQUIRE(transforms[0].size() == transforms[1].size());
+	bool pile_stands = true;
+	bool transforms_match = true;
+	for (uint32_t i = 0; i < transforms[0].size(); i++) {
+		pile_stands = pile_stands && transforms[0][i].origin.y > 0.25;
+		transforms_match = transforms_match && transforms[0][i].origin.distance_to(transforms[1][i].origin) < 0.05;
+	}
+	CHECK(pile_stands);
+	CHECK(transforms_match);
+
+	server->finish();
+	memdelete(server);
+}
+
+// Counts the body pairs of the active bodies, and how many of them kept
+// their contacts on the last step.
+static void count_reused_contacts(GodotSpace3D *p_space, int &r_pairs, int &r_reused) {
+	HashSet<GodotBodyPair3D *> pairs;
+	for (const SelfList<GodotBody3D> *E = p_space->get_active_body_list().first(); E; E = E->next()) {
+		for (const KeyValue<GodotConstraint3D *, int> &constraint : E->self()->get_constraint_map()) {
+			// The pile has no joints, every constraint between two bodies is a body pair.
+			if (constraint.key->get_body_count() == 2) {
+				pairs.insert(static_cast<GodotBodyPair3D *>(constraint.key));
+			}
+		}
+	}
+	r_pairs = pairs.size();
+	r_reused = 0;
+	for (const GodotBodyPair3D *pair : pairs) {
+		r_reused += pair->are_contacts_reused() ? 1 : 0;
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] Resting contacts skip the narrow phase until the shapes change") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+
+	LocalVector<RID> rids;
+	LocalVector<RID> bodies;
+	GodotSpace3D *space = create_box_pile(server, 2, 2, rids, bodies);
+	REQUIRE(space);
+	for (const RID &body : bodies) {
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+	}
+
+	GodotStep3D stepper;
+	for (int i = 0; i < 60; i++) {
+		stepper.step(space, 1.0 / 60.0);
+	}
+	int pairs = 0;
+	int reused = 0;
+	count_reused_contacts(space, pairs, reused);
+	REQUIRE(pairs > 0);
+	CHECK(reused > 0);
+
+	// Setting the shape data bumps the shape version, even with the same size.
+	const RID box_shape = rids[2];
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	stepper.step(space, 1.0 / 60.0);
+	count_reused_contacts(space, pairs, reused);
+	REQUIRE(pairs > 0);
+	CHECK(reused == 0);
+
+	// A zero recycle radius recomputes every contact on each step.
+	space->set_param(PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS, 0.0);
+	for (int i = 0; i < 10; i++) {
+		stepper.step(space, 1.0 / 60.0);
+	}
+	count_reused_contacts(space, pairs, reused);
+	REQUIRE(pairs > 0);
+	CHECK(reused == 0);
+
+	free_box_pile(server, rids, bodies);
+	server->finish();
+	memdelete(server);
+}
+
+struct NarrowPhaseResult {
+	bool collided = false;
+	Vector3 separation_axis;
+	LocalVector<Vector3> contacts;
+
+	bool operator==(const NarrowPhaseResult &p_other) const {
+		if (collided != p_other.collided || separation_axis != p_other.separation_axis || contacts.size() != p_other.contacts.size()) {
+			return false;
+		}
+		for (uint32_t i = 0; i < contacts.size(); i++) {
+			if (contacts[i] != p_other.contacts[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+static void collect_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+	NarrowPhaseResult *result = static_cast<NarrowPhaseResult *>(p_userdata);
+	result->contacts.push_back(p_point_A);
+	result->contacts.push_back(p_point_B);
+}
+
+static NarrowPhaseResult solve_pair(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, real_t p_margin) {
+	NarrowPhaseResult result;
+	result.collided = GodotCollisionSolver3D::solve_static(p_shape_A, p_transform_A, p_shape_B, p_transform_B, collect_contact, &result, &result.separation_axis, p_margin, p_margin);
+	if (!result.collided) {
+		// Distances go through GJK, which relies on the shape supports.
+		Vector3 point_A;
+		Vector3 point_B;
+		if (GodotCollisionSolver3D::solve_distance(p_shape_A, p_transform_A, p_shape_B, p_transform_B, point_A, point_B, AABB())) {
+			result.contacts.push_back(point_A);
+			result.contacts.push_back(point_B);
+		}
+	}
+	return result;
+}
+
+static Vector<Vector3> random_hull_points(Ref<RandomNumberGenerator> &p_rng, int p_count) {
+	Vector<Vector3> points;
+	for (int i = 0; i < p_count; i++) {
+		points.push_back(Vector3(p_rng->randf_range(-1.0, 1.0), p_rng->randf_range(-1.0, 1.0), p_rng->randf_range(-1.0, 1.0)));
+	}
+	return points;
+}
+
+TEST_CASE("[PhysicsServer3D] SIMD narrow phase matches the scalar path") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1234);
+
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(0.5, 0.75, 1.0));
+	GodotCapsuleShape3D *capsule = memnew(GodotCapsuleShape3D);
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.4;
+	capsule_data["height"] = 1.6;
+	capsule->set_data(capsule_data);
+	// A small hull where every vertex is extreme, and a large one where
+	// supports are found by walking the surface.
+	GodotConvexPolygonShape3D *small_hull = memnew(GodotConvexPolygonShape3D);
+	small_hull->set_data(random_hull_points(rng, 12));
+	GodotConvexPolygonShape3D *large_hull = memnew(GodotConvexPolygonShape3D);
+	large_hull->set_data(random_hull_points(rng, 300));
+
+	const GodotShape3D *pairs[][2] = {
+		{ box, box },
+		{ box, capsule },
+		{ capsule, box },
+		{ small_hull, small_hull },
+		{ small_hull, large_hull },
+		{ large_hull, large_hull },
+		{ box, small_hull },
+		{ large_hull, box },
+	};
+
+	const int pair_count = sizeof(pairs) / sizeof(pairs[0]);
+
+	const SIMDBatch::Level default_level = SIMDBatch::get_level();
+	int collision_count = 0;
+	int mismatch_count = 0;
+	for (int i = 0; i < 2000; i++) {
+		const GodotShape3D *shape_A = pairs[i % pair_count][0];
+		const GodotShape3D *shape_B = pairs[i % pair_count][1];
+		const Transform3D transform_A(Basis::from_euler(Vector3(rng->randf_range(-Math_PI, Math_PI), rng->randf_range(-Math_PI, Math_PI), rng->randf_range(-Math_PI, Math_PI))), Vector3());
+		const Transform3D transform_B(Basis::from_euler(Vector3(rng->randf_range(-Math_PI, Math_PI), rng->randf_range(-Math_PI, Math_PI), rng->randf_range(-Math_PI, Math_PI))), Vector3(rng->randf_range(-2.5, 2.5), rng->randf_range(-2.5, 2.5), rng->randf_range(-2.5, 2.5)));
+		const real_t margin = (i / pair_count) % 2 ? 0.04 : 0.0;
+
+		SIMDBatch::set_level(SIMDBatch::LEVEL_SCALAR);
+		const NarrowPhaseResult scalar_result = solve_pair(shape_A, transform_A, shape_B, transform_B, margin);
+		SIMDBatch::set_level(SIMDBatch::get_supported_level());
+		const NarrowPhaseResult result = solve_pair(shape_A, transform_A, shape_B, transform_B, margin);
+
+		collision_count += scalar_result.collided;
+		mismatch_count += !(result == scalar_result);
+	}
+	SIMDBatch::set_level(default_level);
+
+	// Make sure the poses cover both outcomes.
+	CHECK(collision_count > 100);
+	CHECK(collision_count < 1900);
+	CHECK_MESSAGE(mismatch_count == 0, vformat("%d of 2000 pairs differ from the scalar path.", mismatch_count));
+
+	memdelete(box);
+	memdelete(capsule);
+	memdelete(small_hull);
+	memdelete(large_hull);
+}
+
+TEST_CASE("[PhysicsServer3D] Batched ray queries match single ray queries") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+
+	LocalVector<RID> rids;
+	LocalVector<RID> bodies;
+	GodotSpace3D *space = create_box_pile(server, 8, 2, rids, bodies);
+	REQUIRE(space);
+	PhysicsDirectSpaceState3D *direct_state = space->get_direct_state();
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(17);
+
+	// Enough rays to go through the worker threads, some of them missing the pile.
+	const int count = 1000;
+	LocalVector<Vector3> origins;
+	LocalVector<Vector3> motions;
+	for (int i = 0; i < count; i++) {
+		origins.push_back(Vector3(rng->randf_range(-6, 6), rng->randf_range(3, 5), rng->randf_range(-6, 6)));
+		motions.push_back(Vector3(rng->randf_range(-2, 2), -8, rng->randf_range(-2, 2)));
+	}
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	parameters.exclude.insert(rids[3]); // The floor.
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	LocalVector<bool> hits;
+	results.resize(count);
+	hits.resize(count);
+	direct_state->intersect_rays(parameters, origins.ptr(), motions.ptr(), count, results.ptr(), hits.ptr());
+
+	int hit_count = 0;
+	bool results_match = true;
+	for (int i = 0; i < count; i++) {
+		parameters.from = origins[i];
+		parameters.to = origins[i] + motions[i];
+		PhysicsDirectSpaceState3D::RayResult result;
+		const bool hit = direct_state->intersect_ray(parameters, result);
+		results_match = results_match && hit == hits[i];
+		if (hit && hits[i]) {
+			hit_count++;
+			results_match = results_match && result.position == results[i].position && result.normal == results[i].normal && result.rid == results[i].rid && result.shape == results[i].shape;
+		}
+	}
+	CHECK(hit_count > count / 4);
+	CHECK(hit_count < count);
+	CHECK(results_match);
+
+	free_box_pile(server, rids, bodies);
+	server->finish();
+	memdelete(server);
+}
+
+TEST_CASE("[PhysicsServer3D] Batched shape queries match single shape queries") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+
+	LocalVector<RID> rids;
+	LocalVector<RID> bodies;
+	GodotSpace3D *space = create_box_pile(server, 8, 2, rids, bodies);
+	REQUIRE(space);
+	PhysicsDirectSpaceState3D *direct_state = space->get_direct_state();
+	RID sphere_shape = server->sphere_shape_create();
+	server->shape_set_data(sphere_shape, 0.4);
+	rids.push_back(sphere_shape);
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(31);
+
+	// Enough queries to go through the worker threads, some of them missing the pile.
+	const int count = 200;
+	LocalVector<Transform3D> transforms;
+	LocalVector<Vector3> motions;
+	for (int i = 0; i < count; i++) {
+		transforms.push_back(Transform3D(Basis(), Vector3(rng->randf_range(-6, 6), rng->randf_range(0.5, 5), rng->randf_range(-6, 6))));
+		motions.push_back(Vector3(rng->randf_range(-2, 2), -6, rng->randf_range(-2, 2)));
+	}
+
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	parameters.shape_rid = sphere_shape;
+	parameters.exclude.insert(rids[3]); // The floor.
+
+	const int result_max = 8;
+	LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+	LocalVector<int> result_counts;
+	results.resize(count * result_max);
+	result_counts.resize(count);
+	direct_state->intersect_shapes(parameters, transforms.ptr(), count, results.ptr(), result_max, result_counts.ptr());
+
+	int hit_count = 0;
+	bool results_match = true;
+	for (int i = 0; i < count; i++) {
+		parameters.transform = transforms[i];
+		PhysicsDirectSpaceState3D::ShapeResult single_results[result_max];
+		const int single_count = direct_state->intersect_shape(parameters, single_results, result_max);
+		results_match = results_match && single_count == result_counts[i];
+		for (int j = 0; j < MIN(single_count, result_counts[i]); j++) {
+			const PhysicsDirectSpaceState3D::ShapeResult &result = results[i * result_max + j];
+			results_match = results_match && single_results[j].rid == result.rid && single_results[j].shape == result.shape;
+		}
+		hit_count += single_count > 0 ? 1 : 0;
+	}
+	CHECK(hit_count > 0);
+	CHECK(hit_count < count);
+	CHECK(results_match);
+
+	LocalVector<real_t> closest_safe;
+	LocalVector<real_t> closest_unsafe;
+	closest_safe.resize(count);
+	closest_unsafe.resize(count);
+	direct_state->cast_motions(parameters, transforms.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+	int blocked_count = 0;
+	bool motions_match = true;
+	for (int i = 0; i < count; i++) {
+		parameters.transform = transforms[i];
+		parameters.motion = motions[i];
+		real_t safe = 1.0;
+		real_t unsafe = 1.0;
+		direct_state->cast_motion(parameters, safe, unsafe);
+		motions_match = motions_match && safe == closest_safe[i] && unsafe == closest_unsafe[i];
+		blocked_count += safe < 1.0 ? 1 : 0;
+	}
+	CHECK(blocked_count > 0);
+	CHECK(blocked_count < count);
+	CHECK(motions_match);
+
+	free_box_pile(server, rids, bodies);
+	server->finish();
+	memdelete(server);
+}
+
+TEST_CASE("[PhysicsServer3D][Benchmark] Stacking pile step time versus thread count" * doctest::skip()) {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+
+	LocalVector<RID> rids;
+	LocalVector<RID> bodies;
+	GodotSpace3D *space = create_box_pile(server, 16, 8, rids, bodies);
+	REQUIRE(space);
+
+	const int steps = 120;
+	auto measure = [&](GodotStep3D &p_stepper) {
+		// Each run starts from the same pile.
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			const int side = 16;
+			const Vector3 position((int(i) % side) - side * 0.5, (int(i) / (side * side)) + 0.5, ((int(i) / side) % side) - side * 0.5);
+			server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+			server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3());
+			server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3());
+		}
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < steps; i++) {
+			p_stepper.step(space, 1.0 / 60.0);
+		}
+		return (OS::get_singleton()->get_ticks_usec() - begin) / steps;
+	};
+
+	GodotStep3D serial_stepper;
+	serial_stepper.set_parallel_island_solving(false);
+	MESSAGE("Serial: ", measure(serial_stepper), " usec per step, ", bodies.size(), " bodies.");
+
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	// Powers of two below the thread count, then the thread count itself.
+	LocalVector<int> task_counts;
+	for (int task_count = 1; task_count < thread_count; task_count *= 2) {
+		task_counts.push_back(task_count);
+	}
+	task_counts.push_back(MAX(thread_count, 1));
+	for (int task_count : task_counts) {
+		GodotStep3D parallel_stepper;
+		parallel_stepper.set_parallel_island_solving(true);
+		parallel_stepper.set_parallel_solver_task_count(task_count);
+		MESSAGE("Parallel with ", task_count, " threads: ", measure(parallel_stepper), " usec per step.");
+	}
+
+	free_box_pile(server, rids, bodies);
+	server->finish();
+	memdelete(server);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H